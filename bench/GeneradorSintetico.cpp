@@ -0,0 +1,101 @@
+#include "GeneradorSintetico.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+
+// CONSTRUCTOR acumulada normalizada a 1
+DistribucionZipf::DistribucionZipf(int n, double s) : acumulada(n) {
+    double suma = 0.0;
+    for (int k = 0; k < n; ++k) {
+        suma += 1.0 / std::pow(k + 1.0, s);
+        acumulada[k] = suma;
+    }
+    for (double& valor : acumulada) {
+        valor /= suma;
+    }
+}
+
+int DistribucionZipf::muestra(std::mt19937_64& rng) const {
+    double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+    size_t k = std::lower_bound(acumulada.begin(), acumulada.end(), u) - acumulada.begin();
+    return static_cast<int>(std::min(k, acumulada.size() - 1));
+}
+
+// CONSTRUCTOR vocabulario de palabras distintas de 3 a 10 letras
+GeneradorSintetico::GeneradorSintetico(int tamanioVocabulario, double sTerminos, uint64_t semilla)
+    : zipfTerminos(tamanioVocabulario, sTerminos), rng(semilla) {
+    std::unordered_set<std::string> usadas;
+    std::uniform_int_distribution<int> largo(3, 10);
+    std::uniform_int_distribution<int> letra(0, 25);
+    while (static_cast<int>(vocabulario.size()) < tamanioVocabulario) {
+        std::string nueva(largo(rng), 'a');
+        for (char& c : nueva) {
+            c = static_cast<char>('a' + letra(rng));
+        }
+        if (usadas.insert(nueva).second) {
+            vocabulario.push_back(nueva);
+        }
+    }
+}
+
+// 1 de cada 8 con mayuscula inicial y 1 de cada 8 con un signo al final
+void GeneradorSintetico::escribirPalabraCruda(int id, std::string& salida) {
+    size_t inicio = salida.size();
+    salida += vocabulario[id];
+    uint64_t azar = rng();
+    if ((azar & 7) == 0) {
+        salida[inicio] = static_cast<char>(salida[inicio] - 'a' + 'A');
+    }
+    if (((azar >> 3) & 7) == 0) {
+        salida += ",.;:!?)\""[(azar >> 6) & 7];
+    }
+}
+
+std::string GeneradorSintetico::palabraCruda() {
+    std::string salida;
+    escribirPalabraCruda(zipfTerminos.muestra(rng), salida);
+    return salida;
+}
+
+std::string GeneradorSintetico::documento(int numPalabras) {
+    std::string texto;
+    for (int i = 0; i < numPalabras; ++i) {
+        if (i > 0) {
+            texto += ' ';
+        }
+        escribirPalabraCruda(zipfTerminos.muestra(rng), texto);
+    }
+    return texto;
+}
+
+std::string GeneradorSintetico::lineaDocumento(int docId, int numPalabras) {
+    std::string id = std::to_string(docId);
+    return id + "||http://sintetico/" + id + "||" + documento(numPalabras);
+}
+
+// las consultas distintas se arman con terminos Zipf (los frecuentes aparecen mas en
+// consultas tambien) y el log elige entre ellas con otra Zipf
+std::vector<std::string> GeneradorSintetico::logConsultas(int numConsultas, int consultasDistintas, double sConsultas) {
+    std::vector<std::string> distintas;
+    std::uniform_int_distribution<int> numTerminos(1, 4);
+    for (int i = 0; i < consultasDistintas; ++i) {
+        std::string consulta;
+        int cuantos = numTerminos(rng);
+        for (int t = 0; t < cuantos; ++t) {
+            if (t > 0) {
+                consulta += ' ';
+            }
+            consulta += vocabulario[zipfTerminos.muestra(rng)];
+        }
+        distintas.push_back(consulta);
+    }
+
+    DistribucionZipf zipfConsultas(consultasDistintas, sConsultas);
+    std::vector<std::string> log;
+    log.reserve(numConsultas);
+    for (int i = 0; i < numConsultas; ++i) {
+        log.push_back(distintas[zipfConsultas.muestra(rng)]);
+    }
+    return log;
+}
@@ -0,0 +1,49 @@
+#ifndef GENERADOR_SINTETICO_H
+#define GENERADOR_SINTETICO_H
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+// muestras de una Zipf sobre 0..n-1: P(k) proporcional a 1 / (k + 1)^s.
+// la acumulada se calcula una vez y cada muestra es una busqueda binaria
+class DistribucionZipf {
+public:
+    DistribucionZipf(int n, double s);
+    int muestra(std::mt19937_64& rng) const;
+
+private:
+    std::vector<double> acumulada;
+};
+
+// corpus y log de consultas sinteticos para los benchmarks, sin los datos de gov2.
+// las palabras son letras al azar (la 0 es la mas frecuente), los documentos sacan
+// palabras con una Zipf y algunas llevan mayusculas y puntuacion para que limpiarlas
+// cueste algo. el log repite consultas con otra Zipf, como un log real.
+// todo sale de la semilla, asi dos corridas generan exactamente lo mismo
+class GeneradorSintetico {
+public:
+    GeneradorSintetico(int tamanioVocabulario, double sTerminos, uint64_t semilla);
+
+    const std::string& palabra(int id) const { return vocabulario[id]; }
+    int getTamanioVocabulario() const { return static_cast<int>(vocabulario.size()); }
+
+    // texto crudo de un documento de numPalabras palabras
+    std::string documento(int numPalabras);
+    // el documento como linea de gov2_pages.dat: "id||url||texto"
+    std::string lineaDocumento(int docId, int numPalabras);
+    // palabra cruda (puede tener mayusculas y puntuacion)
+    std::string palabraCruda();
+    // numConsultas lineas sacadas de consultasDistintas consultas de 1 a 4 terminos
+    std::vector<std::string> logConsultas(int numConsultas, int consultasDistintas, double sConsultas);
+
+private:
+    std::vector<std::string> vocabulario;
+    DistribucionZipf zipfTerminos;
+    std::mt19937_64 rng;
+
+    void escribirPalabraCruda(int id, std::string& salida);
+};
+
+#endif
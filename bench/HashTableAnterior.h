@@ -0,0 +1,44 @@
+#ifndef HASH_TABLE_ANTERIOR_H
+#define HASH_TABLE_ANTERIOR_H
+
+// la HashTable de antes de los bytes de control (sondeo lineal, djb2 y borrados marcados),
+// se deja en el bench solo para comparar contra la actual
+
+#include <string>
+#include <vector>
+
+template<typename K, typename V>
+struct HashEntryAnterior {
+    K key;
+    V value;
+    bool ocupado;
+    bool borrado;
+
+    HashEntryAnterior();
+    HashEntryAnterior(const K& k, const V& v);
+};
+
+template<typename K, typename V>
+class HashTableAnterior {
+private:
+    std::vector<HashEntryAnterior<K, V>> table;
+    int tableSize;
+    int actualSize;
+
+    int hash(const std::string& key) const;
+    void rehash();
+
+public:
+    HashTableAnterior(int size = 53);
+
+    void insert(const K& key, const V& value);
+    V* search(const K& key);
+    bool remove(const K& key);
+
+    int size() const;
+    bool empty() const;
+};
+
+#include "HashTableAnterior.tpp"
+
+#endif
\ No newline at end of file
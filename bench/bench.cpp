@@ -0,0 +1,780 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#include "Buscador.h"
+#include "BuscadorConCache.h"
+#include "ConstructorGrafo.h"
+#include "DiccionarioTerminos.h"
+#include "GeneradorSintetico.h"
+#include "Grafo.h"
+#include "HashTable.h"
+#include "HashTableAnterior.h"
+#include "IndiceParticionado.h"
+#include "Interseccion.h"
+#include "InvertedIndex.h"
+#include "LRUCache.h"
+#include "PoliticasCache.h"
+#include "ProcesadorDocumentos.h"
+#include "RankingBM25.h"
+#include "Utils.h"
+
+// benchmarks del motor sobre un corpus sintetico (ver GeneradorSintetico.h). cada medicion
+// se repite BENCH_REPETICIONES veces y se informa la mediana, el minimo y el maximo en
+// nanosegundos por operacion. el resultado sale en JSON por stdout, el progreso por stderr.
+// uso: search_engine_bench [--docs N] [--consultas N] [--semilla N] [--repeticiones N]
+
+#define BENCH_DOCUMENTOS 20'000
+#define BENCH_PALABRAS_DOC 200
+#define BENCH_VOCABULARIO 50'000
+#define BENCH_ZIPF_TERMINOS 1.0
+#define BENCH_CONSULTAS 20'000
+#define BENCH_CONSULTAS_DISTINTAS 5'000
+#define BENCH_ZIPF_CONSULTAS 0.9
+#define BENCH_SEMILLA 42
+#define BENCH_REPETICIONES 5
+#define BENCH_PALABRAS_CLEANWORD 1'000'000
+#define BENCH_CLAVES_HASH 1'000'000
+#define BENCH_SLOTS_HASH (1 << 17) // slots de las tablas de la comparacion a carga fija
+#define BENCH_OPERACIONES_FUZZ 2'000'000
+#define BENCH_TERMINOS_DICCIONARIO 1'000'000 // terminos al azar de 3 a 22 caracteres
+#define BENCH_CAPACIDAD_CACHE 1'000
+#define BENCH_TERMINOS_LARGOS 8 // las palabras mas frecuentes que se combinan en consultas de listas largas
+
+struct ResultadoBench {
+    std::string nombre;
+    long long operaciones;
+    std::vector<double> nsPorOperacion; // uno por repeticion
+    std::vector<std::pair<std::string, double>> extras;
+};
+
+// evita que el compilador descarte el trabajo medido
+static volatile long long sumidero = 0;
+
+template<typename F>
+static double cronometrar(F&& cuerpo) {
+    auto inicio = std::chrono::steady_clock::now();
+    cuerpo();
+    auto fin = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(fin - inicio).count();
+}
+
+// bytes pedidos a malloc que siguen en uso, para comparar la memoria de dos estructuras.
+// -1 donde no se puede saber (fuera de glibc)
+static long long bytesEnUso() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    return static_cast<long long>(info.uordblks + info.hblkhd);
+#else
+    return -1;
+#endif
+}
+
+// las tres tablas de la comparacion de HashTable con la misma interfaz. cada una se crea
+// para n claves con la carga pedida sin pasar por rehashes
+struct TablaNueva {
+    HashTable<std::string, int> tabla;
+    TablaNueva(int, double) : tabla(BENCH_SLOTS_HASH * 7 / 8 - 1) {}
+    void insertar(const std::string& clave, int valor) { tabla.insert(clave, valor); }
+    int* buscar(const std::string& clave) { return tabla.search(clave); }
+    void borrar(const std::string& clave) { tabla.remove(clave); }
+};
+
+// la anterior hace rehash al 70%: arranca con el tamanio justo para no llegar (o quedar al 69%)
+struct TablaAnterior {
+    HashTableAnterior<std::string, int> tabla;
+    TablaAnterior(int n, double carga) : tabla(static_cast<int>(n / std::min(carga, 0.69)) + 1) {}
+    void insertar(const std::string& clave, int valor) { tabla.insert(clave, valor); }
+    int* buscar(const std::string& clave) { return tabla.search(clave); }
+    void borrar(const std::string& clave) { tabla.remove(clave); }
+};
+
+struct TablaUnorderedMap {
+    std::unordered_map<std::string, int> tabla;
+    TablaUnorderedMap(int n, double carga) {
+        tabla.max_load_factor(1.0f);
+        tabla.rehash(static_cast<size_t>(n / carga));
+    }
+    void insertar(const std::string& clave, int valor) { tabla[clave] = valor; }
+    int* buscar(const std::string& clave) {
+        auto it = tabla.find(clave);
+        return it == tabla.end() ? nullptr : &it->second;
+    }
+    void borrar(const std::string& clave) { tabla.erase(clave); }
+};
+
+// corre medicion (que devuelve los ns de una pasada, sin contar su preparacion) varias veces
+template<typename F>
+static ResultadoBench medir(const std::string& nombre, long long operaciones, int repeticiones, F&& medicion) {
+    std::cerr << "[BENCH] " << nombre << "..." << std::endl;
+    ResultadoBench resultado;
+    resultado.nombre = nombre;
+    resultado.operaciones = operaciones;
+    for (int r = 0; r < repeticiones; ++r) {
+        resultado.nsPorOperacion.push_back(medicion() / std::max(operaciones, 1LL));
+    }
+    return resultado;
+}
+
+static void escribirJSON(const std::vector<ResultadoBench>& resultados, const std::vector<std::pair<std::string, long long>>& config) {
+    std::cout << "{\n  \"config\": {";
+    for (size_t i = 0; i < config.size(); ++i) {
+        std::cout << (i > 0 ? ", " : "") << "\"" << config[i].first << "\": " << config[i].second;
+    }
+    std::cout << "},\n  \"benchmarks\": [\n";
+    for (size_t i = 0; i < resultados.size(); ++i) {
+        const ResultadoBench& r = resultados[i];
+        std::vector<double> ordenados = r.nsPorOperacion;
+        std::sort(ordenados.begin(), ordenados.end());
+        std::cout << "    {\"nombre\": \"" << r.nombre << "\", \"operaciones\": " << r.operaciones
+                  << ", \"ns_por_op_mediana\": " << ordenados[ordenados.size() / 2]
+                  << ", \"ns_por_op_min\": " << ordenados.front()
+                  << ", \"ns_por_op_max\": " << ordenados.back();
+        for (const auto& extra : r.extras) {
+            std::cout << ", \"" << extra.first << "\": " << extra.second;
+        }
+        std::cout << "}" << (i + 1 < resultados.size() ? "," : "") << "\n";
+    }
+    std::cout << "  ]\n}" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    long long numDocs = BENCH_DOCUMENTOS;
+    long long numConsultas = BENCH_CONSULTAS;
+    long long semilla = BENCH_SEMILLA;
+    long long repeticiones = BENCH_REPETICIONES;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        long long valor = std::atoll(argv[i + 1]);
+        if (std::strcmp(argv[i], "--docs") == 0) {
+            numDocs = valor;
+        } else if (std::strcmp(argv[i], "--consultas") == 0) {
+            numConsultas = valor;
+        } else if (std::strcmp(argv[i], "--semilla") == 0) {
+            semilla = valor;
+        } else if (std::strcmp(argv[i], "--repeticiones") == 0) {
+            repeticiones = std::max(1LL, valor);
+        }
+    }
+    const int reps = static_cast<int>(repeticiones);
+
+    // 1) DATOS SINTETICOS
+    std::cerr << "[BENCH] Generando corpus de " << numDocs << " documentos y " << numConsultas << " consultas..." << std::endl;
+    GeneradorSintetico generador(BENCH_VOCABULARIO, BENCH_ZIPF_TERMINOS, static_cast<uint64_t>(semilla));
+    std::vector<std::string> documentos;
+    documentos.reserve(numDocs);
+    for (long long d = 0; d < numDocs; ++d) {
+        documentos.push_back(generador.lineaDocumento(static_cast<int>(d), BENCH_PALABRAS_DOC));
+    }
+    std::vector<std::string> consultas = generador.logConsultas(static_cast<int>(numConsultas), BENCH_CONSULTAS_DISTINTAS, BENCH_ZIPF_CONSULTAS);
+    std::vector<std::string> palabrasCrudas;
+    palabrasCrudas.reserve(BENCH_PALABRAS_CLEANWORD);
+    for (int i = 0; i < BENCH_PALABRAS_CLEANWORD; ++i) {
+        palabrasCrudas.push_back(generador.palabraCruda());
+    }
+
+    std::vector<ResultadoBench> resultados;
+    // stdout es solo para el JSON: el motor escribe por consola (buscador, pagerank, ...), se
+    // silencia en todas las llamadas y se devuelve recien para escribirJSON
+    std::streambuf* salida = std::cout.rdbuf(nullptr);
+
+    // 2) Utils::cleanWord
+    resultados.push_back(medir("utils_cleanWord", BENCH_PALABRAS_CLEANWORD, reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& palabra : palabrasCrudas) {
+                total += static_cast<long long>(Utils::cleanWord(palabra).size());
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+
+    // 3) InvertedIndex::addDocumento: las frecuencias por documento se cuentan antes, solo
+    // se miden las llamadas al indice (como en el modo bulk)
+    struct Posteo {
+        std::string termino;
+        int docId;
+        int frecuencia;
+    };
+    std::vector<Posteo> posteos;
+    {
+        std::unordered_map<std::string, int> frecuencias;
+        std::string palabra;
+        for (size_t d = 0; d < documentos.size(); ++d) {
+            frecuencias.clear();
+            Utils::Tokenizador tokenizador(std::string_view(documentos[d]).substr(documentos[d].rfind("||") + 2));
+            while (tokenizador.siguiente(palabra)) {
+                frecuencias[palabra]++;
+            }
+            for (const auto& termino : frecuencias) {
+                posteos.push_back(Posteo{termino.first, static_cast<int>(d), termino.second});
+            }
+        }
+    }
+    resultados.push_back(medir("indice_addDocumento", static_cast<long long>(posteos.size()), reps, [&]() {
+        std::unique_ptr<InvertedIndex> indice(new InvertedIndex());
+        return cronometrar([&]() {
+            for (const Posteo& p : posteos) {
+                indice->addDocumento(p.termino, p.docId, p.frecuencia);
+            }
+        });
+    }));
+
+    // 4) ingesta completa (tokenizar, contar y agregar) con el procesador en modo bulk
+    ProcesadorDocumentos pd;
+    pd.setLimitePalabras(0);
+    resultados.push_back(medir("ingesta_documentos", numDocs, reps, [&]() {
+        std::unique_ptr<InvertedIndex> indice(new InvertedIndex());
+        return cronometrar([&]() {
+            for (size_t d = 0; d < documentos.size(); ++d) {
+                pd.procesarContenidoDocumentosBulk(documentos[d], static_cast<int>(d), *indice);
+            }
+        });
+    }));
+    resultados.back().extras.push_back(std::make_pair("palabras_por_doc", static_cast<double>(BENCH_PALABRAS_DOC)));
+
+    InvertedIndex ii;
+    for (size_t d = 0; d < documentos.size(); ++d) {
+        int palabras = pd.procesarContenidoDocumentosBulk(documentos[d], static_cast<int>(d), ii);
+        ii.setLongitudDocumento(static_cast<int>(d), palabras); // BM25 y los cortes de los shards
+    }
+
+    // 5) interseccion de pares de terminos del log: la de LinkedList contra ListaPosteo y
+    // la del motor de interseccion
+    std::vector<std::pair<std::string, std::string>> pares;
+    for (const std::string& consulta : consultas) {
+        std::vector<std::string> terminos = pd.getCleanWords(consulta);
+        if (terminos.size() >= 2 && ii.search(terminos[0]) != nullptr && ii.search(terminos[1]) != nullptr) {
+            pares.push_back(std::make_pair(terminos[0], terminos[1]));
+        }
+    }
+    std::vector<LinkedList<int>*> primeras;
+    for (const auto& par : pares) {
+        primeras.push_back(ii.search(std::vector<std::string>{par.first}));
+    }
+    resultados.push_back(medir("interseccion_listaPosteo", static_cast<long long>(pares.size()), reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (size_t i = 0; i < pares.size(); ++i) {
+                LinkedList<int>* interseccion = ii.interseccionListaPosteo(primeras[i], ii.search(pares[i].second));
+                total += interseccion->getSize();
+                delete interseccion;
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    resultados.push_back(medir("interseccion_motor", static_cast<long long>(pares.size()), reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const auto& par : pares) {
+                total += static_cast<long long>(Interseccion::intersectar({ii.search(par.first), ii.search(par.second)}).size());
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    for (LinkedList<int>* lista : primeras) {
+        delete lista;
+    }
+
+    // 6) HashTable: insertar desde el tamanio por defecto (con rehashes) y buscar
+    // claves que estan y que no, en orden mezclado
+    std::vector<std::string> claves;
+    std::vector<std::string> ausentes;
+    for (int i = 0; i < BENCH_CLAVES_HASH; ++i) {
+        claves.push_back("clave" + std::to_string(i * 2));
+        ausentes.push_back("clave" + std::to_string(i * 2 + 1));
+    }
+    std::vector<std::string> mezcladas = claves;
+    std::shuffle(mezcladas.begin(), mezcladas.end(), std::mt19937_64(static_cast<uint64_t>(semilla)));
+    resultados.push_back(medir("hashtable_insert", BENCH_CLAVES_HASH, reps, [&]() {
+        std::unique_ptr<HashTable<std::string, int>> tabla(new HashTable<std::string, int>());
+        return cronometrar([&]() {
+            for (int i = 0; i < BENCH_CLAVES_HASH; ++i) {
+                tabla->insert(claves[i], i);
+            }
+        });
+    }));
+    HashTable<std::string, int> tabla;
+    for (int i = 0; i < BENCH_CLAVES_HASH; ++i) {
+        tabla.insert(claves[i], i);
+    }
+    resultados.push_back(medir("hashtable_search_hit", BENCH_CLAVES_HASH, reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& clave : mezcladas) {
+                total += *tabla.search(clave);
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    resultados.push_back(medir("hashtable_search_miss", BENCH_CLAVES_HASH, reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& clave : ausentes) {
+                total += tabla.search(clave) != nullptr;
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+
+    // 6b) la HashTable contra la anterior y std::unordered_map con la misma cantidad de slots y
+    // varias cargas (claves como las de la cache). insert en una tabla nueva, hits en orden
+    // mezclado, misses, y churn: remove + insert de una clave y despues los misses otra vez.
+    // la anterior hace rehash al 70%: en 0.7 se mide al 69% y a 0.85 no llega
+    std::vector<std::string> clavesCarga;
+    std::vector<std::string> ausentesCarga;
+    std::mt19937_64 rngHash(static_cast<uint64_t>(semilla));
+    for (int i = 0; i < BENCH_SLOTS_HASH; ++i) {
+        clavesCarga.push_back("w" + std::to_string(rngHash() % 20000) + " w" + std::to_string(rngHash() % 20000) + " " + std::to_string(i));
+        ausentesCarga.push_back("x" + std::to_string(rngHash()) + " w" + std::to_string(i));
+    }
+    std::vector<int> ordenCarga(BENCH_SLOTS_HASH);
+    for (int i = 0; i < BENCH_SLOTS_HASH; ++i) {
+        ordenCarga[i] = i;
+    }
+    std::shuffle(ordenCarga.begin(), ordenCarga.end(), rngHash);
+    auto medirCarga = [&](auto crear, const std::string& nombre, int n) {
+        using Tabla = typename decltype(crear())::element_type;
+        resultados.push_back(medir(nombre + "_insert", n, reps, [&]() {
+            std::unique_ptr<Tabla> tabla = crear();
+            return cronometrar([&]() {
+                for (int i = 0; i < n; ++i) {
+                    tabla->insertar(clavesCarga[i], i);
+                }
+            });
+        }));
+        std::unique_ptr<Tabla> tabla = crear();
+        for (int i = 0; i < n; ++i) {
+            tabla->insertar(clavesCarga[i], i);
+        }
+        resultados.push_back(medir(nombre + "_hit", BENCH_SLOTS_HASH, reps, [&]() {
+            return cronometrar([&]() {
+                long long total = 0;
+                for (int i = 0; i < BENCH_SLOTS_HASH; ++i) {
+                    total += *tabla->buscar(clavesCarga[ordenCarga[i] % n]);
+                }
+                sumidero = sumidero + total;
+            });
+        }));
+        resultados.push_back(medir(nombre + "_miss", BENCH_SLOTS_HASH, reps, [&]() {
+            return cronometrar([&]() {
+                long long total = 0;
+                for (int i = 0; i < BENCH_SLOTS_HASH; ++i) {
+                    total += tabla->buscar(ausentesCarga[i]) != nullptr;
+                }
+                sumidero = sumidero + total;
+            });
+        }));
+        resultados.push_back(medir(nombre + "_churn", BENCH_SLOTS_HASH, reps, [&]() {
+            return cronometrar([&]() {
+                long long total = 0;
+                for (int i = 0; i < BENCH_SLOTS_HASH; ++i) {
+                    const std::string& clave = clavesCarga[ordenCarga[i] % n];
+                    tabla->borrar(clave);
+                    tabla->insertar(clave, i);
+                }
+                for (int i = 0; i < BENCH_SLOTS_HASH; ++i) {
+                    total += tabla->buscar(ausentesCarga[i]) != nullptr;
+                }
+                sumidero = sumidero + total;
+            });
+        }));
+    };
+    const double cargasHash[] = {0.25, 0.5, 0.7, 0.85};
+    for (double carga : cargasHash) {
+        int n = static_cast<int>(BENCH_SLOTS_HASH * carga);
+        std::string sufijo = "_carga_" + std::to_string(static_cast<int>(carga * 100));
+        medirCarga([&]() { return std::unique_ptr<TablaNueva>(new TablaNueva(n, carga)); }, "hashtable" + sufijo, n);
+        if (carga < 0.8) {
+            medirCarga([&]() { return std::unique_ptr<TablaAnterior>(new TablaAnterior(n, carga)); }, "hashtable_anterior" + sufijo, n);
+        }
+        medirCarga([&]() { return std::unique_ptr<TablaUnorderedMap>(new TablaUnorderedMap(n, carga)); }, "unordered_map" + sufijo, n);
+    }
+
+    // 6c) fuzz de la HashTable contra std::unordered_map: insert, remove y search al azar con
+    // claves string (primero pocas, muchas repetidas, despues muchas) y enteras
+    long long diferenciasHash = 0;
+    resultados.push_back(medir("hashtable_fuzz", 2LL * BENCH_OPERACIONES_FUZZ, reps, [&]() {
+        std::mt19937_64 rng(static_cast<uint64_t>(semilla));
+        diferenciasHash = 0;
+        return cronometrar([&]() {
+            HashTable<std::string, int> tabla(5);
+            std::unordered_map<std::string, int> esperado;
+            for (int i = 0; i < BENCH_OPERACIONES_FUZZ; ++i) {
+                std::string clave = "k" + std::to_string(rng() % (i < BENCH_OPERACIONES_FUZZ / 2 ? 5000 : 200000));
+                int operacion = static_cast<int>(rng() % 4);
+                if (operacion == 0) {
+                    tabla.insert(clave, i);
+                    esperado[clave] = i;
+                } else if (operacion == 1) {
+                    diferenciasHash += tabla.remove(std::string_view(clave)) != (esperado.erase(clave) > 0);
+                } else {
+                    int* valor = tabla.search(std::string_view(clave));
+                    auto it = esperado.find(clave);
+                    diferenciasHash += (valor == nullptr) != (it == esperado.end()) || (valor != nullptr && *valor != it->second);
+                }
+                diferenciasHash += tabla.size() != static_cast<int>(esperado.size());
+            }
+            HashTable<int, long long> enteros;
+            std::unordered_map<int, long long> esperadoEnteros;
+            for (int i = 0; i < BENCH_OPERACIONES_FUZZ; ++i) {
+                int clave = static_cast<int>(rng() % 30000);
+                int operacion = static_cast<int>(rng() % 3);
+                if (operacion == 0) {
+                    enteros.insert(clave, i);
+                    esperadoEnteros[clave] = i;
+                } else if (operacion == 1) {
+                    diferenciasHash += enteros.remove(clave) != (esperadoEnteros.erase(clave) > 0);
+                } else {
+                    long long* valor = enteros.search(clave);
+                    auto it = esperadoEnteros.find(clave);
+                    diferenciasHash += (valor == nullptr) != (it == esperadoEnteros.end()) || (valor != nullptr && *valor != it->second);
+                }
+            }
+        });
+    }));
+    if (diferenciasHash != 0) {
+        std::cerr << "[BENCH] ERROR: la HashTable no coincide con std::unordered_map en el fuzz" << std::endl;
+    }
+    resultados.back().extras.push_back(std::make_pair("diferencias", static_cast<double>(diferenciasHash)));
+
+    // 6d) vocabulario: DiccionarioTerminos (mas el vector por id de InvertedIndex) contra el
+    // std::map<std::string, puntero> que habia antes, buscando todos los terminos en orden
+    // mezclado. la memoria es lo que cada uno deja pedido a malloc
+    std::vector<std::string> terminos;
+    const char alfabeto[] = "abcdefghijklmnopqrstuvwxyz0123456789";
+    for (int i = 0; i < BENCH_TERMINOS_DICCIONARIO; ++i) {
+        int largo = 3 + static_cast<int>(rngHash() % 10) + (rngHash() % 20 == 0 ? 10 : 0);
+        std::string termino;
+        for (int j = 0; j < largo; ++j) {
+            termino += alfabeto[rngHash() % 36];
+        }
+        terminos.push_back(termino);
+    }
+    std::vector<std::string> terminosMezclados = terminos;
+    std::shuffle(terminosMezclados.begin(), terminosMezclados.end(), rngHash);
+    long long antesMapa = bytesEnUso();
+    std::unique_ptr<std::map<std::string, void*>> mapaTerminos(new std::map<std::string, void*>());
+    for (const std::string& termino : terminos) {
+        mapaTerminos->emplace(termino, nullptr);
+    }
+    long long antesDiccionario = bytesEnUso();
+    std::unique_ptr<DiccionarioTerminos> diccionario(new DiccionarioTerminos());
+    std::vector<void*> entradasPorId;
+    for (const std::string& termino : terminos) {
+        if (diccionario->agregar(termino) == entradasPorId.size()) {
+            entradasPorId.push_back(nullptr);
+        }
+    }
+    long long despuesDiccionario = bytesEnUso();
+    resultados.push_back(medir("vocabulario_std_map_buscar", BENCH_TERMINOS_DICCIONARIO, reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& termino : terminosMezclados) {
+                total += mapaTerminos->find(termino) != mapaTerminos->end();
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    if (antesMapa >= 0) {
+        resultados.back().extras.push_back(std::make_pair("megabytes", (antesDiccionario - antesMapa) / 1048576.0));
+    }
+    resultados.push_back(medir("vocabulario_diccionario_buscar", BENCH_TERMINOS_DICCIONARIO, reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& termino : terminosMezclados) {
+                total += diccionario->buscar(termino) != DiccionarioTerminos::NO_ENCONTRADO;
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    if (antesMapa >= 0) {
+        resultados.back().extras.push_back(std::make_pair("megabytes", (despuesDiccionario - antesDiccionario) / 1048576.0));
+    }
+    resultados.back().extras.push_back(std::make_pair("terminos_distintos", static_cast<double>(diccionario->size())));
+    mapaTerminos.reset();
+    diccionario.reset();
+    std::vector<void*>().swap(entradasPorId);
+    std::vector<std::string>().swap(terminos);
+    std::vector<std::string>().swap(terminosMezclados);
+
+    // 7) LRUCache get/put con las claves del log (como BuscadorConCache), con cada politica
+    std::vector<std::string> clavesCache;
+    for (const std::string& consulta : consultas) {
+        std::vector<std::string> terminos = pd.getCleanWords(consulta);
+        if (!terminos.empty()) {
+            clavesCache.push_back(BuscadorConCache::crearLlaveCache(terminos));
+        }
+    }
+    ResultadoCache vacio = std::make_shared<const ResultadoComprimido>();
+    const int politicas[] = {POLITICA_LRU, POLITICA_SLRU, POLITICA_ARC, POLITICA_TINYLFU};
+    const char* nombresPoliticas[] = {"lru", "slru", "arc", "tinylfu"};
+    for (int p = 0; p < 4; ++p) {
+        double tasaAciertos = 0.0;
+        resultados.push_back(medir(std::string("lrucache_get_put_") + nombresPoliticas[p], static_cast<long long>(clavesCache.size()), reps, [&]() {
+            std::unique_ptr<LRUCache> cache(new LRUCache(BENCH_CAPACIDAD_CACHE, politicas[p]));
+            double ns = cronometrar([&]() {
+                for (const std::string& clave : clavesCache) {
+                    if (!cache->get(clave)) {
+                        cache->put(clave, vacio);
+                    }
+                }
+            });
+            tasaAciertos = cache->getHitRate();
+            return ns;
+        }));
+        resultados.back().extras.push_back(std::make_pair("tasa_aciertos", tasaAciertos));
+    }
+
+    // 8) Buscador::query y BuscadorConCache::queryConCache sobre el log (macro)
+    Buscador buscador(&ii, &pd);
+    resultados.push_back(medir("buscador_query", static_cast<long long>(consultas.size()), reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& consulta : consultas) {
+                LinkedList<int>* resultado = buscador.query(consulta);
+                total += resultado->getSize();
+                delete resultado;
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    double aciertosBuscador = 0.0;
+    resultados.push_back(medir("buscador_queryConCache", static_cast<long long>(consultas.size()), reps, [&]() {
+        std::unique_ptr<BuscadorConCache> conCache(new BuscadorConCache(&ii, &pd, BENCH_CAPACIDAD_CACHE));
+        double ns = cronometrar([&]() {
+            long long total = 0;
+            for (const std::string& consulta : consultas) {
+                total += static_cast<long long>(conCache->queryConCache(consulta)->size());
+            }
+            sumidero = sumidero + total;
+        });
+        aciertosBuscador = conCache->getCache().getHitRate();
+        return ns;
+    }));
+    resultados.back().extras.push_back(std::make_pair("tasa_aciertos", aciertosBuscador));
+
+    // 9) grafo de co-relevancia del log (top 10 de cada consulta, como main): uno por uno
+    // con addVertice y con ConstructorGrafo (buffers por hilo + radix sort)
+    auto construirSerial = [&](Grafo& grafo) {
+        for (const std::string& consulta : consultas) {
+            LinkedList<int>* resultado = buscador.querySinPR(consulta);
+            std::vector<int> top;
+            for (Node<int>* nodo = resultado->getHead(); nodo != nullptr && top.size() < 10; nodo = nodo->next) {
+                top.push_back(nodo->data);
+            }
+            delete resultado;
+            for (size_t i = 0; i < top.size(); ++i) {
+                for (size_t j = i + 1; j < top.size(); ++j) {
+                    grafo.addVertice(top[i], top[j]);
+                }
+            }
+        }
+    };
+    resultados.push_back(medir("grafo_construccion_addVertice", static_cast<long long>(consultas.size()), reps, [&]() {
+        std::unique_ptr<Grafo> grafo(new Grafo());
+        return cronometrar([&]() { construirSerial(*grafo); });
+    }));
+    const int hilosGrafo[] = {1, 0};
+    for (int hilos : hilosGrafo) {
+        ConstructorGrafo constructor(&ii, &pd, 10, hilos);
+        resultados.push_back(medir(hilos == 1 ? "grafo_construccion_radix_1_hilo" : "grafo_construccion_radix", static_cast<long long>(consultas.size()), reps, [&]() {
+            std::unique_ptr<Grafo> grafo(new Grafo());
+            return cronometrar([&]() { constructor.construir(consultas, *grafo); });
+        }));
+        resultados.back().extras.push_back(std::make_pair("aristas_anotadas", static_cast<double>(constructor.getAristasEmitidas())));
+    }
+
+    // 10) PageRank sobre ese grafo, con un hilo para que sea repetible
+    Grafo grafo;
+    ConstructorGrafo(&ii, &pd, 10).construir(consultas, grafo);
+    resultados.push_back(medir("grafo_calcularPageRank", 1, reps, [&]() {
+        return cronometrar([&]() {
+            sumidero = sumidero + static_cast<long long>(grafo.calcularPageRank(50, 0.85, 1e-6, CONVERGENCIA_MAXIMA, 1).size());
+        });
+    }));
+    resultados.back().extras.push_back(std::make_pair("nodos", static_cast<double>(grafo.getNumNodes())));
+    resultados.back().extras.push_back(std::make_pair("aristas", static_cast<double>(grafo.getNumAristas())));
+
+    // guardar y cargar ese grafo: se mide la vuelta completa y se compara nodo por nodo con el
+    // original. ademas una copia cortada del archivo tiene que rechazarse sin tocar el grafo
+    const std::string archivoGrafo = (std::filesystem::temp_directory_path() / "search_engine_bench_grafo.bin").string();
+    std::unique_ptr<Grafo> cargado;
+    bool guardado = true;
+    resultados.push_back(medir("grafo_guardar_cargar", 1, reps, [&]() {
+        cargado.reset(new Grafo());
+        return cronometrar([&]() {
+            guardado = grafo.guardar(archivoGrafo) && cargado->cargar(archivoGrafo) && guardado;
+        });
+    }));
+    bool identicoGrafo = guardado && cargado->getNumNodes() == grafo.getNumNodes()
+                      && cargado->getNumAristas() == grafo.getNumAristas()
+                      && cargado->getNumAristasDistintas() == grafo.getNumAristasDistintas();
+    for (int i = 0; identicoGrafo && i < grafo.getNumNodes(); ++i) {
+        uint32_t indice = static_cast<uint32_t>(i);
+        const std::vector<VecinoGrafo>& original = grafo.getVecinos(indice);
+        const std::vector<VecinoGrafo>& leido = cargado->getVecinos(indice);
+        identicoGrafo = cargado->getDocId(indice) == grafo.getDocId(indice) && cargado->getIndice(grafo.getDocId(indice)) == i
+                     && leido.size() == original.size();
+        for (size_t j = 0; identicoGrafo && j < leido.size(); ++j) {
+            identicoGrafo = leido[j].indice == original[j].indice && leido[j].peso == original[j].peso;
+        }
+    }
+    std::filesystem::resize_file(archivoGrafo, std::filesystem::file_size(archivoGrafo) - sizeof(VecinoGrafo));
+    bool rechazaCortado = !cargado->cargar(archivoGrafo) && cargado->getNumNodes() == grafo.getNumNodes();
+    std::filesystem::remove(archivoGrafo);
+    if (!identicoGrafo || !rechazaCortado) {
+        std::cerr << "[BENCH] ERROR: el grafo guardado y cargado no es el original" << std::endl;
+    }
+    resultados.back().extras.push_back(std::make_pair("identico", identicoGrafo ? 1.0 : 0.0));
+    resultados.back().extras.push_back(std::make_pair("rechaza_cortado", rechazaCortado ? 1.0 : 0.0));
+
+    // 11) consultas de listas largas (pares y trios de las palabras mas frecuentes) con el
+    // indice repartido en shards: AND + pagerank y top 10 BM25 + pagerank (OR). primero se
+    // verifica que den lo mismo que el indice completo
+    std::map<int, double> pageRank = grafo.calcularPageRank(50, 0.85, 1e-6, CONVERGENCIA_MAXIMA, 1);
+    std::vector<std::vector<std::string>> largas;
+    for (int i = 0; i < BENCH_TERMINOS_LARGOS; ++i) {
+        for (int j = i + 1; j < BENCH_TERMINOS_LARGOS; ++j) {
+            largas.push_back({generador.palabra(i), generador.palabra(j)});
+            if (j + 1 < BENCH_TERMINOS_LARGOS) {
+                largas.push_back({generador.palabra(i), generador.palabra(j), generador.palabra(j + 1)});
+            }
+        }
+    }
+    RankingBM25 rankingCompleto(&ii);
+    rankingCompleto.setPageRank(&pageRank, PESO_PAGERANK_BM25);
+    std::vector<std::vector<int>> esperadosAnd;
+    std::vector<std::vector<ResultadoRankeado>> esperadosTopK;
+    for (const std::vector<std::string>& terminos : largas) {
+        std::vector<const ListaPosteo*> listas;
+        for (const std::string& termino : terminos) {
+            listas.push_back(ii.search(termino));
+        }
+        std::vector<std::pair<int, double>> rankeados = Buscador::rankearPorPageRank(Interseccion::intersectar(listas), pageRank);
+        std::vector<int> docs;
+        for (const auto& doc_pair : rankeados) {
+            docs.push_back(doc_pair.first);
+        }
+        esperadosAnd.push_back(docs);
+        esperadosTopK.push_back(rankingCompleto.topK(terminos, 10));
+    }
+    const int numShardsBench[] = {1, 2, 4, 8};
+    for (int numShards : numShardsBench) {
+        IndiceParticionado particionado(numShards);
+        particionado.setPageRankScores(&pageRank);
+        particionado.construir(ii);
+        bool identico = true;
+        for (size_t i = 0; i < largas.size(); ++i) {
+            std::vector<ResultadoRankeado> topK = particionado.topK(largas[i], 10);
+            identico = identico && particionado.buscar(largas[i]) == esperadosAnd[i] && topK.size() == esperadosTopK[i].size();
+            for (size_t r = 0; identico && r < topK.size(); ++r) {
+                identico = topK[r].docId == esperadosTopK[i][r].docId && topK[r].score == esperadosTopK[i][r].score;
+            }
+        }
+        if (!identico) {
+            std::cerr << "[BENCH] ERROR: con " << numShards << " shards el resultado no es el del indice completo" << std::endl;
+        }
+
+        std::string sufijo = "_" + std::to_string(numShards) + "_shards";
+        resultados.push_back(medir("shards_and_pagerank" + sufijo, static_cast<long long>(largas.size()), reps, [&]() {
+            return cronometrar([&]() {
+                long long total = 0;
+                for (const std::vector<std::string>& terminos : largas) {
+                    total += static_cast<long long>(particionado.buscar(terminos).size());
+                }
+                sumidero = sumidero + total;
+            });
+        }));
+        resultados.back().extras.push_back(std::make_pair("identico", identico ? 1.0 : 0.0));
+        resultados.push_back(medir("shards_top10_bm25" + sufijo, static_cast<long long>(largas.size()), reps, [&]() {
+            return cronometrar([&]() {
+                long long total = 0;
+                for (const std::vector<std::string>& terminos : largas) {
+                    total += static_cast<long long>(particionado.topK(terminos, 10).size());
+                }
+                sumidero = sumidero + total;
+            });
+        }));
+        resultados.back().extras.push_back(std::make_pair("identico", identico ? 1.0 : 0.0));
+    }
+
+    // 12) indexacion incremental: la segunda mitad de los docs se agrega a un indice hecho con la
+    // primera (segmentos sellados cada SEGMENTO_MAX_DOCS y mezclados por niveles), y despues las
+    // consultas de listas largas sobre los segmentos que quedan
+    InvertedIndex primeraMitad;
+    for (long long d = 0; d < numDocs / 2; ++d) {
+        primeraMitad.setLongitudDocumento(static_cast<int>(d), pd.procesarContenidoDocumentosVista(documentos[d], static_cast<int>(d), primeraMitad));
+    }
+    std::unique_ptr<IndiceParticionado> incremental;
+    resultados.push_back(medir("segmentos_agregar_documento", numDocs - numDocs / 2, reps, [&]() {
+        incremental.reset(new IndiceParticionado(1));
+        incremental->setPageRankScores(&pageRank);
+        incremental->construir(primeraMitad);
+        return cronometrar([&]() {
+            for (long long d = numDocs / 2; d < numDocs; ++d) {
+                incremental->agregarDocumento(documentos[d], pd);
+            }
+            incremental->sellar();
+            incremental->mezclar();
+        });
+    }));
+    bool identicoIncremental = incremental->getNumDocumentos() == ii.getNumDocumentos();
+    for (size_t i = 0; identicoIncremental && i < largas.size(); ++i) {
+        std::vector<ResultadoRankeado> topK = incremental->topK(largas[i], 10);
+        identicoIncremental = incremental->buscar(largas[i]) == esperadosAnd[i] && topK.size() == esperadosTopK[i].size();
+        for (size_t r = 0; identicoIncremental && r < topK.size(); ++r) {
+            identicoIncremental = topK[r].docId == esperadosTopK[i][r].docId && topK[r].score == esperadosTopK[i][r].score;
+        }
+    }
+    if (!identicoIncremental) {
+        std::cerr << "[BENCH] ERROR: con docs agregados el resultado no es el del indice completo" << std::endl;
+    }
+    resultados.back().extras.push_back(std::make_pair("segmentos", static_cast<double>(incremental->getNumSegmentos())));
+    resultados.back().extras.push_back(std::make_pair("mezclas", static_cast<double>(incremental->getMezclasHechas())));
+    resultados.back().extras.push_back(std::make_pair("identico", identicoIncremental ? 1.0 : 0.0));
+    resultados.push_back(medir("segmentos_and_pagerank", static_cast<long long>(largas.size()), reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::vector<std::string>& terminos : largas) {
+                total += static_cast<long long>(incremental->buscar(terminos).size());
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+    resultados.push_back(medir("segmentos_top10_bm25", static_cast<long long>(largas.size()), reps, [&]() {
+        return cronometrar([&]() {
+            long long total = 0;
+            for (const std::vector<std::string>& terminos : largas) {
+                total += static_cast<long long>(incremental->topK(terminos, 10).size());
+            }
+            sumidero = sumidero + total;
+        });
+    }));
+
+    std::cout.rdbuf(salida);
+    escribirJSON(resultados, {
+        {"documentos", numDocs},
+        {"palabras_por_doc", BENCH_PALABRAS_DOC},
+        {"vocabulario", BENCH_VOCABULARIO},
+        {"consultas", numConsultas},
+        {"consultas_distintas", BENCH_CONSULTAS_DISTINTAS},
+        {"semilla", semilla},
+        {"repeticiones", repeticiones},
+        {"hilos_hardware", static_cast<long long>(std::thread::hardware_concurrency())}
+    });
+    return 0;
+}
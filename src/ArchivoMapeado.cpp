@@ -0,0 +1,122 @@
+#include "ArchivoMapeado.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// CONSTRUCTOR archivo sin abrir
+ArchivoMapeado::ArchivoMapeado() : datos(nullptr), tamanio(0), abierto(false) {
+#ifdef _WIN32
+    archivo = nullptr;
+    mapeo = nullptr;
+#else
+    descriptor = -1;
+#endif
+}
+
+ArchivoMapeado::~ArchivoMapeado() {
+    cerrar();
+}
+
+#ifdef _WIN32
+
+bool ArchivoMapeado::abrir(const std::string& filename, bool accesoSecuencial) {
+    cerrar();
+    HANDLE h = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                           OPEN_EXISTING, accesoSecuencial ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS, nullptr);
+    if (h == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER largo;
+    if (!GetFileSizeEx(h, &largo)) {
+        CloseHandle(h);
+        return false;
+    }
+    archivo = h;
+    tamanio = static_cast<size_t>(largo.QuadPart);
+    abierto = true;
+    if (tamanio == 0) {
+        return true; // no se puede mapear un archivo vacio, queda como vista vacia
+    }
+
+    HANDLE m = CreateFileMappingA(h, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m == nullptr) {
+        cerrar();
+        return false;
+    }
+    mapeo = m;
+    datos = static_cast<const char*>(MapViewOfFile(m, FILE_MAP_READ, 0, 0, 0));
+    if (datos == nullptr) {
+        cerrar();
+        return false;
+    }
+    return true;
+}
+
+void ArchivoMapeado::cerrar() {
+    if (datos != nullptr) {
+        UnmapViewOfFile(datos);
+    }
+    if (mapeo != nullptr) {
+        CloseHandle(static_cast<HANDLE>(mapeo));
+    }
+    if (archivo != nullptr) {
+        CloseHandle(static_cast<HANDLE>(archivo));
+    }
+    datos = nullptr;
+    mapeo = nullptr;
+    archivo = nullptr;
+    tamanio = 0;
+    abierto = false;
+}
+
+#else
+
+bool ArchivoMapeado::abrir(const std::string& filename, bool accesoSecuencial) {
+    cerrar();
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+    descriptor = fd;
+    tamanio = static_cast<size_t>(info.st_size);
+    abierto = true;
+    if (tamanio == 0) {
+        return true; // mmap no acepta largo 0, queda como vista vacia
+    }
+
+    void* p = mmap(nullptr, tamanio, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (p == MAP_FAILED) {
+        cerrar();
+        return false;
+    }
+    // el archivo se lee de principio a fin
+    madvise(p, tamanio, accesoSecuencial ? MADV_SEQUENTIAL : MADV_RANDOM);
+    datos = static_cast<const char*>(p);
+    return true;
+}
+
+void ArchivoMapeado::cerrar() {
+    if (datos != nullptr) {
+        munmap(const_cast<char*>(datos), tamanio);
+    }
+    if (descriptor >= 0) {
+        ::close(descriptor);
+    }
+    datos = nullptr;
+    descriptor = -1;
+    tamanio = 0;
+    abierto = false;
+}
+
+#endif
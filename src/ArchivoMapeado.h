@@ -0,0 +1,39 @@
+#ifndef ARCHIVO_MAPEADO_H
+#define ARCHIVO_MAPEADO_H
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+
+// archivo de solo lectura mapeado en memoria (mmap), el contenido se recorre con
+// string_view sin copiarlo. se desmapea en el destructor
+class ArchivoMapeado {
+public:
+    ArchivoMapeado();
+    ~ArchivoMapeado();
+
+    ArchivoMapeado(const ArchivoMapeado&) = delete;
+    ArchivoMapeado& operator=(const ArchivoMapeado&) = delete;
+
+    // accesoSecuencial: lectura de principio a fin (corpus), si no acceso aleatorio (snapshot)
+    bool abrir(const std::string& filename, bool accesoSecuencial = true);
+    void cerrar();
+
+    bool estaAbierto() const { return abierto; }
+    const char* getDatos() const { return datos; }
+    size_t getTamanio() const { return tamanio; }
+    std::string_view getVista() const { return std::string_view(datos, tamanio); }
+
+private:
+    const char* datos;
+    size_t tamanio;
+    bool abierto;
+#ifdef _WIN32
+    void* archivo;
+    void* mapeo;
+#else
+    int descriptor;
+#endif
+};
+
+#endif
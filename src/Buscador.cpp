@@ -1,16 +1,19 @@
 #include "Buscador.h"
+#include "IndiceParticionado.h"
+#include "Interseccion.h"
 #include "LinkedList.h"
 #include "ProcesadorDocumentos.h"
 // #include "Utils.h"
 #include <iostream>
 
 Buscador::Buscador(InvertedIndex* index, ProcesadorDocumentos* docProcessor)
-    : invertedIndex(index), docProcesador(docProcessor) {
+    : particionado(nullptr), invertedIndex(index), docProcesador(docProcessor), pageRankScores(nullptr), ranking(index) {
     // Los punteros se inicializan en la lista de inicialización.
 }
 
-void Buscador::setPageRankScores(const std::map<int, double>* scores) {
+void Buscador::setPageRankScores(const std::map<int, double>* scores, double pesoRanking) {
     pageRankScores = scores;
+    ranking.setPageRank(scores, pesoRanking);
 }
 
 std::vector<std::string> Buscador::procesarQueryString(const std::string& queryString) const {
@@ -18,95 +21,80 @@ std::vector<std::string> Buscador::procesarQueryString(const std::string& queryS
 }
 
 LinkedList<int>* Buscador::query(const std::string& queryString) const {
+    CronometroConsulta cronometro(metricas);
     std::vector<std::string> terminosQuery = procesarQueryString(queryString);
+    cronometro.marcar(ETAPA_NORMALIZACION);
 
     if (terminosQuery.empty()) {
         std::cout << "No se encontraron terminos validos para la consulta" << std::endl;
         return new LinkedList<int>();
     }
 
-    if (terminosQuery.size() == 1) {
-        const LinkedList<int>* resultado = invertedIndex->search(terminosQuery[0]);
-        if (resultado) {
-            LinkedList<int>* resultadoCopia = new LinkedList<int>();
-            Node<int>* actual = resultado->getHead();
-            while (actual != nullptr) {
-                resultadoCopia->add(actual->data);
-                actual = actual->next;
-            }
-            
-            return resultadoCopia;
-        } else {
-            return new LinkedList<int>();
-        }
+    std::vector<int> docs;
+    if (particionado != nullptr) {
+        // cada segmento busca sus listas, intersecta y ordena por pagerank: todo es una etapa
+        docs = particionado->buscar(terminosQuery);
+        cronometro.marcar(ETAPA_INTERSECCION);
     } else {
+        // lo mismo que invertedIndex->search(terminos) pero por partes, para medir cada una
+        std::vector<const ListaPosteo*> listas;
+        listas.reserve(terminosQuery.size());
+        for (const std::string& termino : terminosQuery) {
+            listas.push_back(invertedIndex->search(termino)); // un nullptr hace vacia la interseccion
+        }
+        cronometro.marcar(ETAPA_POSTEO);
+        docs = Interseccion::intersectar(listas);
+        cronometro.marcar(ETAPA_INTERSECCION);
 
-        const LinkedList<int>* primeraLista = invertedIndex->search(terminosQuery[0]);
-        LinkedList<int>* resultadoActual;
-
-        if (primeraLista) {
-            resultadoActual = new LinkedList<int>();
-            Node<int>* nodoTemporal = primeraLista->getHead();
-            while(nodoTemporal != nullptr) {
-                resultadoActual->add(nodoTemporal->data);
-                nodoTemporal = nodoTemporal->next;
-            }
-        } else {
-            return new LinkedList<int>();
+        // reordenamiento del pagerank
+        if (terminosQuery.size() > 1) {
+            ordenarPorPageRank(docs);
+            cronometro.marcar(ETAPA_PAGERANK);
         }
+    }
 
-        for (size_t i = 1; i < terminosQuery.size(); ++i) {
-            const LinkedList<int>* nuevaLista = invertedIndex->search(terminosQuery[i]);
-            if (!nuevaLista) {
-                delete resultadoActual;
-                return new LinkedList<int>();
-            }
+    LinkedList<int>* resultado = new LinkedList<int>();
+    for (int docId : docs) {
+        resultado->agregarAlFinal(docId);
+    }
+    cronometro.marcar(ETAPA_COPIA);
+    cronometro.terminar();
+    return resultado;
+}
 
-            LinkedList<int>* nuevaInterseccion = invertedIndex->interseccionListaPosteo(resultadoActual, nuevaLista);
-            delete resultadoActual;
-            resultadoActual = nuevaInterseccion;
+bool Buscador::mejorPageRank(const std::pair<int, double>& a, const std::pair<int, double>& b) {
+    if (a.second != b.second) {
+        return a.second > b.second;
+    }
+    return a.first < b.first;
+}
 
-            if (resultadoActual->getSize() == 0) {
-                return resultadoActual;
-            }
-        }
-        // return resultadoActual;
-        // reordenamiento del pagerank
-        if (resultadoActual->getSize() > 0 && pageRankScores != nullptr) {
-            std::vector<std::pair<int, double>> rankedDocs;
-            Node<int>* nodoResultadoActual = resultadoActual->getHead();
-
-            while (nodoResultadoActual != nullptr) {
-                int docId = nodoResultadoActual->data;
-                double score = 0.0;
-                auto it = pageRankScores->find(docId);
-                if (it != pageRankScores->end()) {
-                    score = it->second;
-                } else {
-                    score = 0.000000001; // valor pequenio para quedar al ultimo
-                }
-                rankedDocs.push_back({docId, score});
-                // std::cout << "DEBUG: Doc " << docId << ", PR Score: " << score << std::endl;
-                nodoResultadoActual = nodoResultadoActual->next;
-            }
-
-            std::sort(rankedDocs.begin(), rankedDocs.end(), [](const auto& a, const auto& b) {
-                return a.second > b.second;
-            });
-
-            // crear una nuewva lista q este ordenada
-            LinkedList<int>* resultadoFinalRankeado = new LinkedList<int>();
-            for (const auto& docPair : rankedDocs) {
-                resultadoFinalRankeado->add(docPair.first);
-            }
-
-            delete resultadoActual;
-            return resultadoFinalRankeado;
+std::vector<std::pair<int, double>> Buscador::rankearPorPageRank(const std::vector<int>& docs, const std::map<int, double>& scores) {
+    std::vector<std::pair<int, double>> rankedDocs;
+    rankedDocs.reserve(docs.size());
+    for (int docId : docs) {
+        double score = 0.0;
+        auto it = scores.find(docId);
+        if (it != scores.end()) {
+            score = it->second;
         } else {
-            return resultadoActual;
+            score = 0.000000001; // valor pequenio para quedar al ultimo
         }
+        rankedDocs.push_back({docId, score});
     }
 
+    std::sort(rankedDocs.begin(), rankedDocs.end(), mejorPageRank);
+    return rankedDocs;
+}
+
+void Buscador::ordenarPorPageRank(std::vector<int>& docs) const {
+    if (docs.empty() || pageRankScores == nullptr) {
+        return;
+    }
+    std::vector<std::pair<int, double>> rankedDocs = rankearPorPageRank(docs, *pageRankScores);
+    for (size_t i = 0; i < rankedDocs.size(); ++i) {
+        docs[i] = rankedDocs[i].first;
+    }
 }
 
 LinkedList<int>* Buscador::querySinPR(const std::string& queryString) const {
@@ -115,49 +103,28 @@ LinkedList<int>* Buscador::querySinPR(const std::string& queryString) const {
     if (terminosQuery.empty()) {
         return new LinkedList<int>();
     }
+    return invertedIndex->search(terminosQuery);
+}
 
-    LinkedList<int>* initialResults;
-
-    if (terminosQuery.size() == 1) {
-        const LinkedList<int>* resultado = invertedIndex->search(terminosQuery[0]);
-        if (resultado) {
-            initialResults = new LinkedList<int>();
-            Node<int>* actual = resultado->getHead();
-            while (actual != nullptr) {
-                initialResults->add(actual->data);
-                actual = actual->next;
-            }
-        } else {
-            initialResults = new LinkedList<int>();
-        }
-    } else {
-        const LinkedList<int>* primeraLista = invertedIndex->search(terminosQuery[0]);
-        if (!primeraLista) {
-            return new LinkedList<int>();
-        }
-
-        initialResults = new LinkedList<int>();
-        Node<int>* nodoTemporal = primeraLista->getHead();
-        while(nodoTemporal != nullptr) {
-            initialResults->add(nodoTemporal->data);
-            nodoTemporal = nodoTemporal->next;
-        }
-
-        for (size_t i = 1; i < terminosQuery.size(); ++i) {
-            const LinkedList<int>* nuevaLista = invertedIndex->search(terminosQuery[i]);
-            if (!nuevaLista) {
-                delete initialResults;
-                return new LinkedList<int>();
-            }
+std::vector<ResultadoRankeado> Buscador::queryTopK(const std::string& queryString, int k, bool conjuntiva) const {
+    if (particionado != nullptr) {
+        return particionado->topK(procesarQueryString(queryString), k, conjuntiva);
+    }
+    return ranking.topK(procesarQueryString(queryString), k, conjuntiva);
+}
 
-            LinkedList<int>* nuevaInterseccion = invertedIndex->interseccionListaPosteo(initialResults, nuevaLista);
-            delete initialResults;
-            initialResults = nuevaInterseccion;
+std::vector<int> Buscador::queryFrase(const std::string& queryString) const {
+    if (!invertedIndex->esPosicional()) {
+        std::cerr << "El indice no tiene posiciones, no se pueden buscar frases." << std::endl;
+        return std::vector<int>();
+    }
+    return invertedIndex->buscarFrase(docProcesador->getCleanWordsConPosicion(queryString));
+}
 
-            if (initialResults->getSize() == 0) {
-                return initialResults;
-            }
-        }
+std::vector<int> Buscador::queryProximidad(const std::string& queryString, int distancia) const {
+    if (!invertedIndex->esPosicional()) {
+        std::cerr << "El indice no tiene posiciones, no se pueden buscar terminos cercanos." << std::endl;
+        return std::vector<int>();
     }
-    return initialResults;
-}
\ No newline at end of file
+    return invertedIndex->buscarProximidad(procesarQueryString(queryString), distancia);
+}
@@ -9,7 +9,10 @@
 #include "InvertedIndex.h"
 #include "ProcesadorDocumentos.h"
 #include "LinkedList.h"
+#include "MetricasConsulta.h"
+#include "RankingBM25.h"
 
+class IndiceParticionado;
 
 class Buscador {
 public:
@@ -17,15 +20,40 @@ public:
 
     LinkedList<int>* query(const std::string& queryString) const;
     LinkedList<int>* querySinPR(const std::string& queryString) const;
-
-    void setPageRankScores(const std::map<int, double>* scores);
+    // los K docs con mayor BM25 (+ pagerank si hay scores), por defecto con OR entre terminos
+    std::vector<ResultadoRankeado> queryTopK(const std::string& queryString, int k, bool conjuntiva = false) const;
+    // solo con el indice en modo posicional: frase exacta, o todos los terminos a una
+    // distancia de a lo sumo "distancia" posiciones
+    std::vector<int> queryFrase(const std::string& queryString) const;
+    std::vector<int> queryProximidad(const std::string& queryString, int distancia) const;
+
+    void setPageRankScores(const std::map<int, double>* scores, double pesoRanking = PESO_PAGERANK_BM25);
+    // con un indice por segmentos (shards y docs agregados despues), query, queryTopK y los
+    // misses de la cache se reparten entre los segmentos (que ya tienen que tener el pagerank).
+    // las frases y querySinPR siguen usando solo el indice cargado. nullptr = el indice completo
+    void setParticionado(const IndiceParticionado* indice) { particionado = indice; }
+
+    // pares (doc, pagerank) de mayor a menor pagerank, los docs sin score al final. los
+    // empates van por doc id menor, asi el orden no depende de como llegaron los docs
+    static std::vector<std::pair<int, double>> rankearPorPageRank(const std::vector<int>& docs, const std::map<int, double>& scores);
+    static bool mejorPageRank(const std::pair<int, double>& a, const std::pair<int, double>& b);
 
     std::vector<std::string> procesarQueryString(const std::string& queryString) const;
+
+    // latencia por etapa de query y queryConCache, apagada hasta que se llame setActivas(true)
+    MetricasConsulta& getMetricas() const { return metricas; }
+protected:
+    // ordena los docs por pagerank de mayor a menor (no hace nada sin scores)
+    void ordenarPorPageRank(std::vector<int>& docs) const;
+
+    mutable MetricasConsulta metricas;
+    const IndiceParticionado* particionado;
 private:
     InvertedIndex* invertedIndex;
     ProcesadorDocumentos* docProcesador;
 
     const std::map<int,double>* pageRankScores;
+    RankingBM25 ranking;
 
 };
 
@@ -1,14 +1,16 @@
 #include "BuscadorConCache.h"
+#include "IndiceParticionado.h"
 #include <algorithm>
 #include <iostream>
 
 // CONSTRUCTOR inicialioza el buscador y el tamanio del cache
-BuscadorConCache::BuscadorConCache(InvertedIndex* index, ProcesadorDocumentos* docProcessor, int cacheSize)
-    : Buscador(index, docProcessor), cache(cacheSize) {}
+BuscadorConCache::BuscadorConCache(InvertedIndex* index, ProcesadorDocumentos* docProcessor, int cacheSize,
+                                   int politicaCache, int capacidadIntersecciones, size_t cacheBytes)
+    : Buscador(index, docProcessor), cache(cacheSize, politicaCache, cacheBytes), intersecciones(index, capacidadIntersecciones), mensajes(true) {}
 
 // crea una clave unica para la cache a partir de los terminos de la consulta
 // ordena los terminos y los une con "_"
-std::string BuscadorConCache::crearLlaveCache(const std::vector<std::string>& terminos) const {
+std::string BuscadorConCache::crearLlaveCache(const std::vector<std::string>& terminos) {
     std::vector<std::string> sortedTerms = terminos;
     std::sort(sortedTerms.begin(), sortedTerms.end());
     std::string key = "";
@@ -21,48 +23,73 @@ std::string BuscadorConCache::crearLlaveCache(const std::vector<std::string>& te
     return key;
 }
 
+std::string BuscadorConCache::llaveConVersion(const std::string& llave, uint64_t version) {
+    return std::to_string(version) + "#" + llave;
+}
+
 // consulta usando la cache LRU
-LinkedList<int>* BuscadorConCache::queryConCache(const std::string& queryString) const {
+ResultadoCache BuscadorConCache::queryConCache(const std::string& queryString) const {
+    CronometroConsulta cronometro(metricas);
     // procesa para obtener los terminos limpios
     std::vector<std::string> terminosQuery = procesarQueryString(queryString);
+    cronometro.marcar(ETAPA_NORMALIZACION);
 
     if (terminosQuery.empty()) {
-        std::cout << "No se encontraron terminos validos para la consulta" << std::endl;
-        return new LinkedList<int>();
+        if (mensajes) {
+            std::cout << "No se encontraron terminos validos para la consulta" << std::endl;
+        }
+        return std::make_shared<const ResultadoComprimido>();
     }
 
-    // crea la clave de cache para consultar
+    // crea la clave de cache para consultar. con segmentos la clave lleva la version de la
+    // vista: cuando se agregan docs las entradas viejas ya no se encuentran y las desaloja
+    // la politica, sin vaciar la cache ni bloquear a las consultas que estan en curso
     std::string cacheKey = crearLlaveCache(terminosQuery);
+    uint64_t version = 0;
+    if (particionado != nullptr) {
+        version = particionado->getVersion();
+        cacheKey = llaveConVersion(cacheKey, version);
+    }
 
-    // busca en la cache 
-    LinkedList<int>* cachedResult = cache.get(cacheKey);
+    // busca en la cache, si esta se devuelve el mismo resultado que tiene guardado
+    ResultadoCache cachedResult = cache.get(cacheKey);
+    cronometro.marcar(ETAPA_BUSQUEDA_CACHE);
     if (cachedResult) {
-        std::cout << "Resultado obtenido desde cache (HIT)" << std::endl;
-        LinkedList<int>* resultCopy = new LinkedList<int>();
-        Node<int>* current = cachedResult->getHead();
-        while (current != nullptr) {
-            resultCopy->add(current->data);
-            current = current->next;
+        cronometro.terminar();
+        if (mensajes) {
+            std::cout << "Resultado obtenido desde cache (HIT)" << std::endl;
         }
-        return resultCopy;
+        return cachedResult;
     }
 
-    // si no esta en la cache hace la consulta normal
-    LinkedList<int>* result = this->query(queryString);
-
-
-    // si existe el resultado lo guarda en la cache
-    if (result && result->getSize() > 0) {
-        LinkedList<int>* resultForCache = new LinkedList<int>();
-        Node<int>* current = result->getHead();
-        while (current != nullptr) {
-            resultForCache->add(current->data);
-            current = current->next;
+    // si no esta en la cache intersecta (partiendo de un subconjunto guardado si hay) y
+    // reordena por pagerank igual que query. con segmentos la cache de intersecciones no se
+    // usa, y si mientras tanto se sello un segmento el resultado se guarda con la version nueva
+    std::vector<int> docs;
+    if (particionado != nullptr) {
+        uint64_t versionUsada = version;
+        docs = particionado->buscar(terminosQuery, &versionUsada);
+        if (versionUsada != version) {
+            cacheKey = llaveConVersion(crearLlaveCache(terminosQuery), versionUsada);
+        }
+        cronometro.marcar(ETAPA_INTERSECCION);
+    } else {
+        docs = intersecciones.intersectar(terminosQuery, &cronometro);
+        if (terminosQuery.size() > 1) {
+            ordenarPorPageRank(docs);
+            cronometro.marcar(ETAPA_PAGERANK);
         }
-        cache.put(cacheKey, resultForCache);
     }
+    ResultadoCache compartido = std::make_shared<const ResultadoComprimido>(docs);
 
-    return result;
+    // si hay resultados la cache se queda con otra referencia al mismo resultado
+    if (!compartido->empty()) {
+        cache.put(cacheKey, compartido);
+    }
+    cronometro.marcar(ETAPA_COPIA);
+    cronometro.terminar();
+
+    return compartido;
 }
 
 void BuscadorConCache::printCacheState() const {
@@ -79,5 +106,11 @@ void BuscadorConCache::printCacheMetrics() const {
     std::cout << "Numero de reemplazos: " << cache.getReplacements() << std::endl;
     std::cout << "Numero de inserciones en cache: " << cache.getInsertions() << std::endl;
     std::cout << "Numero actual de elementos en cache: " << cache.getCurrentSize() << std::endl;
+    std::cout << "Bytes usados en cache: " << cache.getBytesUsados();
+    if (cache.getPresupuestoBytes() > 0) {
+        std::cout << " de " << cache.getPresupuestoBytes();
+    }
+    std::cout << std::endl;
+    std::cout << "Bytes desalojados: " << cache.getBytesDesalojados() << std::endl;
     std::cout << "=========================" << std::endl;
 }
\ No newline at end of file
@@ -2,21 +2,38 @@
 #define BUSCADOR_CON_CACHE_H
 
 #include "Buscador.h"
-#include "LRUCache.h"
+#include "CacheIntersecciones.h"
+#include "LRUCacheConcurrente.h"
+#include <cstdint>
 #include <vector>
 #include <string>
 
 class BuscadorConCache : public Buscador {
 private:
-    mutable LRUCache cache;
-    std::string crearLlaveCache(const std::vector<std::string>& terminos) const;
+    mutable LRUCacheConcurrente cache; // por shards, se puede consultar desde varios hilos
+    mutable CacheIntersecciones intersecciones; // los misses parten de subconjuntos ya calculados
+    bool mensajes; // avisos por consola en cada consulta (hit, consulta vacia)
 
 public:
-    BuscadorConCache(InvertedIndex* index, ProcesadorDocumentos* docProcessor, int cacheSize = 20);
+    // politicaCache: POLITICA_LRU, POLITICA_SLRU, POLITICA_ARC o POLITICA_TINYLFU.
+    // capacidadIntersecciones 0 = solo clave exacta, sin reusar subconjuntos.
+    // cacheBytes: presupuesto en bytes de la cache de resultados, 0 = solo cacheSize entradas
+    BuscadorConCache(InvertedIndex* index, ProcesadorDocumentos* docProcessor, int cacheSize = 20,
+                     int politicaCache = POLITICA_LRU, int capacidadIntersecciones = 0, size_t cacheBytes = 0);
 
-    LinkedList<int>* queryConCache(const std::string& queryString) const;
+    // clave de la cache: terminos ordenados y unidos con "_"
+    static std::string crearLlaveCache(const std::vector<std::string>& terminos);
+    // con segmentos: "version#clave"
+    static std::string llaveConVersion(const std::string& llave, uint64_t version);
+
+    // resultado compartido con la cache, de solo lectura: un hit no copia nada
+    ResultadoCache queryConCache(const std::string& queryString) const;
+    // el modo servidor los apaga: muchos hilos escribiendo en std::cout
+    void setMensajes(bool valor) { mensajes = valor; }
     void printCacheState() const;
     void printCacheMetrics() const;
+    const LRUCacheConcurrente& getCache() const { return cache; }
+    CacheIntersecciones& getIntersecciones() { return intersecciones; }
 };
 
 #endif
\ No newline at end of file
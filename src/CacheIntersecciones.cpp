@@ -0,0 +1,199 @@
+#include "CacheIntersecciones.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <unordered_map>
+
+#include "Interseccion.h"
+
+// terminos ya ordenados unidos con "_", el mismo formato que las claves de BuscadorConCache
+static std::string unirTerminos(const std::vector<std::string>& terminos, unsigned mascara) {
+    std::string clave;
+    for (size_t i = 0; i < terminos.size(); ++i) {
+        if (mascara & (1u << i)) {
+            if (!clave.empty()) {
+                clave += "_";
+            }
+            clave += terminos[i];
+        }
+    }
+    return clave;
+}
+
+static int contarBits(unsigned mascara) {
+    int bits = 0;
+    for (; mascara != 0; mascara &= mascara - 1) {
+        bits++;
+    }
+    return bits;
+}
+
+// CONSTRUCTOR la cache es de un solo shard por debajo de CAPACIDAD_MINIMA_SHARD
+CacheIntersecciones::CacheIntersecciones(const InvertedIndex* idx, int cap)
+    : index(idx), capacidad(cap), cache(cap > 0 ? new LRUCacheConcurrente(cap) : nullptr), paresFijos(64),
+      consultas(0), reusadas(0), interseccionesHechas(0), interseccionesEvitadas(0) {}
+
+CacheIntersecciones::~CacheIntersecciones() {
+    delete cache;
+}
+
+ResultadoCache CacheIntersecciones::buscarGuardado(const std::string& clave) {
+    const ResultadoCache* fijo = paresFijos.search(clave);
+    if (fijo != nullptr) {
+        return *fijo;
+    }
+    return cache != nullptr ? cache->get(clave) : ResultadoCache();
+}
+
+// prueba todos los subconjuntos de 2 o mas terminos y se queda con el guardado de menos
+// docs (menos candidatos para filtrar). el conjunto completo, si esta, es el menor
+ResultadoCache CacheIntersecciones::mejorSubconjunto(const std::vector<std::string>& terminos, unsigned& mascaraUsada) {
+    unsigned completo = (1u << terminos.size()) - 1;
+    ResultadoCache mejor;
+    mascaraUsada = 0;
+    for (unsigned mascara = completo; mascara != 0; --mascara) {
+        if (contarBits(mascara) < 2) {
+            continue;
+        }
+        ResultadoCache guardado = buscarGuardado(unirTerminos(terminos, mascara));
+        if (guardado && (!mejor || guardado->size() < mejor->size())) {
+            mejor = guardado;
+            mascaraUsada = mascara;
+            if (mascara == completo || mejor->empty()) {
+                break;
+            }
+        }
+    }
+    return mejor;
+}
+
+std::vector<int> CacheIntersecciones::intersectar(const std::vector<std::string>& terminosQuery, CronometroConsulta* cronometro) {
+    CronometroConsulta sinMedir;
+    CronometroConsulta& medir = cronometro != nullptr ? *cronometro : sinMedir;
+
+    std::vector<std::string> terminos = terminosQuery;
+    std::sort(terminos.begin(), terminos.end());
+    terminos.erase(std::unique(terminos.begin(), terminos.end()), terminos.end());
+
+    std::vector<const ListaPosteo*> listas;
+    for (const std::string& termino : terminos) {
+        const ListaPosteo* lista = index->search(termino);
+        if (lista == nullptr) {
+            medir.marcar(ETAPA_POSTEO);
+            return std::vector<int>(); // un termino que no esta: no hay nada que intersectar
+        }
+        listas.push_back(lista);
+    }
+    medir.marcar(ETAPA_POSTEO);
+    if (listas.size() < 2) {
+        std::vector<int> resultado = Interseccion::intersectar(listas);
+        medir.marcar(ETAPA_INTERSECCION);
+        return resultado;
+    }
+    consultas++;
+
+    unsigned mascaraUsada = 0;
+    ResultadoCache base;
+    if (cache != nullptr && terminos.size() <= MAX_TERMINOS_SUBCONJUNTOS) {
+        base = mejorSubconjunto(terminos, mascaraUsada);
+    }
+
+    // se filtra con las listas que no cubre el subconjunto, la mas corta primero
+    std::vector<const ListaPosteo*> restantes;
+    for (size_t i = 0; i < listas.size(); ++i) {
+        if (!(mascaraUsada & (1u << i))) {
+            restantes.push_back(listas[i]);
+        }
+    }
+    std::sort(restantes.begin(), restantes.end(), [](const ListaPosteo* a, const ListaPosteo* b) {
+        return a->getSize() < b->getSize();
+    });
+
+    std::vector<uint32_t> candidatos;
+    size_t desde = 0;
+    if (base) {
+        std::vector<int> docsBase = base->descomprimir();
+        candidatos.assign(docsBase.begin(), docsBase.end());
+        reusadas++;
+        interseccionesEvitadas += contarBits(mascaraUsada) - 1;
+    } else {
+        candidatos.reserve(restantes[0]->getSize());
+        for (ListaPosteo::Iterador it = restantes[0]->begin(); it.valido(); it.siguiente()) {
+            candidatos.push_back(static_cast<uint32_t>(it.docId()));
+        }
+        desde = 1;
+    }
+    for (size_t i = desde; i < restantes.size() && !candidatos.empty(); ++i) {
+        Interseccion::filtrar(candidatos, *restantes[i]);
+        interseccionesHechas++;
+    }
+
+    std::vector<int> resultado(candidatos.begin(), candidatos.end());
+    // se guarda el conjunto completo, tambien si quedo vacio: cualquier consulta que lo
+    // contenga va a dar vacio sin leer listas
+    if (cache != nullptr && mascaraUsada != (1u << terminos.size()) - 1) {
+        cache->put(unirTerminos(terminos, (1u << terminos.size()) - 1), std::make_shared<const ResultadoComprimido>(resultado));
+    }
+    medir.marcar(ETAPA_INTERSECCION);
+    return resultado;
+}
+
+int CacheIntersecciones::fijarParesFrecuentes(const std::string& archivoLog, const ProcesadorDocumentos& pd, int maxPares, int limite) {
+    std::ifstream log(archivoLog);
+    if (!log.is_open()) {
+        std::cerr << "[ERROR] No se pudo abrir el archivo de consultas: " << archivoLog << std::endl;
+        return 0;
+    }
+
+    std::unordered_map<std::string, int> frecuencias;
+    std::string linea;
+    int leidas = 0;
+    while (std::getline(log, linea) && (limite <= 0 || leidas < limite)) {
+        leidas++;
+        std::vector<std::string> terminos = pd.getCleanWords(linea);
+        std::sort(terminos.begin(), terminos.end());
+        terminos.erase(std::unique(terminos.begin(), terminos.end()), terminos.end());
+        if (terminos.size() < 2 || terminos.size() > MAX_TERMINOS_SUBCONJUNTOS) {
+            continue;
+        }
+        for (size_t i = 0; i < terminos.size(); ++i) {
+            for (size_t j = i + 1; j < terminos.size(); ++j) {
+                frecuencias[terminos[i] + "_" + terminos[j]]++;
+            }
+        }
+    }
+
+    std::vector<std::pair<int, std::string>> pares;
+    for (const auto& par : frecuencias) {
+        if (par.second >= 2) {
+            pares.push_back(std::make_pair(par.second, par.first));
+        }
+    }
+    // mas frecuentes primero, en empate por clave para que sea determinista
+    std::sort(pares.begin(), pares.end(), [](const auto& a, const auto& b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    int fijados = 0;
+    for (size_t i = 0; i < pares.size() && fijados < maxPares; ++i) {
+        const std::string& clave = pares[i].second;
+        size_t separador = clave.find('_');
+        std::vector<const ListaPosteo*> listas = {
+            index->search(std::string_view(clave).substr(0, separador)),
+            index->search(std::string_view(clave).substr(separador + 1))
+        };
+        paresFijos.insert(clave, std::make_shared<const ResultadoComprimido>(Interseccion::intersectar(listas)));
+        fijados++;
+    }
+    return fijados;
+}
+
+EstadisticasIntersecciones CacheIntersecciones::getEstadisticas() const {
+    EstadisticasIntersecciones estadisticas;
+    estadisticas.consultas = consultas;
+    estadisticas.reusadas = reusadas;
+    estadisticas.interseccionesHechas = interseccionesHechas;
+    estadisticas.interseccionesEvitadas = interseccionesEvitadas;
+    return estadisticas;
+}
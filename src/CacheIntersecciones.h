@@ -0,0 +1,65 @@
+#ifndef CACHE_INTERSECCIONES_H
+#define CACHE_INTERSECCIONES_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "HashTable.h"
+#include "InvertedIndex.h"
+#include "LRUCacheConcurrente.h"
+#include "MetricasConsulta.h"
+#include "ProcesadorDocumentos.h"
+
+// con mas terminos distintos que esto no se buscan subconjuntos (serian 2^n claves)
+#define MAX_TERMINOS_SUBCONJUNTOS 8
+
+struct EstadisticasIntersecciones {
+    long long consultas;              // consultas AND con 2 o mas terminos distintos
+    long long reusadas;               // resueltas a partir de un subconjunto guardado
+    long long interseccionesHechas;   // listas de posteo filtradas contra los candidatos
+    long long interseccionesEvitadas; // las que se hubieran hecho sin el subconjunto
+};
+
+// cache de intersecciones AND por conjunto de terminos, con los doc ids ordenados.
+// a diferencia de la cache de resultados (clave exacta), aca "a b c" puede partir del
+// resultado guardado de "a b" y filtrarlo solo con la lista de "c". de todos los
+// subconjuntos guardados se usa el de menos docs. ademas se pueden fijar los pares de
+// terminos mas frecuentes del log, que no se desalojan nunca.
+// con capacidad 0 no guarda nada y solo cuenta las intersecciones (clave exacta)
+class CacheIntersecciones {
+public:
+    CacheIntersecciones(const InvertedIndex* index, int capacidad = 0);
+    ~CacheIntersecciones();
+    CacheIntersecciones(const CacheIntersecciones&) = delete;
+    CacheIntersecciones& operator=(const CacheIntersecciones&) = delete;
+
+    // interseccion de los terminos, ordenada por doc id (como InvertedIndex::search).
+    // con cronometro marca la obtencion de las listas y la interseccion por separado
+    std::vector<int> intersectar(const std::vector<std::string>& terminos, CronometroConsulta* cronometro = nullptr);
+
+    // cuenta los pares de terminos de las consultas del log y fija los maxPares que mas
+    // se repiten (al menos 2 veces). retorna cuantos fijo. llamarlo antes de consultar,
+    // los pares fijos no se protegen con mutex
+    int fijarParesFrecuentes(const std::string& archivoLog, const ProcesadorDocumentos& pd, int maxPares, int limite = 0);
+
+    EstadisticasIntersecciones getEstadisticas() const;
+    int getCapacidad() const { return capacidad; }
+    int getNumParesFijos() const { return paresFijos.size(); }
+
+private:
+    const InvertedIndex* index;
+    int capacidad;
+    LRUCacheConcurrente* cache; // nullptr con capacidad 0
+    HashTable<std::string, ResultadoCache> paresFijos;
+
+    std::atomic<long long> consultas;
+    std::atomic<long long> reusadas;
+    std::atomic<long long> interseccionesHechas;
+    std::atomic<long long> interseccionesEvitadas;
+
+    ResultadoCache buscarGuardado(const std::string& clave);
+    ResultadoCache mejorSubconjunto(const std::vector<std::string>& terminos, unsigned& mascaraUsada);
+};
+
+#endif
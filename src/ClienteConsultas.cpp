@@ -0,0 +1,140 @@
+#include "ClienteConsultas.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <thread>
+
+#include "MetricasConsulta.h"
+#include "ServidorConsultas.h"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// una conexion: manda sus consultas (indices de consultas) y junta las respuestas
+static bool correrConexion(const std::string& ruta, const std::vector<std::string>& consultas, const std::vector<size_t>& indices,
+                           int profundidad, std::vector<std::string>* respuestas, HistogramaLatencia& latencias) {
+    sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    std::strncpy(direccion.sun_path, ruta.c_str(), sizeof(direccion.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0) {
+        std::cerr << "[CLIENTE] No se pudo conectar a " << ruta << ": " << std::strerror(errno) << std::endl;
+        if (fd >= 0) {
+            close(fd);
+        }
+        return false;
+    }
+
+    std::deque<std::chrono::steady_clock::time_point> enviadas; // las que esperan respuesta, en orden
+    size_t siguiente = 0;
+    size_t recibidas = 0;
+    std::string salida;
+    std::string entrada;
+    char buffer[65536];
+    bool ok = true;
+    while (ok && recibidas < indices.size()) {
+        // completar la ventana de consultas sin responder, todas en un solo send
+        salida.clear();
+        auto ahora = std::chrono::steady_clock::now();
+        while (siguiente < indices.size() && enviadas.size() < static_cast<size_t>(profundidad)) {
+            salida += consultas[indices[siguiente++]];
+            salida += '\n';
+            enviadas.push_back(ahora);
+        }
+        for (size_t escrito = 0; escrito < salida.size();) {
+            ssize_t n = send(fd, salida.data() + escrito, salida.size() - escrito, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                ok = false;
+                break;
+            }
+            escrito += static_cast<size_t>(n);
+        }
+
+        // leer lo que haya (al menos una respuesta)
+        ssize_t leido = ok ? recv(fd, buffer, sizeof(buffer), 0) : -1;
+        if (leido < 0 && errno == EINTR) {
+            continue;
+        }
+        if (leido <= 0) {
+            ok = false;
+            break;
+        }
+        entrada.append(buffer, static_cast<size_t>(leido));
+        size_t inicio = 0;
+        for (size_t fin = entrada.find('\n'); fin != std::string::npos; fin = entrada.find('\n', inicio)) {
+            auto llegada = std::chrono::steady_clock::now();
+            latencias.registrar(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(llegada - enviadas.front()).count()));
+            enviadas.pop_front();
+            if (respuestas != nullptr) {
+                (*respuestas)[indices[recibidas]] = entrada.substr(inicio, fin - inicio);
+            }
+            recibidas++;
+            inicio = fin + 1;
+        }
+        entrada.erase(0, inicio);
+    }
+    close(fd);
+    if (!ok) {
+        std::cerr << "[CLIENTE] La conexion se corto con " << indices.size() - recibidas << " consultas sin respuesta" << std::endl;
+    }
+    return ok;
+}
+
+int correrCliente(const std::string& ruta, const std::vector<std::string>& consultas, int conexiones, int profundidad, bool imprimir) {
+    conexiones = std::max(1, conexiones);
+    // con mas pendientes que el servidor el envio se podria trabar con el servidor sin leer
+    profundidad = std::max(1, std::min(profundidad, MAX_PENDIENTES_CONEXION));
+
+    std::vector<std::vector<size_t>> reparto(conexiones);
+    for (size_t i = 0; i < consultas.size(); ++i) {
+        reparto[i % conexiones].push_back(i);
+    }
+    std::vector<std::string> respuestas(imprimir ? consultas.size() : 0);
+    HistogramaLatencia latencias;
+    std::atomic<int> fallidas(0);
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<std::thread> hilos;
+    for (int c = 0; c < conexiones; ++c) {
+        hilos.emplace_back([&, c]() {
+            if (!correrConexion(ruta, consultas, reparto[c], profundidad, imprimir ? &respuestas : nullptr, latencias)) {
+                fallidas++;
+            }
+        });
+    }
+    for (std::thread& hilo : hilos) {
+        hilo.join();
+    }
+    double segundos = std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+
+    for (const std::string& respuesta : respuestas) {
+        std::cout << respuesta << "\n";
+    }
+    std::cout.flush();
+    std::cerr << "[CLIENTE] " << latencias.getCantidad() << " consultas en " << conexiones << " conexiones (profundidad "
+              << profundidad << ") en " << segundos * 1000 << " ms: " << latencias.getCantidad() / std::max(segundos, 1e-9)
+              << " consultas/s" << std::endl;
+    std::cerr << "[CLIENTE] latencia p50 " << latencias.percentil(50) / 1000.0 << " us, p99 " << latencias.percentil(99) / 1000.0
+              << " us, p999 " << latencias.percentil(99.9) / 1000.0 << " us, max " << latencias.getMaximo() / 1000.0 << " us" << std::endl;
+    return fallidas.load() == 0 ? 0 : 1;
+}
+
+#else
+
+int correrCliente(const std::string& ruta, const std::vector<std::string>&, int, int, bool) {
+    std::cerr << "[CLIENTE] El cliente (" << ruta << ") solo esta disponible en Linux." << std::endl;
+    return 1;
+}
+
+#endif
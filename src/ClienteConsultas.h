@@ -0,0 +1,15 @@
+#ifndef CLIENTE_CONSULTAS_H
+#define CLIENTE_CONSULTAS_H
+
+#include <string>
+#include <vector>
+
+// cliente de prueba del modo servidor (ver ServidorConsultas.h): reparte las consultas
+// entre "conexiones" conexiones, cada una con hasta "profundidad" consultas sin responder
+// (pipelining), y mide la latencia de cada una desde que se manda hasta que llega su
+// respuesta. con imprimir escribe las respuestas por stdout en el orden de las consultas.
+// el resumen (consultas por segundo y percentiles) sale por stderr. retorna 0 si todas
+// las consultas tuvieron respuesta
+int correrCliente(const std::string& ruta, const std::vector<std::string>& consultas, int conexiones, int profundidad, bool imprimir);
+
+#endif
@@ -0,0 +1,159 @@
+#include "ConstructorGrafo.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#include "Interseccion.h"
+
+// consultas que toma un hilo cada vez, para repartir parejo aunque unas cuesten mas
+#define CONSULTAS_POR_TANDA 64
+
+// el bit de signo invertido hace que el orden sin signo de la clave sea el de (origen, destino) como int
+static uint64_t empaquetarArista(int origen, int destino) {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(origen) ^ 0x80000000u) << 32)
+         | (static_cast<uint32_t>(destino) ^ 0x80000000u);
+}
+
+static int origenArista(uint64_t clave) {
+    return static_cast<int>(static_cast<uint32_t>(clave >> 32) ^ 0x80000000u);
+}
+
+static int destinoArista(uint64_t clave) {
+    return static_cast<int>(static_cast<uint32_t>(clave) ^ 0x80000000u);
+}
+
+// CONSTRUCTOR
+ConstructorGrafo::ConstructorGrafo(const InvertedIndex* idx, const ProcesadorDocumentos* procesador, int k, int hilos)
+    : index(idx), pd(procesador), topK(k), numHilos(hilos), aristasEmitidas(0), aristasDistintas(0) {}
+
+int ConstructorGrafo::construirDesdeLog(const std::string& archivoLog, Grafo& grafo, int limite) {
+    std::ifstream log(archivoLog);
+    if (!log.is_open()) {
+        std::cerr << "[ERROR] No se pudo abrir el archivo de consultas: " << archivoLog << std::endl;
+        return -1;
+    }
+    std::vector<std::string> consultas;
+    std::string linea;
+    while ((limite <= 0 || static_cast<int>(consultas.size()) < limite) && std::getline(log, linea)) {
+        if (!linea.empty()) {
+            consultas.push_back(linea);
+        }
+    }
+    construir(consultas, grafo);
+    return static_cast<int>(consultas.size());
+}
+
+void ConstructorGrafo::procesarConsultas(const std::vector<std::string>& consultas, size_t desde, size_t hasta,
+                                         std::vector<uint64_t>& buffer) const {
+    std::vector<const ListaPosteo*> listas;
+    for (size_t c = desde; c < hasta; ++c) {
+        std::vector<std::string> terminos = pd->getCleanWords(consultas[c]);
+        if (terminos.empty()) {
+            continue;
+        }
+        listas.clear();
+        for (const std::string& termino : terminos) {
+            listas.push_back(index->search(termino));
+        }
+        std::vector<int> docs = Interseccion::intersectar(listas);
+        size_t top = std::min(docs.size(), static_cast<size_t>(topK));
+        for (size_t i = 0; i < top; ++i) {
+            for (size_t j = i + 1; j < top; ++j) {
+                buffer.push_back(empaquetarArista(docs[i], docs[j]));
+                buffer.push_back(empaquetarArista(docs[j], docs[i]));
+            }
+        }
+    }
+}
+
+void ConstructorGrafo::construir(const std::vector<std::string>& consultas, Grafo& grafo) {
+    // 1) consultas en paralelo, cada hilo con su buffer
+    int hilos = numHilos > 0 ? numHilos : static_cast<int>(std::thread::hardware_concurrency());
+    size_t tandas = (consultas.size() + CONSULTAS_POR_TANDA - 1) / CONSULTAS_POR_TANDA;
+    hilos = static_cast<int>(std::max<size_t>(1, std::min(static_cast<size_t>(std::max(hilos, 1)), tandas)));
+
+    std::vector<std::vector<uint64_t>> buffers(hilos);
+    std::atomic<size_t> siguienteTanda(0);
+    auto trabajar = [&](int h) {
+        for (size_t tanda = siguienteTanda++; tanda < tandas; tanda = siguienteTanda++) {
+            size_t desde = tanda * CONSULTAS_POR_TANDA;
+            procesarConsultas(consultas, desde, std::min(desde + CONSULTAS_POR_TANDA, consultas.size()), buffers[h]);
+        }
+    };
+    if (hilos == 1) {
+        trabajar(0);
+    } else {
+        std::vector<std::thread> trabajadores;
+        for (int h = 0; h < hilos; ++h) {
+            trabajadores.emplace_back(trabajar, h);
+        }
+        for (std::thread& t : trabajadores) {
+            t.join();
+        }
+    }
+
+    // 2) juntar los buffers y ordenar
+    size_t total = 0;
+    for (const std::vector<uint64_t>& buffer : buffers) {
+        total += buffer.size();
+    }
+    std::vector<uint64_t> claves;
+    claves.reserve(total);
+    for (std::vector<uint64_t>& buffer : buffers) {
+        claves.insert(claves.end(), buffer.begin(), buffer.end());
+        std::vector<uint64_t>().swap(buffer);
+    }
+    ordenarRadix(claves);
+
+    // 3) sumar las repetidas: cada tramo de claves iguales es una arista con peso = largo
+    std::vector<AristaGrafo> aristas;
+    for (size_t i = 0; i < claves.size();) {
+        size_t fin = i + 1;
+        while (fin < claves.size() && claves[fin] == claves[i]) {
+            fin++;
+        }
+        aristas.push_back(AristaGrafo{origenArista(claves[i]), destinoArista(claves[i]), static_cast<int>(fin - i)});
+        i = fin;
+    }
+    aristasEmitidas = claves.size();
+    aristasDistintas = aristas.size();
+    std::vector<uint64_t>().swap(claves);
+
+    // 4) el grafo se llena en orden
+    grafo.agregarAristas(aristas);
+}
+
+void ConstructorGrafo::ordenarRadix(std::vector<uint64_t>& claves) {
+    if (claves.size() < 2) {
+        return;
+    }
+    // los 8 histogramas se cuentan en una sola pasada
+    std::vector<size_t> cuentas(8 * 256, 0);
+    for (uint64_t clave : claves) {
+        for (int b = 0; b < 8; ++b) {
+            cuentas[b * 256 + ((clave >> (8 * b)) & 0xFF)]++;
+        }
+    }
+
+    std::vector<uint64_t> auxiliar(claves.size());
+    for (int b = 0; b < 8; ++b) {
+        size_t* cuenta = &cuentas[b * 256];
+        // si todas las claves tienen el mismo byte esta pasada no mueve nada
+        if (cuenta[(claves[0] >> (8 * b)) & 0xFF] == claves.size()) {
+            continue;
+        }
+        size_t posicion = 0;
+        for (int d = 0; d < 256; ++d) {
+            size_t cantidad = cuenta[d];
+            cuenta[d] = posicion;
+            posicion += cantidad;
+        }
+        for (uint64_t clave : claves) {
+            auxiliar[cuenta[(clave >> (8 * b)) & 0xFF]++] = clave;
+        }
+        claves.swap(auxiliar);
+    }
+}
@@ -0,0 +1,50 @@
+#ifndef CONSTRUCTOR_GRAFO_H
+#define CONSTRUCTOR_GRAFO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Grafo.h"
+#include "InvertedIndex.h"
+#include "ProcesadorDocumentos.h"
+
+// arma el grafo de co-relevancia desde un log de consultas: cada consulta (AND y sin
+// pagerank, como Buscador::querySinPR) suma 1 a la arista de cada par de sus topK
+// primeros docs. las consultas se reparten entre hilos y cada hilo anota sus aristas,
+// en los dos sentidos y empaquetadas en un uint64, en su propio buffer. al final se
+// juntan, se ordenan con radix sort, las repetidas se suman en una pasada y el grafo se
+// llena ya en orden (ver Grafo::agregarAristas)
+class ConstructorGrafo {
+public:
+    // numHilos 0 = uno por nucleo
+    ConstructorGrafo(const InvertedIndex* index, const ProcesadorDocumentos* pd, int topK = 10, int numHilos = 0);
+
+    // las primeras limite consultas no vacias del log (0 = todas). retorna cuantas se
+    // procesaron o -1 si no se pudo abrir el archivo
+    int construirDesdeLog(const std::string& archivoLog, Grafo& grafo, int limite = 0);
+    void construir(const std::vector<std::string>& consultas, Grafo& grafo);
+
+    // de la ultima construccion: aristas anotadas (con repetidas, los dos sentidos) y
+    // aristas distintas que quedaron
+    size_t getAristasEmitidas() const { return aristasEmitidas; }
+    size_t getAristasDistintas() const { return aristasDistintas; }
+
+    // ordena claves de 64 bits de menor a mayor, de a 8 bits (LSD) y salteando los bytes
+    // que son iguales en todas las claves
+    static void ordenarRadix(std::vector<uint64_t>& claves);
+
+private:
+    const InvertedIndex* index;
+    const ProcesadorDocumentos* pd;
+    int topK;
+    int numHilos;
+    size_t aristasEmitidas;
+    size_t aristasDistintas;
+
+    // anota las aristas de consultas[desde, hasta) en buffer
+    void procesarConsultas(const std::vector<std::string>& consultas, size_t desde, size_t hasta, std::vector<uint64_t>& buffer) const;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#include "DiccionarioTerminos.h"
+
+#include <algorithm>
+
+// CONSTRUCTOR diccionario vacio, la tabla lee los terminos de este diccionario
+DiccionarioTerminos::DiccionarioTerminos() : indice(1024, HashOffset{this}, IgualOffset{this}) {}
+
+std::string_view DiccionarioTerminos::leerArena(uint32_t offset) const {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(arena.data()) + offset;
+    uint32_t largo = 0;
+    int desplazamiento = 0;
+    while (*p & 0x80) {
+        largo |= static_cast<uint32_t>(*p & 0x7F) << desplazamiento;
+        desplazamiento += 7;
+        p++;
+    }
+    largo |= static_cast<uint32_t>(*p) << desplazamiento;
+    return std::string_view(reinterpret_cast<const char*>(p + 1), largo);
+}
+
+uint32_t DiccionarioTerminos::buscar(std::string_view termino) const {
+    const uint32_t* id = indice.search(termino);
+    return id == nullptr ? NO_ENCONTRADO : *id;
+}
+
+uint32_t DiccionarioTerminos::agregar(std::string_view termino) {
+    const uint32_t* existente = indice.search(termino);
+    if (existente != nullptr) {
+        return *existente;
+    }
+    uint32_t id = static_cast<uint32_t>(inicios.size());
+    uint32_t offset = static_cast<uint32_t>(arena.size());
+    size_t largo = termino.size();
+    while (largo >= 0x80) {
+        arena.push_back(static_cast<char>(largo | 0x80));
+        largo >>= 7;
+    }
+    arena.push_back(static_cast<char>(largo));
+    arena.insert(arena.end(), termino.begin(), termino.end());
+    inicios.push_back(offset);
+    indice.insert(offset, id);
+    return id;
+}
+
+const std::vector<uint32_t>& DiccionarioTerminos::ordenados() const {
+    size_t yaOrdenados = orden.size();
+    if (yaOrdenados == inicios.size()) {
+        return orden;
+    }
+    auto porTermino = [this](uint32_t a, uint32_t b) { return getTermino(a) < getTermino(b); };
+    for (size_t id = yaOrdenados; id < inicios.size(); ++id) {
+        orden.push_back(static_cast<uint32_t>(id));
+    }
+    std::sort(orden.begin() + yaOrdenados, orden.end(), porTermino);
+    std::inplace_merge(orden.begin(), orden.begin() + yaOrdenados, orden.end(), porTermino);
+    return orden;
+}
+
+std::pair<size_t, size_t> DiccionarioTerminos::rangoPrefijo(std::string_view prefijo) const {
+    const std::vector<uint32_t>& ids = ordenados();
+    auto desde = std::lower_bound(ids.begin(), ids.end(), prefijo, [this](uint32_t id, std::string_view p) {
+        return getTermino(id) < p;
+    });
+    auto hasta = std::upper_bound(desde, ids.end(), prefijo, [this](std::string_view p, uint32_t id) {
+        return p < getTermino(id).substr(0, p.size());
+    });
+    return std::make_pair(static_cast<size_t>(desde - ids.begin()), static_cast<size_t>(hasta - ids.begin()));
+}
+
+// arena + offset por id + tabla hash (entrada y byte de control por slot) + orden
+size_t DiccionarioTerminos::bytesUsados() const {
+    return arena.capacity()
+         + inicios.capacity() * sizeof(uint32_t)
+         + static_cast<size_t>(indice.capacidad()) * (sizeof(HashEntry<uint32_t, uint32_t>) + 1)
+         + orden.capacity() * sizeof(uint32_t);
+}
+
+void DiccionarioTerminos::clear() {
+    arena.clear();
+    inicios.clear();
+    indice.clear();
+    orden.clear();
+}
@@ -0,0 +1,62 @@
+#ifndef DICCIONARIO_TERMINOS_H
+#define DICCIONARIO_TERMINOS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "HashTable.h"
+
+// vocabulario internado: cada termino se copia una sola vez a una arena contigua
+// (largo en varint + bytes) y recibe un id denso 0, 1, 2... en orden de llegada.
+// la tabla hash guarda solo el offset del termino en la arena y su id, el hash y la
+// comparacion leen el texto de la arena. el orden alfabetico se arma aparte y solo
+// cuando se pide. los string_view que retorna valen hasta el proximo agregar
+class DiccionarioTerminos {
+public:
+    static const uint32_t NO_ENCONTRADO = UINT32_MAX;
+
+    DiccionarioTerminos();
+    DiccionarioTerminos(const DiccionarioTerminos&) = delete;
+    DiccionarioTerminos& operator=(const DiccionarioTerminos&) = delete;
+
+    // id del termino o NO_ENCONTRADO
+    uint32_t buscar(std::string_view termino) const;
+    // id del termino, si no estaba se agrega con el siguiente id
+    uint32_t agregar(std::string_view termino);
+
+    std::string_view getTermino(uint32_t id) const { return leerArena(inicios[id]); }
+    uint32_t size() const { return static_cast<uint32_t>(inicios.size()); }
+
+    // ids ordenados alfabeticamente por termino. los terminos nuevos se ordenan y se
+    // mezclan con los que ya estaban, no se reordena todo
+    const std::vector<uint32_t>& ordenados() const;
+    // [desde, hasta) dentro de ordenados() con los terminos que empiezan con prefijo
+    std::pair<size_t, size_t> rangoPrefijo(std::string_view prefijo) const;
+
+    size_t bytesUsados() const;
+    void clear();
+
+private:
+    struct HashOffset {
+        const DiccionarioTerminos* diccionario;
+        size_t operator()(std::string_view termino) const { return HashPolicy<std::string>()(termino); }
+        size_t operator()(uint32_t offset) const { return (*this)(diccionario->leerArena(offset)); }
+    };
+    struct IgualOffset {
+        const DiccionarioTerminos* diccionario;
+        bool operator()(uint32_t offset, std::string_view termino) const { return diccionario->leerArena(offset) == termino; }
+        bool operator()(uint32_t offset, uint32_t otro) const { return offset == otro; }
+    };
+
+    std::vector<char> arena;
+    std::vector<uint32_t> inicios; // offset en la arena de cada id
+    HashTable<uint32_t, uint32_t, HashOffset, IgualOffset> indice; // offset -> id
+    mutable std::vector<uint32_t> orden;
+
+    std::string_view leerArena(uint32_t offset) const;
+};
+
+#endif
@@ -1,112 +1,96 @@
 #include "Grafo.h"
+#include "PageRankIncremental.h"
 
+#include <algorithm>
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <limits>
 #include <ostream>
-#include <cmath>
 
-Grafo::Grafo() : numAristas(0) {
+Grafo::Grafo() : indicePorDoc(1024), numAristas(0), numEntradas(0), incremental(nullptr) {
   // CONSTRUCTOR
 }
 
 Grafo::~Grafo() {
   // DESTRUCTOR
+    delete incremental;
 }
 
-std::map<int, double> Grafo::calcularPageRank( int num_interaciones, double damping_factor, double convergence_threshold) const {
-    std::map<int, double> pageRank;
-    std::map<int, double> anteriorPageRank;
+void Grafo::activarPageRankIncremental(double damping_factor, double epsilon) {
+    delete incremental;
+    incremental = new PageRankIncremental(*this, damping_factor, epsilon);
+    incremental->actualizar();
+}
 
-    if (Nodos.empty()) {
-    std::cout << "[PAGERANK] No hay nodos en el grafo para calcular PageRank" << std::endl;
-        return pageRank;
+long long Grafo::actualizarPageRankIncremental() {
+    if (incremental == nullptr) {
+        return 0;
     }
+    return incremental->actualizar();
+}
 
-    double pr_inicial = 1.0 / Nodos.size(); // popularidad
-    std::cout << "[PAGERANK DEBUG] Total de nodos: " << Nodos.size() << std::endl;
-
-    for (int nodo_id : Nodos) {
-        pageRank[nodo_id] = pr_inicial;
+std::map<int, double> Grafo::calcularPageRank(int num_interaciones, double damping_factor, double convergence_threshold,
+                                              int criterio, int numHilos) const {
+    if (idsNodos.empty()) {
+    std::cout << "[PAGERANK] No hay nodos en el grafo para calcular PageRank" << std::endl;
+        return std::map<int, double>();
     }
 
-    // calcular el peso de aristas salientes para cada nodo
-    std::map<int, double> salidaSumaPesada;
-    for (int nodo_id : Nodos) {
-        double sum = 0.0;
+    std::cout << "[PAGERANK DEBUG] Total de nodos: " << idsNodos.size() << std::endl;
 
-        // revisa si el nodo tiene vertices salientes
-        auto it = listaAdyacencia.find(nodo_id);
-        if (it != listaAdyacencia.end()) {
-                    for (const auto& edge_pair : it->second) {
-                sum += edge_pair.second;
-            }
-        }
-
-        salidaSumaPesada[nodo_id] = sum;
-    }
+    // 1) COMPACTAR EL GRAFO: indices densos y aristas de entrada de cada nodo en arreglos contiguos
+    GrafoCSR csr(*this);
 
   // 2) ITERACION DEL ALGORITMO PAGERANK
-    std::cout << "[PAGERANK] Calculando PageRank con " << Nodos.size() << " nodos..." << std::endl;
-    int iteracion_actual = 0;
+    std::cout << "[PAGERANK] Calculando PageRank con " << idsNodos.size() << " nodos..." << std::endl;
+    std::vector<double> pageRank;
     bool converge = false;
-
-    while (iteracion_actual < num_interaciones && !converge) {
-        anteriorPageRank = pageRank; // guarda los pr de la iteracion anterior
-        converge = true; // se asume convergencia hasta que se demuestre lo contrario
-        double sum_de_diff_pr = 0.0; // monitorea la convergencia
-
-    for (int nodo_j : Nodos) {
-        double sum_entrada_pr = 0.0;
-
-        // ahora hay que iterar todos los ndoos I que tienen una arista hacia J
-        // como el grafo no es dirijido, cuaklqueir nodo I que tenga a J en su
-        // lista de adyacencia es un enlazador a J
-        for (int nodo_i : Nodos) {
-            auto it_i_adj = listaAdyacencia.find(nodo_i);
-                if (it_i_adj != listaAdyacencia.end()) {
-                    auto it_arista_ij = it_i_adj->second.find(nodo_j);
-                    if (it_arista_ij !=
-                        it_i_adj->second.end()) { // revisa si exist e una arista de I a J
-                        double peso_ij = it_arista_ij->second;
-                        double salida_suma_i = salidaSumaPesada[nodo_i];
-
-                        // evitar q divida en 0 si un nodo no tiene enlaces salientes
-                        if (salida_suma_i > 0) {
-                            sum_entrada_pr +=
-                            anteriorPageRank[nodo_i] * (peso_ij / salida_suma_i);
-                        }
-                    }
-                }
-            }
-
-        // formula pagerank
-        pageRank[nodo_j] = (1.0 - damping_factor) + damping_factor * sum_entrada_pr;
-
-        // verificar convergencia
-        if (std::abs(pageRank[nodo_j] - anteriorPageRank[nodo_j]) > convergence_threshold) {
-                converge = false;
-        }
-        sum_de_diff_pr += std::abs(pageRank[nodo_j] - anteriorPageRank[nodo_j]);
-        }
-
-        iteracion_actual++;
-    }
+    int iteracion_actual = csr.calcularPageRank(pageRank, num_interaciones, damping_factor, convergence_threshold,
+                                                criterio, numHilos, &converge);
     std::cout << "[PAGERANK] Calculo Finalizado en " << iteracion_actual
             << " iteraciones. Convergencia: " << (converge ? "Si" : "No")
             << std::endl;
 
     // normaliza pagerank scores para asegurar que sumen 1
-    double total_pr_sum = 0.0;
-        for (const auto& pr_pair : pageRank) {
-            total_pr_sum += pr_pair.second;
-    }
+    return csr.aMapa(pageRank);
+}
 
-    if (total_pr_sum > 0) {
-        for (auto& pr_pair : pageRank) {
-            pr_pair.second /= total_pr_sum;
-        }
+uint32_t Grafo::obtenerIndice(int doc_id) {
+    const uint32_t* indice = indicePorDoc.search(doc_id);
+    if (indice != nullptr) {
+        return *indice;
     }
+    uint32_t nuevo = static_cast<uint32_t>(idsNodos.size());
+    indicePorDoc.insert(doc_id, nuevo);
+    idsNodos.push_back(doc_id);
+    vecinos.emplace_back();
+    return nuevo;
+}
 
-    return pageRank;
+int Grafo::getIndice(int doc_id) const {
+    const uint32_t* indice = indicePorDoc.search(doc_id);
+    return indice == nullptr ? -1 : static_cast<int>(*indice);
+}
+
+// busqueda binaria por doc id del vecino; lo comun (cargas en orden) es agregar al final
+void Grafo::sumarPeso(uint32_t desde, uint32_t hasta, float peso) {
+    std::vector<VecinoGrafo>& fila = vecinos[desde];
+    int docHasta = idsNodos[hasta];
+    if (fila.empty() || idsNodos[fila.back().indice] < docHasta) {
+        fila.push_back(VecinoGrafo{hasta, peso});
+        numEntradas++;
+        return;
+    }
+    auto it = std::lower_bound(fila.begin(), fila.end(), docHasta, [this](const VecinoGrafo& vecino, int doc) {
+        return idsNodos[vecino.indice] < doc;
+    });
+    if (it != fila.end() && it->indice == hasta) {
+        it->peso += peso;
+    } else {
+        fila.insert(it, VecinoGrafo{hasta, peso});
+        numEntradas++;
+    }
 }
 
 void Grafo::addVertice(int doc1_id, int doc2_id) {
@@ -114,29 +98,191 @@ void Grafo::addVertice(int doc1_id, int doc2_id) {
         return;
     }
 
-    Nodos.insert(doc1_id);
-    Nodos.insert(doc2_id);
+    uint32_t indice1 = obtenerIndice(doc1_id);
+    uint32_t indice2 = obtenerIndice(doc2_id);
+    sumarPeso(indice1, indice2, 1.0f);
+    sumarPeso(indice2, indice1, 1.0f);
 
-    listaAdyacencia[doc1_id][doc2_id]++;
-    listaAdyacencia[doc2_id][doc1_id]++;
+    if (incremental != nullptr) {
+        incremental->agregarArista(doc1_id, doc2_id);
+    }
 
     numAristas++;
-  // std::cout << "Vertice incrementado entre " << doc1_id << " y " << doc2_id
-  // << std::endl;
 }
 
-int Grafo::getNumNodes() const {
-    return Nodos.size();
-}
+// como vienen ordenadas, los nodos nuevos reciben indices en orden de doc id y cada
+// vecino va al final de su arreglo, que se reserva justo con lo que le toca
+void Grafo::agregarAristas(const std::vector<AristaGrafo>& aristas) {
+    if (incremental != nullptr) {
+        // el PageRank incremental tiene que ver cada arista por separado
+        for (const AristaGrafo& arista : aristas) {
+            for (int i = 0; arista.origen < arista.destino && i < arista.peso; ++i) {
+                addVertice(arista.origen, arista.destino);
+            }
+        }
+        return;
+    }
 
-const std::map<int, std::map<int, double>>& Grafo::getListaAdyacencia() const {
-    return listaAdyacencia;
+    // cada destino tambien aparece como origen (vienen los dos sentidos), asi que alcanza
+    // con darle indice a los origenes antes de llenar
+    for (size_t i = 0; i < aristas.size(); ++i) {
+        if (i == 0 || aristas[i].origen != aristas[i - 1].origen) {
+            obtenerIndice(aristas[i].origen);
+        }
+    }
+
+    long long pesoTotal = 0;
+    for (size_t i = 0; i < aristas.size();) {
+        size_t fin = i + 1;
+        while (fin < aristas.size() && aristas[fin].origen == aristas[i].origen) {
+            fin++;
+        }
+        uint32_t origen = *indicePorDoc.search(aristas[i].origen);
+        vecinos[origen].reserve(vecinos[origen].size() + (fin - i));
+        for (; i < fin; ++i) {
+            if (aristas[i].origen != aristas[i].destino) {
+                sumarPeso(origen, obtenerIndice(aristas[i].destino), static_cast<float>(aristas[i].peso));
+                pesoTotal += aristas[i].peso;
+            }
+        }
+    }
+    numAristas += static_cast<int>(pesoTotal / 2); // cada par viene en los dos sentidos
 }
 
-const std::set<int>& Grafo::getNodos() const {
-    return Nodos;
+int Grafo::getNumNodes() const {
+    return static_cast<int>(idsNodos.size());
 }
 
 int Grafo::getNumAristas() const {
     return numAristas;
-}
\ No newline at end of file
+}
+
+long long Grafo::getNumAristasDistintas() const {
+    return numEntradas / 2;
+}
+
+std::vector<uint32_t> Grafo::indicesPorDocId() const {
+    std::vector<uint32_t> indices(idsNodos.size());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        indices[i] = static_cast<uint32_t>(i);
+    }
+    std::sort(indices.begin(), indices.end(), [this](uint32_t a, uint32_t b) { return idsNodos[a] < idsNodos[b]; });
+    return indices;
+}
+
+// tabla hash (entrada y byte de control por slot) + doc ids + arreglos de vecinos
+size_t Grafo::bytesUsados() const {
+    size_t bytes = static_cast<size_t>(indicePorDoc.capacidad()) * (sizeof(HashEntry<int, uint32_t>) + 1)
+                 + idsNodos.capacity() * sizeof(int)
+                 + vecinos.capacity() * sizeof(std::vector<VecinoGrafo>);
+    for (const std::vector<VecinoGrafo>& fila : vecinos) {
+        bytes += fila.capacity() * sizeof(VecinoGrafo);
+    }
+    return bytes;
+}
+
+bool Grafo::guardar(const std::string& archivo, uint64_t huellaOrigen) const {
+    std::ofstream out(archivo, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error al crear el archivo del grafo: " << archivo << std::endl;
+        return false;
+    }
+    CabeceraGrafo cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.magic, GRAFO_MAGIC, sizeof(cabecera.magic));
+    cabecera.version = GRAFO_VERSION;
+    cabecera.numNodos = static_cast<uint32_t>(idsNodos.size());
+    cabecera.numEntradas = static_cast<uint64_t>(numEntradas);
+    cabecera.numAristas = numAristas;
+    cabecera.huellaOrigen = huellaOrigen;
+    out.write(reinterpret_cast<const char*>(&cabecera), sizeof(cabecera));
+
+    out.write(reinterpret_cast<const char*>(idsNodos.data()), idsNodos.size() * sizeof(int32_t));
+    for (const std::vector<VecinoGrafo>& fila : vecinos) {
+        uint32_t grado = static_cast<uint32_t>(fila.size());
+        out.write(reinterpret_cast<const char*>(&grado), sizeof(grado));
+    }
+    for (const std::vector<VecinoGrafo>& fila : vecinos) {
+        out.write(reinterpret_cast<const char*>(fila.data()), fila.size() * sizeof(VecinoGrafo));
+    }
+    return static_cast<bool>(out);
+}
+
+// todo se valida antes de tocar el grafo: los tamanios contra el largo del archivo (antes de
+// reservar nada), doc ids sin repetir y cada fila ordenada por doc id del vecino sin repetidos,
+// que es lo que supone la busqueda binaria de sumarPeso
+bool Grafo::cargar(const std::string& archivo, uint64_t huellaOrigen) {
+    if (incremental != nullptr) {
+        return false;
+    }
+    std::ifstream in(archivo, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) {
+        std::cerr << "No se pudo abrir el archivo del grafo: " << archivo << std::endl;
+        return false;
+    }
+    uint64_t tamanio = static_cast<uint64_t>(in.tellg());
+    in.seekg(0);
+    CabeceraGrafo cabecera;
+    if (tamanio < sizeof(cabecera) || !in.read(reinterpret_cast<char*>(&cabecera), sizeof(cabecera))
+        || std::memcmp(cabecera.magic, GRAFO_MAGIC, sizeof(cabecera.magic)) != 0 || cabecera.version != GRAFO_VERSION) {
+        std::cerr << "El archivo no es un grafo valido (o es de otra version): " << archivo << std::endl;
+        return false;
+    }
+    if (cabecera.huellaOrigen != huellaOrigen) {
+        std::cerr << "El grafo " << archivo << " se armo con otros archivos o parametros" << std::endl;
+        return false;
+    }
+    uint64_t resto = tamanio - sizeof(cabecera);
+    uint64_t bytesNodos = static_cast<uint64_t>(cabecera.numNodos) * (sizeof(int32_t) + sizeof(uint32_t));
+    if (bytesNodos > resto || cabecera.numEntradas != (resto - bytesNodos) / sizeof(VecinoGrafo)
+        || (resto - bytesNodos) % sizeof(VecinoGrafo) != 0
+        || cabecera.numAristas < 0 || cabecera.numAristas > std::numeric_limits<int>::max()) {
+        std::cerr << "El tamanio del archivo del grafo no coincide con su cabecera: " << archivo << std::endl;
+        return false;
+    }
+
+    std::vector<int> ids(cabecera.numNodos);
+    std::vector<uint32_t> grados(cabecera.numNodos);
+    in.read(reinterpret_cast<char*>(ids.data()), ids.size() * sizeof(int32_t));
+    in.read(reinterpret_cast<char*>(grados.data()), grados.size() * sizeof(uint32_t));
+    uint64_t totalGrados = 0;
+    for (uint32_t grado : grados) {
+        totalGrados += grado;
+    }
+    if (!in || totalGrados != cabecera.numEntradas) {
+        std::cerr << "El archivo del grafo esta incompleto: " << archivo << std::endl;
+        return false;
+    }
+    std::vector<int> ordenados(ids);
+    std::sort(ordenados.begin(), ordenados.end());
+    if (std::adjacent_find(ordenados.begin(), ordenados.end()) != ordenados.end()) {
+        std::cerr << "El archivo del grafo tiene doc ids repetidos: " << archivo << std::endl;
+        return false;
+    }
+
+    std::vector<std::vector<VecinoGrafo>> filas(cabecera.numNodos);
+    bool valido = true;
+    for (uint32_t i = 0; i < cabecera.numNodos && valido; ++i) {
+        filas[i].resize(grados[i]);
+        valido = static_cast<bool>(in.read(reinterpret_cast<char*>(filas[i].data()), grados[i] * sizeof(VecinoGrafo)));
+        for (size_t j = 0; j < filas[i].size() && valido; ++j) {
+            uint32_t indice = filas[i][j].indice;
+            valido = indice < cabecera.numNodos && indice != i
+                  && (j == 0 || ids[filas[i][j - 1].indice] < ids[indice]);
+        }
+    }
+    if (!valido) {
+        std::cerr << "El archivo del grafo esta incompleto o tiene vecinos invalidos: " << archivo << std::endl;
+        return false;
+    }
+
+    indicePorDoc.clear();
+    for (uint32_t i = 0; i < cabecera.numNodos; ++i) {
+        indicePorDoc.insert(ids[i], i);
+    }
+    idsNodos.swap(ids);
+    vecinos.swap(filas);
+    numEntradas = static_cast<long long>(cabecera.numEntradas);
+    numAristas = static_cast<int>(cabecera.numAristas);
+    return true;
+}
@@ -1,29 +1,104 @@
 #ifndef GRAFO_H
 #define GRAFO_H
 
+#include <cstddef>
+#include <cstdint>
 #include <map>
-#include <set>
+#include <string>
 #include <vector>
 
+#include "GrafoCSR.h"
+#include "HashTable.h"
+#include "PageRankIncremental.h"
+
+// arista con su peso (cantidad de veces que se agrego), para cargar muchas de una vez
+struct AristaGrafo {
+    int origen;
+    int destino;
+    int peso;
+};
+
+// vecino de un nodo: indice denso del otro extremo y peso de la arista
+struct VecinoGrafo {
+    uint32_t indice;
+    float peso;
+};
+
+#define GRAFO_MAGIC "P3GRAFv"
+#define GRAFO_VERSION 2
+
+// archivo binario del grafo (orden de bytes de la maquina):
+//   CabeceraGrafo
+//   int32 doc id de cada nodo, por indice denso
+//   uint32 cantidad de vecinos de cada nodo
+//   VecinoGrafo[numEntradas] los vecinos de cada nodo, un nodo despues de otro
+struct CabeceraGrafo {
+    char magic[8];
+    uint32_t version;
+    uint32_t numNodos;
+    uint64_t numEntradas; // vecinos en total, cada arista cuenta dos veces
+    int64_t numAristas;
+    uint64_t huellaOrigen; // la del snapshot que acompania (ver SnapshotIndice::huellaOrigen), 0 = ninguna
+};
+
+// grafo no dirigido con pesos. cada doc id recibe un indice denso 0..N-1 en orden de
+// llegada (tabla hash doc id -> indice y arreglo indice -> doc id) y cada nodo tiene un
+// arreglo de vecinos ordenado por doc id del vecino. el peso va en float: las aristas
+// suman de a 1 y float es exacto hasta 2^24. son 8 bytes por sentido de arista (mas el
+// sobrante de cada arreglo) contra los ~64 de un nodo de std::map<int, double>
 class Grafo {
 public:
     Grafo();
     ~Grafo();
 
+    Grafo(const Grafo&) = delete;
+    Grafo& operator=(const Grafo&) = delete;
+
     void addVertice(int doc1_id, int doc2_id);
+    // aristas ordenadas por (origen, destino) y con los dos sentidos de cada par, como las
+    // deja ConstructorGrafo. equivale a addVertice peso veces por cada par
+    void agregarAristas(const std::vector<AristaGrafo>& aristas);
     int getNumNodes() const;
+    // veces que se agrego una arista (con repetidas)
     int getNumAristas() const;
+    // pares de nodos distintos con arista
+    long long getNumAristasDistintas() const;
 
-    const std::map<int, std::map<int,double>>& getListaAdyacencia() const;
+    int getDocId(uint32_t indice) const { return idsNodos[indice]; }
+    // indice denso del doc o -1 si no esta en el grafo
+    int getIndice(int doc_id) const;
+    const std::vector<VecinoGrafo>& getVecinos(uint32_t indice) const { return vecinos[indice]; }
+    // indices densos ordenados por doc id, para recorrer el grafo en el orden de los docs
+    std::vector<uint32_t> indicesPorDocId() const;
 
-    const std::set<int>& getNodos() const;
+    // memoria de la tabla, los doc ids y los arreglos de vecinos
+    size_t bytesUsados() const;
+    bool guardar(const std::string& archivo, uint64_t huellaOrigen = 0) const;
+    // reemplaza el grafo por el del archivo (no con el PageRank incremental activo). si el
+    // archivo no es valido o tiene otra huella devuelve false y el grafo queda como estaba
+    bool cargar(const std::string& archivo, uint64_t huellaOrigen = 0);
 
-    std::map<int, double> calcularPageRank(int num_iteraciones = 50, double damping_factor = 0.85, double limite_convergencia = 1e-6) const;
+    // compacta el grafo en CSR y calcula PageRank en paralelo por filas (numHilos 0 = uno por nucleo)
+    std::map<int, double> calcularPageRank(int num_iteraciones = 50, double damping_factor = 0.85, double limite_convergencia = 1e-6,
+                                           int criterio = CONVERGENCIA_MAXIMA, int numHilos = 0) const;
+
+    // modo incremental: desde que se activa, cada addVertice corrige los residuos de los
+    // nodos afectados y actualizarPageRankIncremental() los propaga solo por esa zona
+    void activarPageRankIncremental(double damping_factor = 0.85, double epsilon = EPSILON_PAGERANK_INCREMENTAL);
+    long long actualizarPageRankIncremental();
+    const PageRankIncremental* getPageRankIncremental() const { return incremental; }
 
 private:
-    std::map<int, std::map<int, double>> listaAdyacencia;
-    std::set<int> Nodos;
+    HashTable<int, uint32_t> indicePorDoc;
+    std::vector<int> idsNodos;
+    std::vector<std::vector<VecinoGrafo>> vecinos;
     int numAristas;
+    long long numEntradas; // largo total de los arreglos de vecinos
+    PageRankIncremental* incremental;
+
+    uint32_t obtenerIndice(int doc_id);
+    // suma peso a la arista desde -> hasta (la crea en su lugar si no estaba)
+    void sumarPeso(uint32_t desde, uint32_t hasta, float peso);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "GrafoCSR.h"
+#include "Grafo.h"
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// filas minimas por hilo, con menos no vale la pena lanzar hilos en cada iteracion
+#ifndef FILAS_MINIMAS_POR_HILO
+#define FILAS_MINIMAS_POR_HILO 4096
+#endif
+
+GrafoCSR::GrafoCSR(const Grafo& grafo) {
+    // las filas van en orden de doc id; filaDe pasa del indice del grafo a la fila
+    std::vector<uint32_t> orden = grafo.indicesPorDocId();
+    int n = static_cast<int>(orden.size());
+    idsNodos.resize(n);
+    std::vector<uint32_t> filaDe(n);
+    for (int j = 0; j < n; ++j) {
+        idsNodos[j] = grafo.getDocId(orden[j]);
+        filaDe[orden[j]] = static_cast<uint32_t>(j);
+    }
+
+    // 1) contar las aristas que entran a cada fila
+    offsets.assign(n + 1, 0);
+    for (int j = 0; j < n; ++j) {
+        for (const VecinoGrafo& vecino : grafo.getVecinos(orden[j])) {
+            offsets[filaDe[vecino.indice] + 1]++;
+        }
+    }
+    for (int j = 0; j < n; ++j) {
+        offsets[j + 1] += offsets[j];
+    }
+
+    // 2) llenar las filas; como los origenes se recorren en orden de doc id, cada fila queda
+    //    ordenada igual que el recorrido de Grafo::calcularPageRank (misma suma, mismo redondeo)
+    vecinos.resize(offsets[n]);
+    pesos.resize(offsets[n]);
+    std::vector<uint32_t> siguiente(offsets.begin(), offsets.end() - 1);
+    for (int j = 0; j < n; ++j) {
+        const std::vector<VecinoGrafo>& aristas = grafo.getVecinos(orden[j]);
+        double salidaSuma = 0.0;
+        for (const VecinoGrafo& vecino : aristas) {
+            salidaSuma += vecino.peso;
+        }
+        for (const VecinoGrafo& vecino : aristas) {
+            uint32_t posicion = siguiente[filaDe[vecino.indice]]++;
+            vecinos[posicion] = static_cast<uint32_t>(j);
+            // un nodo sin peso de salida no reparte nada
+            pesos[posicion] = salidaSuma > 0 ? vecino.peso / salidaSuma : 0.0;
+        }
+    }
+}
+
+std::vector<int> GrafoCSR::repartirFilas(int partes) const {
+    int n = getNumNodos();
+    std::vector<int> cortes(1, 0);
+    size_t totalTrabajo = vecinos.size() + n; // cada fila cuesta sus aristas + 1
+    for (int p = 1; p < partes; ++p) {
+        size_t objetivo = totalTrabajo * p / partes;
+        // primera fila j con offsets[j] + j >= objetivo
+        int bajo = cortes.back();
+        int alto = n;
+        while (bajo < alto) {
+            int medio = bajo + (alto - bajo) / 2;
+            if (offsets[medio] + static_cast<size_t>(medio) < objetivo) {
+                bajo = medio + 1;
+            } else {
+                alto = medio;
+            }
+        }
+        cortes.push_back(bajo);
+    }
+    cortes.push_back(n);
+    return cortes;
+}
+
+int GrafoCSR::calcularPageRank(std::vector<double>& pageRank, int num_iteraciones, double damping_factor,
+                               double limite_convergencia, int criterio, int numHilos, bool* convergio) const {
+    int n = getNumNodos();
+    pageRank.assign(n, n > 0 ? 1.0 / n : 0.0);
+    if (convergio != nullptr) {
+        *convergio = false;
+    }
+    if (n == 0) {
+        return 0;
+    }
+
+    if (numHilos <= 0) {
+        numHilos = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    numHilos = std::max(1, std::min(numHilos, n / FILAS_MINIMAS_POR_HILO));
+    std::vector<int> cortes = repartirFilas(numHilos);
+
+    std::vector<double> anterior(n);
+    std::vector<double> maxDiferencia(numHilos);
+    std::vector<double> sumaDiferencias(numHilos);
+
+    // cada hilo calcula sus filas leyendo solo "anterior", no hace falta sincronizar
+    auto calcularFilas = [&](int parte) {
+        double maxLocal = 0.0;
+        double sumaLocal = 0.0;
+        for (int j = cortes[parte]; j < cortes[parte + 1]; ++j) {
+            double sum_entrada_pr = 0.0;
+            for (uint32_t e = offsets[j]; e < offsets[j + 1]; ++e) {
+                sum_entrada_pr += anterior[vecinos[e]] * pesos[e];
+            }
+            double nuevo = (1.0 - damping_factor) + damping_factor * sum_entrada_pr;
+            double diferencia = std::abs(nuevo - anterior[j]);
+            maxLocal = std::max(maxLocal, diferencia);
+            sumaLocal += diferencia;
+            pageRank[j] = nuevo;
+        }
+        maxDiferencia[parte] = maxLocal;
+        sumaDiferencias[parte] = sumaLocal;
+    };
+
+    int iteracion_actual = 0;
+    bool converge = false;
+    std::vector<std::thread> hilos;
+    while (iteracion_actual < num_iteraciones && !converge) {
+        anterior.swap(pageRank);
+
+        hilos.clear();
+        for (int parte = 1; parte < numHilos; ++parte) {
+            hilos.emplace_back(calcularFilas, parte);
+        }
+        calcularFilas(0);
+        for (std::thread& hilo : hilos) {
+            hilo.join();
+        }
+
+        double maximo = 0.0;
+        double suma = 0.0;
+        for (int parte = 0; parte < numHilos; ++parte) {
+            maximo = std::max(maximo, maxDiferencia[parte]);
+            suma += sumaDiferencias[parte];
+        }
+        converge = (criterio == CONVERGENCIA_L1 ? suma : maximo) <= limite_convergencia;
+        iteracion_actual++;
+    }
+
+    if (convergio != nullptr) {
+        *convergio = converge;
+    }
+    return iteracion_actual;
+}
+
+void GrafoCSR::calcularResiduo(const std::vector<double>& pageRank, double damping_factor, std::vector<double>& residuo) const {
+    int n = getNumNodos();
+    residuo.assign(n, 0.0);
+    for (int j = 0; j < n; ++j) {
+        double sum_entrada_pr = 0.0;
+        for (uint32_t e = offsets[j]; e < offsets[j + 1]; ++e) {
+            sum_entrada_pr += pageRank[vecinos[e]] * pesos[e];
+        }
+        residuo[j] = (1.0 - damping_factor) + damping_factor * sum_entrada_pr - pageRank[j];
+    }
+}
+
+std::map<int, double> GrafoCSR::aMapa(const std::vector<double>& pageRank) const {
+    double total_pr_sum = 0.0;
+    for (double score : pageRank) {
+        total_pr_sum += score;
+    }
+
+    std::map<int, double> scores;
+    for (int j = 0; j < getNumNodos(); ++j) {
+        double score = pageRank[j];
+        if (total_pr_sum > 0) {
+            score /= total_pr_sum;
+        }
+        scores.emplace_hint(scores.end(), idsNodos[j], score);
+    }
+    return scores;
+}
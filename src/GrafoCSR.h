@@ -0,0 +1,50 @@
+#ifndef GRAFO_CSR_H
+#define GRAFO_CSR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+class Grafo;
+
+// criterios de convergencia de PageRank
+#define CONVERGENCIA_MAXIMA 0 // todos los nodos cambian menos que el limite (el de siempre)
+#define CONVERGENCIA_L1 1     // la suma de los cambios es menor que el limite
+
+// el grafo compactado en CSR (compressed sparse row) para PageRank: los doc ids se
+// pasan a indices densos 0..N-1 y cada fila j tiene las aristas que ENTRAN a j, con el
+// peso ya dividido por la salida del origen. asi una iteracion es un SpMV de "pull"
+// (cada fila solo escribe su propio score) y se puede repartir por filas entre hilos
+class GrafoCSR {
+public:
+    explicit GrafoCSR(const Grafo& grafo);
+
+    int getNumNodos() const { return static_cast<int>(idsNodos.size()); }
+    size_t getNumEntradas() const { return vecinos.size(); }
+    int getDocId(int indice) const { return idsNodos[indice]; }
+    const std::vector<int>& getIdsNodos() const { return idsNodos; }
+
+    // misma formula que Grafo::calcularPageRank: pr_j = (1-d) + d * sum(pr_i * w_ij / salida_i)
+    // con iteraciones de Jacobi, sin normalizar. retorna la cantidad de iteraciones hechas
+    int calcularPageRank(std::vector<double>& pageRank, int num_iteraciones, double damping_factor,
+                         double limite_convergencia, int criterio = CONVERGENCIA_MAXIMA,
+                         int numHilos = 0, bool* convergio = nullptr) const;
+
+    // r = (1-d) + d*P*x - x, lo que le falta a x para ser el punto fijo (PageRank incremental)
+    void calcularResiduo(const std::vector<double>& pageRank, double damping_factor, std::vector<double>& residuo) const;
+
+    // scores normalizados (suman 1) por doc id
+    std::map<int, double> aMapa(const std::vector<double>& pageRank) const;
+
+private:
+    std::vector<int> idsNodos;       // indice denso -> doc id (ordenado)
+    std::vector<uint32_t> offsets;   // fila j: entradas [offsets[j], offsets[j+1])
+    std::vector<uint32_t> vecinos;   // indice denso del origen de cada arista
+    std::vector<double> pesos;       // w_ij / salida_i
+
+    // reparte las filas en rangos con mas o menos la misma cantidad de aristas
+    std::vector<int> repartirFilas(int partes) const;
+};
+
+#endif
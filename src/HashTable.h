@@ -1,41 +1,94 @@
 #ifndef HASH_TABLE_H
 #define HASH_TABLE_H
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <string>
-#include <vector>
+#include <string_view>
+#include <utility>
+
+// politica de hash: cualquier tipo con std::hash, con el resultado mezclado porque
+// std::hash de enteros suele ser la identidad y la tabla usa los bits altos y bajos
+template<typename K>
+struct HashPolicy {
+    size_t operator()(const K& key) const;
+};
+
+// strings: hash de a 8 bytes, acepta std::string_view para buscar sin crear
+// un std::string temporal
+template<>
+struct HashPolicy<std::string> {
+    size_t operator()(std::string_view key) const;
+};
 
 template<typename K, typename V>
 struct HashEntry {
     K key;
     V value;
-    bool ocupado;
-    bool borrado;
 
-    HashEntry();
-    HashEntry(const K& k, const V& v);
+    template<typename KK, typename VV>
+    HashEntry(KK&& k, VV&& v) : key(std::forward<KK>(k)), value(std::forward<VV>(v)) {}
 };
 
-template<typename K, typename V>
+// tabla hash de direccionamiento abierto al estilo SwissTable: ademas de las entradas
+// hay un arreglo de bytes de control, uno por slot, con 7 bits del hash (o vacio/borrado).
+// los slots se recorren por grupos de 16 y con SSE2 se comparan los 16 bytes de control
+// de un grupo a la vez, asi solo se comparan claves cuando coinciden los 7 bits.
+// la carga maxima es 7/8; al borrar, si el grupo todavia tiene un slot vacio ninguna
+// busqueda paso de largo por ahi y el slot vuelve a quedar vacio en vez de borrado.
+// los borrados que quedan se limpian en el rehash (que mueve las entradas, no las copia).
+// H y E pueden tener estado (por ejemplo claves que son offsets en otra estructura)
+template<typename K, typename V, typename H = HashPolicy<K>, typename E = std::equal_to<>>
 class HashTable {
-private:
-    std::vector<HashEntry<K, V>> table;
-    int tableSize;
-    int actualSize;
-
-    int hash(const std::string& key) const;
-    void rehash();
-
 public:
-    HashTable(int size = 53);
+    static const int TAMANIO_GRUPO = 16;
+
+    HashTable(int size = 53, const H& funcionHash = H(), const E& funcionIgual = E());
+    ~HashTable();
+    HashTable(const HashTable&) = delete;
+    HashTable& operator=(const HashTable&) = delete;
 
     void insert(const K& key, const V& value);
-    V* search(const K& key);
-    bool remove(const K& key);
+    void insert(K&& key, V&& value);
+    // Q puede ser K o cualquier tipo que H sepa hashear y se pueda comparar con K
+    // (por ejemplo std::string_view con claves std::string)
+    template<typename Q>
+    V* search(const Q& key);
+    template<typename Q>
+    const V* search(const Q& key) const;
+    template<typename Q>
+    bool remove(const Q& key);
+    void clear();
 
     int size() const;
     bool empty() const;
+    int capacidad() const { return static_cast<int>(numSlots); }
+
+private:
+    static const int8_t VACIO = -128;  // 0b10000000
+    static const int8_t BORRADO = -2;  // 0b11111110
+    // los slots llenos guardan 7 bits del hash (0..127), los libres tienen el bit alto prendido
+
+    int8_t* control;
+    HashEntry<K, V>* slots; // memoria sin construir, solo los slots llenos tienen objeto
+    size_t numSlots;        // potencia de 2, multiplo de TAMANIO_GRUPO
+    int actualSize;
+    size_t crecimientoRestante; // inserciones en slots vacios antes del proximo rehash
+    H hasher;
+    E igual;
+
+    void reservar(size_t slotsNuevos);
+    void liberar();
+    void rehash();
+    size_t maxOcupados() const { return numSlots - numSlots / 8; }
+    template<typename Q>
+    size_t buscarSlot(const Q& key, size_t h) const; // numSlots si no esta
+    size_t slotLibre(size_t h) const;
+    template<typename KK, typename VV>
+    void insertar(KK&& key, VV&& value);
 };
 
 #include "./HashTable.tpp"
 
-#endif
\ No newline at end of file
+#endif
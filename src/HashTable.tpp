@@ -1,110 +1,290 @@
-// CONSTRUCTOR POR DEFECTO
-template<typename K, typename V>
-HashEntry<K, V>::HashEntry() : ocupado(false), borrado(false) {}
+#include <cstring>
+#include <new>
 
-// CONSTRUCTOR CON CLAVE VALOR
-template<typename K, typename V>
-HashEntry<K, V>::HashEntry(const K& k, const V& v) : key(k), value(v), ocupado(true), borrado(false) {}
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define HASH_TABLE_SSE2 1
+#endif
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
-// CONSTRUCOTR que inicializa la tabla con el tamanio dado y poen el contador de elementos en 0
-template<typename K, typename V>
-HashTable<K, V>::HashTable(int size) : tableSize(size), actualSize(0) {
-    table.resize(tableSize);
+namespace hashtable_detalle {
+
+// mezcla final de murmur3, reparte los bits de la entrada en todo el resultado
+inline size_t mezclar(uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+inline int primerBit(uint32_t mascara) {
+#if defined(_MSC_VER)
+    unsigned long indice;
+    _BitScanForward(&indice, mascara);
+    return static_cast<int>(indice);
+#else
+    return __builtin_ctz(mascara);
+#endif
 }
 
-// Funcion hash para clabes string usando algoritmo djb2
-template<typename K, typename V>
-int HashTable<K, V>::hash(const std::string& key) const {
-    unsigned long hash = 5381;
-    for (char c : key) {
-        hash = ((hash << 5) + hash) + c;
+// bit i prendido si el byte de control i del grupo es igual a valor
+inline uint32_t coincidencias(const int8_t* grupo, int8_t valor) {
+#if defined(HASH_TABLE_SSE2)
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(grupo));
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(valor))));
+#else
+    uint32_t mascara = 0;
+    for (int i = 0; i < 16; ++i) {
+        mascara |= static_cast<uint32_t>(grupo[i] == valor) << i;
     }
-    return hash % tableSize;
+    return mascara;
+#endif
 }
 
-// rehash duplica el tamanio de la tabla y re-inserta las entradas validas
-template<typename K, typename V>
-void HashTable<K, V>::rehash() {
-    std::vector<HashEntry<K, V>> oldTable = table;
-    tableSize *= 2;
-    table.clear();
-    table.resize(tableSize);
-    actualSize = 0;
+// bit i prendido si el slot i esta vacio o borrado (bit alto del byte de control)
+inline uint32_t libres(const int8_t* grupo) {
+#if defined(HASH_TABLE_SSE2)
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(grupo))));
+#else
+    uint32_t mascara = 0;
+    for (int i = 0; i < 16; ++i) {
+        mascara |= static_cast<uint32_t>(grupo[i] < 0) << i;
+    }
+    return mascara;
+#endif
+}
 
-    // auto toma cualquier valor que tenga oldtable en entry
-    // reincerta todas las entradas que estan ocupadas y no eliminadas
-    for (const auto& entry : oldTable) {
-        if (entry.ocupado && !entry.borrado) {
-            insert(entry.key, entry.value);
-        }
+} // namespace hashtable_detalle
+
+template<typename K>
+size_t HashPolicy<K>::operator()(const K& key) const {
+    return hashtable_detalle::mezclar(static_cast<uint64_t>(std::hash<K>{}(key)));
+}
+
+// de a 8 bytes por vez (multiplicar y plegar), la mezcla final reparte los bits
+inline size_t HashPolicy<std::string>::operator()(std::string_view key) const {
+    uint64_t hash = 0x9E3779B97F4A7C15ULL ^ key.size();
+    const char* p = key.data();
+    size_t restantes = key.size();
+    while (restantes >= 8) {
+        uint64_t palabra;
+        std::memcpy(&palabra, p, 8);
+        hash = (hash ^ palabra) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+        p += 8;
+        restantes -= 8;
     }
+    if (restantes > 0) {
+        uint64_t palabra = 0;
+        std::memcpy(&palabra, p, restantes);
+        hash = (hash ^ palabra) * 0x9E3779B97F4A7C15ULL;
+        hash ^= hash >> 32;
+    }
+    return hashtable_detalle::mezclar(hash);
 }
 
-// interta una clave-valor a la table hash
-template<typename K, typename V>
-void HashTable<K, V>::insert(const K& key, const V& value) {
-    // si la tabla se llena al 70 por cieot, realiza un rehash para evitar que colisione
-    if (actualSize >= tableSize * 0.7) {
-        rehash();
+// CONSTRUCTOR: reserva lugar para size elementos sin pasar la carga maxima
+template<typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::HashTable(int size, const H& funcionHash, const E& funcionIgual)
+    : control(nullptr), slots(nullptr), numSlots(0), actualSize(0), crecimientoRestante(0), hasher(funcionHash), igual(funcionIgual) {
+    size_t necesarios = size > 0 ? static_cast<size_t>(size) * 8 / 7 + 1 : 0;
+    size_t slotsIniciales = TAMANIO_GRUPO;
+    while (slotsIniciales < necesarios) {
+        slotsIniciales *= 2;
     }
+    reservar(slotsIniciales);
+}
 
-    int index = hash(key);
-    int originalIndex = index;
+template<typename K, typename V, typename H, typename E>
+HashTable<K, V, H, E>::~HashTable() {
+    liberar();
+}
 
-    // buasca una posicion libre o la posicion clave para que se actualize
-    while (table[index].ocupado && !table[index].borrado && table[index].key != key) {
-        index = (index + 1) % tableSize;
-        if (index == originalIndex) break;
+// arreglos nuevos con todos los slots vacios
+template<typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::reservar(size_t slotsNuevos) {
+    numSlots = slotsNuevos;
+    control = new int8_t[numSlots];
+    for (size_t i = 0; i < numSlots; ++i) {
+        control[i] = VACIO;
     }
+    slots = static_cast<HashEntry<K, V>*>(::operator new(numSlots * sizeof(HashEntry<K, V>)));
+    crecimientoRestante = maxOcupados() - actualSize;
+}
 
-    // si la posicion esta libre o fue elimninada incrementa el contador
-    if (!table[index].ocupado || table[index].borrado) {
-        actualSize++;
+template<typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::liberar() {
+    for (size_t i = 0; i < numSlots; ++i) {
+        if (control[i] >= 0) {
+            slots[i].~HashEntry<K, V>();
+        }
     }
-    // inserta o actualiza la entrada
-    table[index] = HashEntry<K, V>(key, value);
+    delete[] control;
+    ::operator delete(slots);
+    control = nullptr;
+    slots = nullptr;
 }
 
-// busca la clave que se le pase y retorna un puntero al valor o nullptr si no existe
-template<typename K, typename V>
-V* HashTable<K, V>::search(const K& key) {
-    int index = hash(key);
-    int originalIndex = index;
-
-    // busca la clave
-    while (table[index].ocupado) {
-        if (!table[index].borrado && table[index].key == key) {
-            return &table[index].value;
+// los grupos se recorren con saltos 1, 2, 3... (triangular), con una cantidad de grupos
+// potencia de 2 eso pasa por todos los grupos
+template<typename K, typename V, typename H, typename E>
+template<typename Q>
+size_t HashTable<K, V, H, E>::buscarSlot(const Q& key, size_t h) const {
+    const int8_t fragmento = static_cast<int8_t>(h & 0x7F);
+    const size_t mascaraGrupos = numSlots / TAMANIO_GRUPO - 1;
+    size_t grupo = (h >> 7) & mascaraGrupos;
+
+    for (size_t paso = 1; paso <= mascaraGrupos + 1; ++paso) {
+        const int8_t* bytes = control + grupo * TAMANIO_GRUPO;
+        uint32_t candidatos = hashtable_detalle::coincidencias(bytes, fragmento);
+        while (candidatos != 0) {
+            size_t slot = grupo * TAMANIO_GRUPO + hashtable_detalle::primerBit(candidatos);
+            if (igual(slots[slot].key, key)) {
+                return slot;
+            }
+            candidatos &= candidatos - 1;
+        }
+        // un grupo con un slot vacio corta la busqueda: la clave se hubiera puesto ahi
+        if (hashtable_detalle::coincidencias(bytes, VACIO) != 0) {
+            return numSlots;
+        }
+        grupo = (grupo + paso) & mascaraGrupos;
+    }
+    return numSlots;
+}
+
+// primer slot vacio o borrado en la secuencia de grupos del hash
+template<typename K, typename V, typename H, typename E>
+size_t HashTable<K, V, H, E>::slotLibre(size_t h) const {
+    const size_t mascaraGrupos = numSlots / TAMANIO_GRUPO - 1;
+    size_t grupo = (h >> 7) & mascaraGrupos;
+    for (size_t paso = 1; ; ++paso) {
+        uint32_t libresGrupo = hashtable_detalle::libres(control + grupo * TAMANIO_GRUPO);
+        if (libresGrupo != 0) {
+            return grupo * TAMANIO_GRUPO + hashtable_detalle::primerBit(libresGrupo);
+        }
+        grupo = (grupo + paso) & mascaraGrupos;
+    }
+}
+
+// si la mitad de la carga maxima son borrados se reconstruye con el mismo tamanio,
+// si no se duplica. las entradas se mueven a los arreglos nuevos, sin copiarlas
+template<typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::rehash() {
+    int8_t* controlViejo = control;
+    HashEntry<K, V>* slotsViejos = slots;
+    size_t numSlotsViejo = numSlots;
+
+    size_t slotsNuevos = static_cast<size_t>(actualSize) <= maxOcupados() / 2 ? numSlots : numSlots * 2;
+    reservar(slotsNuevos);
+    for (size_t i = 0; i < numSlotsViejo; ++i) {
+        if (controlViejo[i] >= 0) {
+            size_t h = hasher(slotsViejos[i].key);
+            size_t slot = slotLibre(h);
+            new (&slots[slot]) HashEntry<K, V>(std::move(slotsViejos[i].key), std::move(slotsViejos[i].value));
+            control[slot] = static_cast<int8_t>(h & 0x7F);
+            slotsViejos[i].~HashEntry<K, V>();
         }
-        index = (index + 1) % tableSize;
-        if (index == originalIndex) break; // evita el bucle infinito
     }
-    return nullptr;
+    crecimientoRestante = maxOcupados() - actualSize;
+
+    delete[] controlViejo;
+    ::operator delete(slotsViejos);
 }
 
-// elimina la clave de la tabla marcando como eliminadad
-template<typename K, typename V>
-bool HashTable<K, V>::remove(const K& key) {
-    int index = hash(key);
-    int originalIndex = index;
+// inserta o actualiza
+template<typename K, typename V, typename H, typename E>
+template<typename KK, typename VV>
+void HashTable<K, V, H, E>::insertar(KK&& key, VV&& value) {
+    size_t h = hasher(key);
+    size_t slot = buscarSlot(key, h);
+    if (slot != numSlots) {
+        slots[slot].value = std::forward<VV>(value);
+        return;
+    }
 
-    // busca la clave con el mismo algoritmo anterioor
-    while (table[index].ocupado) {
-        if (!table[index].borrado && table[index].key == key) {
-            table[index].borrado = true; // marca como eliminada
-            actualSize--;
-            return true;
+    slot = slotLibre(h);
+    // reusar un borrado no gasta crecimiento, ocupar un vacio si
+    if (control[slot] == VACIO && crecimientoRestante == 0) {
+        rehash();
+        slot = slotLibre(h);
+    }
+    if (control[slot] == VACIO) {
+        crecimientoRestante--;
+    }
+    new (&slots[slot]) HashEntry<K, V>(std::forward<KK>(key), std::forward<VV>(value));
+    control[slot] = static_cast<int8_t>(h & 0x7F);
+    actualSize++;
+}
+
+template<typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::insert(const K& key, const V& value) {
+    insertar(key, value);
+}
+
+template<typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::insert(K&& key, V&& value) {
+    insertar(std::move(key), std::move(value));
+}
+
+// busca la clave que se le pase y retorna un puntero al valor o nullptr si no existe
+template<typename K, typename V, typename H, typename E>
+template<typename Q>
+V* HashTable<K, V, H, E>::search(const Q& key) {
+    size_t slot = buscarSlot(key, hasher(key));
+    return slot == numSlots ? nullptr : &slots[slot].value;
+}
+
+template<typename K, typename V, typename H, typename E>
+template<typename Q>
+const V* HashTable<K, V, H, E>::search(const Q& key) const {
+    size_t slot = buscarSlot(key, hasher(key));
+    return slot == numSlots ? nullptr : &slots[slot].value;
+}
+
+// si el grupo del slot tiene algun vacio, ninguna busqueda siguio de largo por este
+// grupo y el slot puede quedar vacio; si no queda como borrado hasta el proximo rehash
+template<typename K, typename V, typename H, typename E>
+template<typename Q>
+bool HashTable<K, V, H, E>::remove(const Q& key) {
+    size_t slot = buscarSlot(key, hasher(key));
+    if (slot == numSlots) {
+        return false;
+    }
+    slots[slot].~HashEntry<K, V>();
+    actualSize--;
+
+    const int8_t* grupo = control + (slot & ~static_cast<size_t>(TAMANIO_GRUPO - 1));
+    if (hashtable_detalle::coincidencias(grupo, VACIO) != 0) {
+        control[slot] = VACIO;
+        crecimientoRestante++;
+    } else {
+        control[slot] = BORRADO;
+    }
+    return true;
+}
+
+// vacia la tabla sin achicarla
+template<typename K, typename V, typename H, typename E>
+void HashTable<K, V, H, E>::clear() {
+    for (size_t i = 0; i < numSlots; ++i) {
+        if (control[i] >= 0) {
+            slots[i].~HashEntry<K, V>();
         }
-        index = (index + 1) % tableSize;
-        if (index == originalIndex) break; // evita el bucle
+        control[i] = VACIO;
     }
-    return false;
+    actualSize = 0;
+    crecimientoRestante = maxOcupados();
 }
 
 // retorna el numero de elementos activos en la tabla
-template<typename K, typename V>
-int HashTable<K, V>::size() const { return actualSize; }
+template<typename K, typename V, typename H, typename E>
+int HashTable<K, V, H, E>::size() const { return actualSize; }
 
 // retorna true si la tabla esta vacia
-template<typename K, typename V>
-bool HashTable<K, V>::empty() const { return actualSize == 0; }
\ No newline at end of file
+template<typename K, typename V, typename H, typename E>
+bool HashTable<K, V, H, E>::empty() const { return actualSize == 0; }
@@ -0,0 +1,504 @@
+#include "IndiceParticionado.h"
+#include "Buscador.h"
+#include "Interseccion.h"
+#include "ProcesadorDocumentos.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+
+// mezcla listas ya ordenadas (la mejor primero segun mejor) con un heap que tiene la
+// cabeza de cada una, hasta limite. se saca la cima y la siguiente de su lista la
+// reemplaza en el lugar (un solo hundimiento en vez de sacar y volver a meter)
+template<typename T, typename Mejor>
+static std::vector<T> mezclarOrdenadas(std::vector<std::vector<T>>& listas, size_t limite, Mejor mejor) {
+    struct Cabeza {
+        const T* actual;
+        const T* fin;
+    };
+    std::vector<Cabeza> heap;
+    size_t total = 0;
+    for (std::vector<T>& lista : listas) {
+        if (!lista.empty()) {
+            heap.push_back(Cabeza{lista.data(), lista.data() + lista.size()});
+            total += lista.size();
+        }
+    }
+    if (heap.size() == 1) {
+        for (std::vector<T>& lista : listas) {
+            if (!lista.empty()) {
+                lista.resize(std::min(lista.size(), limite));
+                return std::move(lista);
+            }
+        }
+    }
+
+    auto peor = [&](const Cabeza& a, const Cabeza& b) { return mejor(*b.actual, *a.actual); };
+    std::make_heap(heap.begin(), heap.end(), peor);
+    std::vector<T> resultado;
+    resultado.reserve(std::min(total, limite));
+    size_t activas = heap.size();
+    while (activas > 0 && resultado.size() < limite) {
+        resultado.push_back(*heap[0].actual);
+        if (++heap[0].actual == heap[0].fin) {
+            heap[0] = heap[--activas];
+        }
+        size_t i = 0;
+        while (2 * i + 1 < activas) {
+            size_t hijo = 2 * i + 1;
+            if (hijo + 1 < activas && peor(heap[hijo], heap[hijo + 1])) {
+                hijo++;
+            }
+            if (!peor(heap[i], heap[hijo])) {
+                break;
+            }
+            std::swap(heap[i], heap[hijo]);
+            i = hijo;
+        }
+    }
+    return resultado;
+}
+
+Segmento::Segmento(const InvertedIndex* idx, int primero, bool esPropio)
+    : indice(idx), ranking(new RankingBM25(idx)), primerDoc(primero), numDocs(idx->getNumDocumentos()),
+      sumaLongitudes(idx->getSumaLongitudes()), propio(esPropio) {}
+
+Segmento::~Segmento() {
+    delete ranking;
+    if (propio) {
+        delete indice;
+    }
+}
+
+IndiceParticionado::IndiceParticionado(int shards, int numHilos)
+    : numShards(std::max(shards, 1)), posicional(false), maxDocsMezcla(INT_MAX), pageRankScores(nullptr), pesoPageRank(0.0),
+      vista(std::make_shared<const VistaSegmentos>()), abierto(nullptr), primerDocAbierto(0), segmentosSellados(0),
+      mezclasHechas(0), hayAviso(false), detenerHilo(false), terminar(false) {
+    int totalHilos = numHilos > 0 ? numHilos : numShards - 1;
+    for (int i = 0; i < totalHilos; ++i) {
+        hilos.emplace_back(&IndiceParticionado::trabajar, this);
+    }
+}
+
+IndiceParticionado::~IndiceParticionado() {
+    detenerMantenimiento();
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        terminar = true;
+    }
+    cvTareas.notify_all();
+    for (std::thread& hilo : hilos) {
+        hilo.join();
+    }
+    delete abierto;
+}
+
+void IndiceParticionado::trabajar() {
+    while (true) {
+        std::function<void()> tarea;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cvTareas.wait(lock, [&]() { return terminar || !tareas.empty(); });
+            if (tareas.empty()) {
+                return;
+            }
+            tarea = std::move(tareas.front());
+            tareas.pop_front();
+        }
+        tarea();
+    }
+}
+
+// las tareas 1.. van a la cola y el que consulta corre la 0. mientras falte alguna saca
+// tareas de la cola (de esta consulta o de otra), asi nunca espera con trabajo pendiente
+// y con varias consultas a la vez no hace falta un hilo del pool libre para terminar
+void IndiceParticionado::repartir(int cantidad, const std::function<void(int)>& tarea) const {
+    int pendientes = cantidad;
+    auto correr = [&](int i) {
+        tarea(i);
+        std::lock_guard<std::mutex> lock(mtx);
+        if (--pendientes == 0) {
+            cvTerminadas.notify_all();
+        }
+    };
+    if (cantidad > 1) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            for (int i = 1; i < cantidad; ++i) {
+                tareas.push_back([&correr, i]() { correr(i); });
+            }
+        }
+        cvTareas.notify_all();
+    }
+    correr(0);
+
+    std::unique_lock<std::mutex> lock(mtx);
+    while (pendientes > 0) {
+        if (!tareas.empty()) {
+            std::function<void()> otra = std::move(tareas.front());
+            tareas.pop_front();
+            lock.unlock();
+            otra();
+            lock.lock();
+            continue;
+        }
+        cvTerminadas.wait(lock);
+    }
+}
+
+std::shared_ptr<const VistaSegmentos> IndiceParticionado::getVista() const {
+    return std::atomic_load(&vista);
+}
+
+void IndiceParticionado::publicar(std::shared_ptr<const VistaSegmentos> nueva) {
+    std::atomic_store(&vista, std::move(nueva));
+}
+
+std::shared_ptr<const Segmento> IndiceParticionado::crearSegmento(const InvertedIndex* indice, int primerDoc, bool propio) const {
+    std::shared_ptr<Segmento> segmento = std::make_shared<Segmento>(indice, primerDoc, propio);
+    segmento->ranking->setPageRank(pageRankScores, pesoPageRank, primerDoc, primerDoc + segmento->numDocs);
+    return segmento;
+}
+
+void IndiceParticionado::construir(const InvertedIndex& index) {
+    posicional = index.esPosicional();
+    int totalDocs = index.getNumDocumentos();
+    std::shared_ptr<VistaSegmentos> nueva = std::make_shared<VistaSegmentos>();
+
+    if (numShards == 1) {
+        nueva->segmentos.push_back(crearSegmento(&index, 0, false));
+    } else {
+        // cortes por terminos indexados acumulados (+1 por doc, para que los vacios tambien cuenten)
+        long long total = 0;
+        for (int doc = 0; doc < totalDocs; ++doc) {
+            total += index.getLongitudDocumento(doc) + 1;
+        }
+        std::vector<int> inicios(1, 0);
+        long long acumulado = 0;
+        for (int doc = 0; doc < totalDocs && static_cast<int>(inicios.size()) < numShards; ++doc) {
+            if (acumulado >= total * static_cast<long long>(inicios.size()) / numShards) {
+                inicios.push_back(doc);
+            }
+            acumulado += index.getLongitudDocumento(doc) + 1;
+        }
+        while (static_cast<int>(inicios.size()) < numShards) {
+            inicios.push_back(totalDocs); // menos docs que shards, los ultimos quedan vacios
+        }
+        inicios.push_back(totalDocs);
+
+        // cada shard se arma en su propio hilo, el indice de origen solo se lee
+        std::vector<InvertedIndex*> partes(numShards, nullptr);
+        std::vector<std::thread> constructores;
+        for (int shard = 0; shard < numShards; ++shard) {
+            partes[shard] = new InvertedIndex();
+            partes[shard]->setModoPosicional(posicional);
+            constructores.emplace_back([&partes, &inicios, &index, shard]() {
+                partes[shard]->agregarRango(index, inicios[shard], inicios[shard + 1]);
+            });
+        }
+        for (std::thread& constructor : constructores) {
+            constructor.join();
+        }
+
+        // tope de las mezclas: el mayor shard, pero siempre se pueden juntar los del nivel 0
+        maxDocsMezcla = SEGMENTO_MAX_DOCS * std::max(SEGMENTO_FACTOR_MEZCLA, 2);
+        for (int shard = 0; shard < numShards; ++shard) {
+            nueva->segmentos.push_back(crearSegmento(partes[shard], inicios[shard], true));
+            maxDocsMezcla = std::max(maxDocsMezcla, nueva->segmentos.back()->numDocs);
+        }
+    }
+    nueva->numDocumentos = totalDocs;
+    nueva->sumaLongitudes = index.getSumaLongitudes();
+
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    nueva->version = getVista()->version + 1;
+    publicar(nueva);
+}
+
+void IndiceParticionado::setPageRankScores(const std::map<int, double>* scores, double pesoRanking) {
+    pageRankScores = scores;
+    pesoPageRank = pesoRanking;
+}
+
+std::vector<int> IndiceParticionado::buscar(const std::vector<std::string>& terminos, uint64_t* version) const {
+    std::shared_ptr<const VistaSegmentos> actual = getVista();
+    if (version != nullptr) {
+        *version = actual->version;
+    }
+    std::vector<int> resultado;
+    const std::vector<std::shared_ptr<const Segmento>>& segmentos = actual->segmentos;
+    int cantidad = static_cast<int>(segmentos.size());
+    if (terminos.empty() || cantidad == 0) {
+        return resultado;
+    }
+
+    // cada segmento intersecta sus listas y, si hace falta, ordena sus docs por pagerank
+    bool porPageRank = terminos.size() > 1 && pageRankScores != nullptr;
+    std::vector<std::vector<int>> docs(cantidad);
+    std::vector<std::vector<std::pair<int, double>>> rankeados(porPageRank ? cantidad : 0);
+    repartir(cantidad, [&](int i) {
+        std::vector<const ListaPosteo*> listas;
+        listas.reserve(terminos.size());
+        for (const std::string& termino : terminos) {
+            listas.push_back(segmentos[i]->indice->search(termino));
+        }
+        docs[i] = Interseccion::intersectar(listas);
+        for (int& doc : docs[i]) {
+            doc += segmentos[i]->primerDoc;
+        }
+        if (porPageRank) {
+            rankeados[i] = Buscador::rankearPorPageRank(docs[i], *pageRankScores);
+        }
+    });
+
+    if (!porPageRank) {
+        // los rangos de los segmentos estan en orden: concatenados quedan ordenados por doc id
+        size_t total = 0;
+        for (const std::vector<int>& parte : docs) {
+            total += parte.size();
+        }
+        resultado.reserve(total);
+        for (const std::vector<int>& parte : docs) {
+            resultado.insert(resultado.end(), parte.begin(), parte.end());
+        }
+        return resultado;
+    }
+
+    std::vector<std::pair<int, double>> mezcla = mezclarOrdenadas(rankeados, SIZE_MAX, Buscador::mejorPageRank);
+    resultado.reserve(mezcla.size());
+    for (const auto& doc_pair : mezcla) {
+        resultado.push_back(doc_pair.first);
+    }
+    return resultado;
+}
+
+// el df de cada termino se suma entre los segmentos antes de repartir, asi todos usan el
+// mismo idf. cada segmento devuelve sus k mejores y de la mezcla salen los k mejores globales
+std::vector<ResultadoRankeado> IndiceParticionado::topK(const std::vector<std::string>& terminos, int k, bool conjuntiva) const {
+    std::shared_ptr<const VistaSegmentos> actual = getVista();
+    const std::vector<std::shared_ptr<const Segmento>>& segmentos = actual->segmentos;
+    int cantidad = static_cast<int>(segmentos.size());
+    if (k <= 0 || cantidad == 0) {
+        return std::vector<ResultadoRankeado>();
+    }
+
+    EstadisticasColeccion coleccion;
+    coleccion.numDocumentos = actual->numDocumentos;
+    coleccion.longitudPromedio = actual->numDocumentos > 0 ? (double)actual->sumaLongitudes / actual->numDocumentos : 0.0;
+    for (const std::string& termino : terminos) {
+        if (coleccion.df.count(termino) > 0) {
+            continue;
+        }
+        int df = 0;
+        for (const std::shared_ptr<const Segmento>& segmento : segmentos) {
+            const ListaPosteo* lista = segmento->indice->search(termino);
+            if (lista != nullptr) {
+                df += lista->getSize();
+            }
+        }
+        coleccion.df[termino] = df;
+    }
+
+    std::vector<std::vector<ResultadoRankeado>> parciales(cantidad);
+    repartir(cantidad, [&](int i) {
+        parciales[i] = segmentos[i]->ranking->topK(terminos, k, conjuntiva, &coleccion);
+        for (ResultadoRankeado& resultado : parciales[i]) {
+            resultado.docId += segmentos[i]->primerDoc;
+        }
+    });
+
+    // mismo orden que RankingBM25: mayor score, en empate el doc id menor
+    return mezclarOrdenadas(parciales, static_cast<size_t>(k), [](const ResultadoRankeado& a, const ResultadoRankeado& b) {
+        return a.score != b.score ? a.score > b.score : a.docId < b.docId;
+    });
+}
+
+// el segmento abierto es de un solo escritor a la vez (mutexEscritura) y ninguna consulta lo
+// ve hasta que se sella: ahi se publica una vista nueva con el agregado al final
+int IndiceParticionado::agregarDocumento(std::string_view linea, const ProcesadorDocumentos& pd) {
+    // una linea mal formada gastaria un doc id en un doc vacio que cambia N y el largo promedio
+    if (!ProcesadorDocumentos::lineaBienFormada(linea)) {
+        return -1;
+    }
+    std::unique_lock<std::mutex> lock(mutexEscritura);
+    if (abierto == nullptr) {
+        abierto = new InvertedIndex();
+        abierto->setModoPosicional(posicional);
+        primerDocAbierto = getVista()->numDocumentos;
+        abiertoDesde = std::chrono::steady_clock::now();
+    }
+    int local = abierto->getNumDocumentos();
+    abierto->setLongitudDocumento(local, pd.procesarContenidoDocumentosVista(linea, local, *abierto));
+    int docId = primerDocAbierto + local;
+    if (abierto->getNumDocumentos() < SEGMENTO_MAX_DOCS) {
+        return docId;
+    }
+
+    sellarAbierto();
+    lock.unlock();
+    {
+        std::lock_guard<std::mutex> aviso(mutexMantenimiento);
+        hayAviso = true; // puede haber algo para mezclar
+    }
+    cvMantenimiento.notify_one();
+    return docId;
+}
+
+void IndiceParticionado::sellar() {
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    sellarAbierto();
+}
+
+void IndiceParticionado::sellarAbierto() {
+    if (abierto == nullptr) {
+        return;
+    }
+    abierto->sellarListas();
+    std::shared_ptr<VistaSegmentos> nueva = std::make_shared<VistaSegmentos>(*getVista());
+    nueva->segmentos.push_back(crearSegmento(abierto, primerDocAbierto, true));
+    nueva->numDocumentos += nueva->segmentos.back()->numDocs;
+    nueva->sumaLongitudes += nueva->segmentos.back()->sumaLongitudes;
+    nueva->version++;
+    publicar(nueva);
+    abierto = nullptr;
+    segmentosSellados++;
+}
+
+// niveles: un segmento de hasta SEGMENTO_MAX_DOCS docs es de nivel 0, hasta
+// SEGMENTO_MAX_DOCS * SEGMENTO_FACTOR_MEZCLA de nivel 1, etc. se mezclan SEGMENTO_FACTOR_MEZCLA
+// segmentos seguidos del mismo nivel (los ids tienen que quedar contiguos), primero los del
+// nivel mas bajo. asi cada doc se reescribe una vez por nivel y quedan pocos segmentos por nivel.
+// con shards ningun segmento pasa del mayor shard (o del nivel 1 completo si es mas grande):
+// los que llegan ahi ya no se mezclan
+bool IndiceParticionado::elegirMezcla(const VistaSegmentos& actual, size_t& desde, size_t& hasta) const {
+    const size_t factor = std::max(SEGMENTO_FACTOR_MEZCLA, 2);
+    auto nivel = [](int docs) {
+        int n = 0;
+        for (long long tope = SEGMENTO_MAX_DOCS; docs > tope; tope *= SEGMENTO_FACTOR_MEZCLA) {
+            n++;
+        }
+        return n;
+    };
+
+    const std::vector<std::shared_ptr<const Segmento>>& segmentos = actual.segmentos;
+    int mejorNivel = INT_MAX;
+    size_t inicio = 0;
+    while (inicio < segmentos.size()) {
+        int n = nivel(segmentos[inicio]->numDocs);
+        size_t fin = inicio + 1;
+        while (fin < segmentos.size() && nivel(segmentos[fin]->numDocs) == n) {
+            fin++;
+        }
+        if (fin - inicio >= factor && n < mejorNivel) {
+            // si pasan del tope se mezclan menos, al menos dos
+            size_t cantidad = factor;
+            long long total = 0;
+            for (size_t i = inicio; i < inicio + cantidad; ++i) {
+                total += segmentos[i]->numDocs;
+            }
+            while (cantidad > 2 && total > maxDocsMezcla) {
+                cantidad--;
+                total -= segmentos[inicio + cantidad]->numDocs;
+            }
+            if (total <= maxDocsMezcla) {
+                desde = inicio;
+                hasta = inicio + cantidad;
+                mejorNivel = n;
+            }
+        }
+        inicio = fin;
+    }
+    return mejorNivel != INT_MAX;
+}
+
+// el segmento mezclado se arma sin ningun lock (los de origen no cambian) y se publica
+// en el lugar de los que reemplaza. los docs y sus ids son los mismos: la version no cambia
+int IndiceParticionado::mezclar() {
+    std::lock_guard<std::mutex> lock(mutexMezcla);
+    int mezclas = 0;
+    while (true) {
+        std::shared_ptr<const VistaSegmentos> actual = getVista();
+        size_t desde = 0;
+        size_t hasta = 0;
+        if (!elegirMezcla(*actual, desde, hasta)) {
+            break;
+        }
+
+        InvertedIndex* mezclado = new InvertedIndex();
+        mezclado->setModoPosicional(posicional);
+        int primerDoc = actual->segmentos[desde]->primerDoc;
+        for (size_t i = desde; i < hasta; ++i) {
+            const Segmento& segmento = *actual->segmentos[i];
+            mezclado->agregarRango(*segmento.indice, 0, segmento.numDocs, segmento.primerDoc - primerDoc);
+        }
+        mezclado->sellarListas();
+        std::shared_ptr<const Segmento> nuevo = crearSegmento(mezclado, primerDoc, true);
+
+        std::lock_guard<std::mutex> escritura(mutexEscritura);
+        // mientras tanto solo se pudieron sellar segmentos, que van al final
+        std::shared_ptr<VistaSegmentos> nueva = std::make_shared<VistaSegmentos>(*getVista());
+        if (nueva->segmentos.size() < hasta || nueva->segmentos[desde] != actual->segmentos[desde] ||
+            nueva->segmentos[hasta - 1] != actual->segmentos[hasta - 1]) {
+            break; // construir cambio todo
+        }
+        nueva->segmentos.erase(nueva->segmentos.begin() + desde, nueva->segmentos.begin() + hasta);
+        nueva->segmentos.insert(nueva->segmentos.begin() + desde, nuevo);
+        publicar(nueva);
+        mezclasHechas++;
+        mezclas++;
+    }
+    return mezclas;
+}
+
+void IndiceParticionado::iniciarMantenimiento() {
+    if (!mantenimiento.joinable()) {
+        detenerHilo = false;
+        mantenimiento = std::thread(&IndiceParticionado::mantener, this);
+    }
+}
+
+void IndiceParticionado::detenerMantenimiento() {
+    if (!mantenimiento.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutexMantenimiento);
+        detenerHilo = true;
+    }
+    cvMantenimiento.notify_all();
+    mantenimiento.join();
+}
+
+// se despierta cada SEGMENTO_INTERVALO_MS o cuando se sella un segmento lleno: sella el
+// abierto si ya paso el intervalo desde su primer doc (asi un doc tarda a lo sumo unos dos
+// intervalos en aparecer) y mezcla lo que haga falta
+void IndiceParticionado::mantener() {
+    const std::chrono::milliseconds intervalo(SEGMENTO_INTERVALO_MS);
+    std::unique_lock<std::mutex> lock(mutexMantenimiento);
+    while (!detenerHilo) {
+        cvMantenimiento.wait_for(lock, intervalo, [this]() { return hayAviso || detenerHilo; });
+        if (detenerHilo) {
+            break;
+        }
+        hayAviso = false;
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> escritura(mutexEscritura);
+            if (abierto != nullptr && std::chrono::steady_clock::now() - abiertoDesde >= intervalo) {
+                sellarAbierto();
+            }
+        }
+        mezclar();
+        lock.lock();
+    }
+}
+
+long long IndiceParticionado::getSegmentosSellados() const {
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    return segmentosSellados;
+}
+
+long long IndiceParticionado::getMezclasHechas() const {
+    std::lock_guard<std::mutex> lock(mutexEscritura);
+    return mezclasHechas;
+}
@@ -0,0 +1,166 @@
+#ifndef INDICE_PARTICIONADO_H
+#define INDICE_PARTICIONADO_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "InvertedIndex.h"
+#include "RankingBM25.h"
+
+class ProcesadorDocumentos;
+
+// el segmento abierto se sella (y sus docs aparecen en las consultas) al llegar a esta
+// cantidad de docs
+#ifndef SEGMENTO_MAX_DOCS
+#define SEGMENTO_MAX_DOCS 1024
+#endif
+// o cuando pasa este tiempo desde su primer doc (lo revisa el hilo de mantenimiento)
+#ifndef SEGMENTO_INTERVALO_MS
+#define SEGMENTO_INTERVALO_MS 1000
+#endif
+// cuantos segmentos seguidos del mismo nivel se mezclan en uno. el nivel de un segmento de
+// n docs es cuantas veces hay que multiplicar SEGMENTO_MAX_DOCS por este factor para llegar a n
+#ifndef SEGMENTO_FACTOR_MEZCLA
+#define SEGMENTO_FACTOR_MEZCLA 4
+#endif
+
+// rango contiguo de doc ids [primerDoc, primerDoc + numDocs) con su propio InvertedIndex
+// (ids locales desde 0) y su RankingBM25. una vez publicado no cambia
+struct Segmento {
+    const InvertedIndex* indice;
+    RankingBM25* ranking;
+    int primerDoc;
+    int numDocs;
+    long long sumaLongitudes;
+    bool propio; // false = el indice es de afuera (el cargado al inicio) y no se libera
+
+    Segmento(const InvertedIndex* indice, int primerDoc, bool propio);
+    ~Segmento();
+    Segmento(const Segmento&) = delete;
+    Segmento& operator=(const Segmento&) = delete;
+};
+
+// lo que ve una consulta: los segmentos ordenados por primerDoc y los totales de la
+// coleccion. no se modifica, cada cambio publica una vista nueva
+struct VistaSegmentos {
+    std::vector<std::shared_ptr<const Segmento>> segmentos;
+    int numDocumentos;
+    long long sumaLongitudes;
+    uint64_t version; // sube cuando aparecen docs nuevos; una mezcla no cambia ningun resultado
+
+    VistaSegmentos() : numDocumentos(0), sumaLongitudes(0), version(0) {}
+};
+
+// indice repartido en segmentos por rangos contiguos de doc ids. una consulta corre en todos
+// los segmentos a la vez en un pool de hilos (el hilo que consulta tambien trabaja) y los
+// resultados de cada uno, ya ordenados, se mezclan con un heap que tiene la cabeza de cada
+// uno. el BM25 de cada segmento usa el df, la cantidad de docs y el largo promedio de toda
+// la coleccion y el pagerank es el global, asi el resultado es el mismo que con un solo indice.
+//
+// construir reparte el indice cargado en numShards segmentos. despues se pueden agregar docs
+// mientras se consulta (estilo LSM): van a un segmento abierto que solo ve el que escribe y
+// que se sella (listas comprimidas) y se publica al llenarse o cada SEGMENTO_INTERVALO_MS.
+// el hilo de mantenimiento mezcla los segmentos chicos por niveles para que no se acumulen.
+// cada consulta toma la vista actual (un shared_ptr que se reemplaza entero) y trabaja sobre
+// ella hasta el final: nunca espera a los que agregan o mezclan, y un segmento reemplazado se
+// libera cuando termina la ultima consulta que lo usaba
+class IndiceParticionado {
+public:
+    // numHilos: hilos del pool ademas del que consulta, 0 = numShards - 1
+    IndiceParticionado(int numShards, int numHilos = 0);
+    ~IndiceParticionado();
+    IndiceParticionado(const IndiceParticionado&) = delete;
+    IndiceParticionado& operator=(const IndiceParticionado&) = delete;
+
+    // corta los docs de index en rangos con mas o menos la misma cantidad de terminos
+    // indexados (suma de los largos de los docs) y arma cada segmento en su propio hilo.
+    // los docs son los que tienen largo en index (getNumDocumentos), como los dejan las cargas.
+    // con un solo shard no se copia nada: el segmento es index, que tiene que seguir vivo.
+    // si no, index puede venir de un snapshot y no se usa mas despues de construir.
+    // se llama una vez, antes de consultar o agregar docs
+    void construir(const InvertedIndex& index);
+    // scores por doc id global, el mapa tiene que seguir vivo mientras se consulte.
+    // se aplica a los segmentos que se crean despues: llamarlo antes de construir
+    void setPageRankScores(const std::map<int, double>* scores, double pesoRanking = PESO_PAGERANK_BM25);
+
+    // lo mismo que Buscador::query: AND de los terminos, por pagerank si hay mas de uno.
+    // version: la de la vista con la que se respondio
+    std::vector<int> buscar(const std::vector<std::string>& terminos, uint64_t* version = nullptr) const;
+    // lo mismo que RankingBM25::topK sobre el indice completo
+    std::vector<ResultadoRankeado> topK(const std::vector<std::string>& terminos, int k, bool conjuntiva = false) const;
+
+    // agrega un doc (una linea como las de gov2_pages.dat) y devuelve su doc id, o -1 si la linea
+    // esta mal formada (no se agrega nada). aparece en las consultas cuando se sella su segmento.
+    // se puede llamar desde varios hilos
+    int agregarDocumento(std::string_view linea, const ProcesadorDocumentos& pd);
+    // sella y publica el segmento abierto, si tiene docs
+    void sellar();
+    // mezcla segmentos mientras la politica de niveles encuentre alguno, devuelve cuantas mezclas hizo
+    int mezclar();
+    // hilo que sella por tiempo y mezcla en segundo plano; se detiene solo al destruir
+    void iniciarMantenimiento();
+    void detenerMantenimiento();
+
+    std::shared_ptr<const VistaSegmentos> getVista() const;
+    uint64_t getVersion() const { return getVista()->version; }
+    int getNumShards() const { return numShards; }
+    int getNumHilos() const { return static_cast<int>(hilos.size()); }
+    int getNumDocumentos() const { return getVista()->numDocumentos; }
+    int getNumSegmentos() const { return static_cast<int>(getVista()->segmentos.size()); }
+    long long getSegmentosSellados() const;
+    long long getMezclasHechas() const;
+
+private:
+    int numShards;
+    bool posicional; // el de construir, lo heredan los segmentos nuevos
+    int maxDocsMezcla; // con shards una mezcla no arma segmentos mas grandes que el mayor, asi no se pierde paralelismo
+    const std::map<int, double>* pageRankScores;
+    double pesoPageRank;
+
+    // solo con std::atomic_load / std::atomic_store
+    std::shared_ptr<const VistaSegmentos> vista;
+
+    // escritura: el segmento abierto y publicar vistas nuevas
+    mutable std::mutex mutexEscritura;
+    InvertedIndex* abierto;
+    int primerDocAbierto;
+    std::chrono::steady_clock::time_point abiertoDesde;
+    long long segmentosSellados;
+    long long mezclasHechas;
+    std::mutex mutexMezcla; // una mezcla a la vez
+
+    std::thread mantenimiento;
+    std::mutex mutexMantenimiento;
+    std::condition_variable cvMantenimiento;
+    bool hayAviso;
+    bool detenerHilo;
+
+    std::vector<std::thread> hilos;
+    mutable std::mutex mtx;
+    mutable std::condition_variable cvTareas;
+    mutable std::condition_variable cvTerminadas;
+    mutable std::deque<std::function<void()>> tareas;
+    bool terminar;
+
+    void trabajar();
+    // corre tarea(i) para i en [0, cantidad) y vuelve cuando terminaron todas
+    void repartir(int cantidad, const std::function<void(int)>& tarea) const;
+    std::shared_ptr<const Segmento> crearSegmento(const InvertedIndex* indice, int primerDoc, bool propio) const;
+    void publicar(std::shared_ptr<const VistaSegmentos> nueva);
+    void sellarAbierto(); // con mutexEscritura tomado
+    // segmentos [desde, hasta) de la vista que conviene mezclar
+    bool elegirMezcla(const VistaSegmentos& actual, size_t& desde, size_t& hasta) const;
+    void mantener();
+};
+
+#endif
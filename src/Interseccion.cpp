@@ -0,0 +1,169 @@
+#include "Interseccion.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// merge comun de dos rangos ordenados, agrega los comunes a salida
+static void intersectarMerge(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, std::vector<uint32_t>& salida) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < na && j < nb) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            salida.push_back(a[i]);
+            i++;
+            j++;
+        }
+    }
+}
+
+// compara 4 de a contra 4 de b (b rotado 4 veces) y avanza el que tenga el maximo menor.
+// como las dos listas son estrictamente crecientes ningun doc sale dos veces
+static void intersectarSimd(const uint32_t* a, size_t na, const uint32_t* b, size_t nb, std::vector<uint32_t>& salida) {
+    size_t i = 0;
+    size_t j = 0;
+#if defined(__SSE2__)
+    while (i + 4 <= na && j + 4 <= nb) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i iguales = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+            _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                         _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+        unsigned mascara = static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(iguales)));
+        while (mascara != 0) {
+            salida.push_back(a[i + __builtin_ctz(mascara)]);
+            mascara &= mascara - 1;
+        }
+
+        uint32_t maxA = a[i + 3];
+        uint32_t maxB = b[j + 3];
+        if (maxA <= maxB) {
+            i += 4;
+        }
+        if (maxB <= maxA) {
+            j += 4;
+        }
+    }
+#endif
+    intersectarMerge(a + i, na - i, b + j, nb - j, salida);
+}
+
+// recorre la lista bloque a bloque: se saltan los bloques sin candidatos y cada bloque
+// descomprimido se intersecta de una vez con los candidatos que caen en su rango
+static void filtrarPorBloques(const std::vector<uint32_t>& candidatos, const ListaPosteo& lista, bool simd, std::vector<uint32_t>& salida) {
+    size_t i = 0;
+    ListaPosteo::Iterador it = lista.begin();
+    while (i < candidatos.size() && it.valido()) {
+        it.avanzarA(static_cast<int>(candidatos[i]));
+        if (!it.valido()) {
+            break;
+        }
+
+        const uint32_t* docs = it.docsBloque() + it.posicionBloque();
+        size_t cantidad = it.cantidadBloque() - it.posicionBloque();
+        uint32_t maxBloque = docs[cantidad - 1];
+        size_t fin = i;
+        while (fin < candidatos.size() && candidatos[fin] <= maxBloque) {
+            fin++;
+        }
+
+        if (simd) {
+            intersectarSimd(candidatos.data() + i, fin - i, docs, cantidad, salida);
+        } else {
+            intersectarMerge(candidatos.data() + i, fin - i, docs, cantidad, salida);
+        }
+        i = fin;
+        it.siguienteBloque();
+    }
+}
+
+// pocos candidatos contra una lista larga: cada candidato salta directo a su posicion
+static void filtrarGalloping(const std::vector<uint32_t>& candidatos, const ListaPosteo& lista, std::vector<uint32_t>& salida) {
+    ListaPosteo::Iterador it = lista.begin();
+    for (uint32_t doc : candidatos) {
+        it.avanzarA(static_cast<int>(doc));
+        if (!it.valido()) {
+            break;
+        }
+        if (static_cast<uint32_t>(it.docId()) == doc) {
+            salida.push_back(doc);
+        }
+    }
+}
+
+int Interseccion::elegirEstrategia(size_t numCandidatos, size_t largoLista) {
+    if (numCandidatos > 0 && largoLista >= numCandidatos * UMBRAL_GALLOPING) {
+        return INTERSECCION_GALLOPING;
+    }
+#if defined(__SSE2__)
+    return INTERSECCION_SIMD;
+#else
+    return INTERSECCION_MERGE;
+#endif
+}
+
+const char* Interseccion::nombreEstrategia(int estrategia) {
+    switch (estrategia) {
+        case INTERSECCION_MERGE: return "merge";
+        case INTERSECCION_GALLOPING: return "galloping";
+        case INTERSECCION_SIMD: return "simd";
+        default: return "auto";
+    }
+}
+
+void Interseccion::filtrar(std::vector<uint32_t>& candidatos, const ListaPosteo& lista, int estrategia) {
+    if (estrategia == INTERSECCION_AUTO) {
+        estrategia = elegirEstrategia(candidatos.size(), lista.getSize());
+    }
+
+    std::vector<uint32_t> salida;
+    salida.reserve(candidatos.size());
+    if (estrategia == INTERSECCION_GALLOPING) {
+        filtrarGalloping(candidatos, lista, salida);
+    } else {
+        filtrarPorBloques(candidatos, lista, estrategia == INTERSECCION_SIMD, salida);
+    }
+    candidatos.swap(salida);
+}
+
+std::vector<int> Interseccion::intersectar(std::vector<const ListaPosteo*> listas, int estrategia) {
+    std::vector<int> resultado;
+    if (listas.empty()) {
+        return resultado;
+    }
+    for (const ListaPosteo* lista : listas) {
+        if (lista == nullptr) {
+            return resultado; // un termino sin lista: la interseccion es vacia
+        }
+    }
+
+    // la mas corta primero (menor df), asi los candidatos son los menos posibles desde el inicio
+    std::sort(listas.begin(), listas.end(), [](const ListaPosteo* a, const ListaPosteo* b) {
+        if (a->getSize() != b->getSize()) {
+            return a->getSize() < b->getSize();
+        }
+        return a < b;
+    });
+    listas.erase(std::unique(listas.begin(), listas.end()), listas.end()); // terminos repetidos
+
+    std::vector<uint32_t> candidatos;
+    candidatos.reserve(listas[0]->getSize());
+    for (ListaPosteo::Iterador it = listas[0]->begin(); it.valido(); it.siguiente()) {
+        candidatos.push_back(static_cast<uint32_t>(it.docId()));
+    }
+
+    for (size_t i = 1; i < listas.size() && !candidatos.empty(); ++i) {
+        filtrar(candidatos, *listas[i], estrategia);
+    }
+
+    resultado.assign(candidatos.begin(), candidatos.end());
+    return resultado;
+}
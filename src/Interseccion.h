@@ -0,0 +1,35 @@
+#ifndef INTERSECCION_H
+#define INTERSECCION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ListaPosteo.h"
+
+// estrategias para intersectar los candidatos con una lista de posteo
+#define INTERSECCION_AUTO 0
+#define INTERSECCION_MERGE 1      // recorrer las dos listas bloque a bloque
+#define INTERSECCION_GALLOPING 2  // por cada candidato, busqueda exponencial en la lista
+#define INTERSECCION_SIMD 3       // como merge pero comparando de a 4 con SSE2
+
+// si la lista es este multiplo de los candidatos o mas, conviene saltar (galloping)
+#ifndef UMBRAL_GALLOPING
+#define UMBRAL_GALLOPING 32
+#endif
+
+// motor de interseccion AND de listas de posteo. las listas se ordenan por df (la mas
+// corta primero), la mas corta se descomprime como candidatos y cada lista siguiente
+// filtra los candidatos con la estrategia que corresponde segun la proporcion de largos
+namespace Interseccion {
+    // resultado ordenado por doc id; vacio si alguna lista es nullptr (termino que no esta)
+    std::vector<int> intersectar(std::vector<const ListaPosteo*> listas, int estrategia = INTERSECCION_AUTO);
+
+    // deja en candidatos solo los que aparecen en la lista
+    void filtrar(std::vector<uint32_t>& candidatos, const ListaPosteo& lista, int estrategia = INTERSECCION_AUTO);
+
+    int elegirEstrategia(size_t numCandidatos, size_t largoLista);
+    const char* nombreEstrategia(int estrategia);
+}
+
+#endif
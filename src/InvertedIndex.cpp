@@ -1,121 +1,533 @@
 #include "InvertedIndex.h"
+#include "SnapshotIndice.h"
+#include "Interseccion.h"
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 
-InvertedIndex::InvertedIndex() {
+InvertedIndex::InvertedIndex() : sumaLongitudes(0), modoPosicional(false), snapshot(nullptr) {
   // Constructor
 }
 
 InvertedIndex::~InvertedIndex() {
-    for (const auto& vocab_pair : vocabulario) {
-        delete vocab_pair.second;
+    for (TermEntry* entrada : entradas) {
+        delete entrada;
+    }
+    entradas.clear();
+    for (const auto& vista_pair : vistasSnapshot) {
+        delete vista_pair.second;
+    }
+    vistasSnapshot.clear();
+    delete snapshot; // despues de las vistas, que apuntan al archivo mapeado
+}
+
+// entrada del termino para modificarla; si solo esta en el snapshot se pasa al
+// vocabulario y la lista se copia a memoria propia en el primer add
+TermEntry* InvertedIndex::obtenerEntrada(std::string_view termino) {
+    uint32_t id = diccionario.agregar(termino);
+    if (id < entradas.size()) {
+        return entradas[id];
+    }
+
+    TermEntry* entrada = nullptr;
+    if (snapshot != nullptr) {
+        std::lock_guard<std::mutex> lock(mutexVistas);
+        auto vista = vistasSnapshot.find(std::string(termino));
+        if (vista != vistasSnapshot.end()) {
+            entrada = vista->second;
+            vistasSnapshot.erase(vista);
+        } else {
+            int indice = snapshot->buscarTermino(termino);
+            if (indice >= 0) {
+                entrada = new TermEntry(snapshot->crearVistaLista(indice));
+            }
+        }
+    }
+    if (entrada == nullptr) {
+        entrada = new TermEntry();
+        if (modoPosicional) {
+            entrada->posiciones = new ListaPosiciones();
+        }
+    }
+    entradas.push_back(entrada); // el id nuevo es siempre el siguiente
+    return entrada;
+}
+
+const TermEntry* InvertedIndex::buscarEntrada(std::string_view termino) const {
+    uint32_t id = diccionario.buscar(termino);
+    return id == DiccionarioTerminos::NO_ENCONTRADO ? nullptr : entradas[id];
+}
+
+void InvertedIndex::setModoPosicional(bool activo) {
+    if (!entradas.empty() || snapshot != nullptr) {
+        std::cerr << "Error: el modo posicional solo se puede cambiar con el indice vacio." << std::endl;
+        return;
+    }
+    modoPosicional = activo;
+}
+
+void InvertedIndex::addDocumento(const std::string& termino, int doc_id, int frecuencia) {
+    // la funcion add de ListaPosteo evita duplicados y suma la frecuencia
+    TermEntry* entrada = obtenerEntrada(termino);
+    if (entrada->listaPosteo->add(doc_id, frecuencia) && entrada->posiciones != nullptr) {
+        entrada->posiciones->agregar(nullptr, 0); // doc sin posiciones, para no desalinear
+    }
+}
+
+void InvertedIndex::addDocumentoConPosiciones(const std::string& termino, int doc_id, const uint32_t* posiciones, int cantidad) {
+    if (cantidad <= 0) {
+        return;
+    }
+    TermEntry* entrada = obtenerEntrada(termino);
+    if (entrada->listaPosteo->add(doc_id, cantidad) && entrada->posiciones != nullptr) {
+        entrada->posiciones->agregar(posiciones, cantidad);
+    }
+}
+
+// docs [desde, hasta) de una lista de otro indice, con desplazamientoDocs sumado a sus ids
+void InvertedIndex::agregarLista(std::string_view termino, const ListaPosteo* lista, const ListaPosiciones* posicionesOrigen,
+                                 int desde, int hasta, int desplazamientoDocs) {
+    std::vector<uint32_t> posiciones;
+    TermEntry* entrada = nullptr;
+    ListaPosteo::Iterador it = lista->begin();
+    it.avanzarA(desde);
+    for (; it.valido(); it.siguiente()) {
+        if (it.docId() >= hasta) {
+            break;
+        }
+        if (entrada == nullptr) {
+            entrada = obtenerEntrada(termino);
+        }
+        if (entrada->listaPosteo->add(desplazamientoDocs + it.docId(), it.frecuencia()) && entrada->posiciones != nullptr) {
+            posiciones.clear();
+            if (posicionesOrigen != nullptr) {
+                posicionesOrigen->leer(it.ordinal(), posiciones);
+            }
+            entrada->posiciones->agregar(posiciones.data(), static_cast<int>(posiciones.size()));
+        }
+    }
+}
+
+// los doc ids del parcial van despues de todos los ya indexados, por eso
+// cada posteo se agrega al final de la lista (concatenacion)
+void InvertedIndex::agregarParcial(const InvertedIndex& parcial, int desplazamientoDocs, int numDocs) {
+    for (uint32_t id = 0; id < parcial.diccionario.size(); ++id) {
+        const TermEntry* entradaParcial = parcial.entradas[id];
+        agregarLista(parcial.diccionario.getTermino(id), entradaParcial->listaPosteo, entradaParcial->posiciones, 0, numDocs, desplazamientoDocs);
+    }
+
+    for (int doc = 0; doc < numDocs; ++doc) {
+        setLongitudDocumento(desplazamientoDocs + doc, parcial.getLongitudDocumento(doc));
     }
-    vocabulario.clear();
 }
 
-void InvertedIndex::addDocumento(const std::string& termino, int doc_id) {
-    auto it = vocabulario.find(termino);
+// los terminos del vocabulario y los que siguen solo en el snapshot de origen; las vistas
+// del snapshot se crean aca y se tiran, asi varios segmentos pueden leer el mismo origen a la vez
+void InvertedIndex::agregarRango(const InvertedIndex& origen, int desde, int hasta, int primerDocDestino) {
+    int desplazamiento = primerDocDestino - desde;
+    for (uint32_t id = 0; id < origen.diccionario.size(); ++id) {
+        const TermEntry* entradaOrigen = origen.entradas[id];
+        agregarLista(origen.diccionario.getTermino(id), entradaOrigen->listaPosteo, entradaOrigen->posiciones, desde, hasta, desplazamiento);
+    }
+    if (origen.snapshot != nullptr) {
+        for (int i = 0; i < origen.snapshot->getNumTerminos(); ++i) {
+            std::string_view termino = origen.snapshot->getTermino(i);
+            if (origen.diccionario.buscar(termino) != DiccionarioTerminos::NO_ENCONTRADO) {
+                continue;
+            }
+            std::unique_ptr<ListaPosteo> vista(origen.snapshot->crearVistaLista(i));
+            agregarLista(termino, vista.get(), nullptr, desde, hasta, desplazamiento);
+        }
+    }
 
-    if (it == vocabulario.end()) {
-        TermEntry* newEntry = new TermEntry();
-        newEntry->listaPosteo->add(doc_id); // aniadir doc_id a la lista de posteo
-        vocabulario[termino] = newEntry; // Insertar en el mapa
-    } else {
-        // si ya existe el termino, aniadir doc_id a la lista de posteo existentes
-        // la funcion add de linkedlist se encarga de evitar duplicados
-        it->second->listaPosteo->add(doc_id);
+    for (int doc = desde; doc < hasta; ++doc) {
+        setLongitudDocumento(doc + desplazamiento, origen.getLongitudDocumento(doc));
     }
 }
 
+void InvertedIndex::sellarListas() {
+    for (TermEntry* entrada : entradas) {
+        entrada->listaPosteo->sellar();
+    }
+}
+
+void InvertedIndex::setLongitudDocumento(int doc_id, int longitud) {
+    if (doc_id < 0) {
+        return;
+    }
+    if (doc_id >= static_cast<int>(longitudDocumentos.size())) {
+        longitudDocumentos.resize(doc_id + 1, 0);
+    }
+    sumaLongitudes += longitud - longitudDocumentos[doc_id];
+    longitudDocumentos[doc_id] = longitud;
+}
+
+int InvertedIndex::getLongitudDocumento(int doc_id) const {
+    if (doc_id < 0 || doc_id >= static_cast<int>(longitudDocumentos.size())) {
+        return 0;
+    }
+    return longitudDocumentos[doc_id];
+}
+
 // busca la lista de posteo de un temrino 
-const LinkedList<int>* InvertedIndex::search(const std::string& termino) const {
-    auto it = vocabulario.find(termino);
-    if (it != vocabulario.end()) {
-        return it->second->listaPosteo; // devolver la lista de posteo
+const ListaPosteo* InvertedIndex::search(std::string_view termino) const {
+    const TermEntry* entrada = buscarEntrada(termino);
+    if (entrada != nullptr) {
+        return entrada->listaPosteo; // devolver la lista de posteo
+    }
+    if (snapshot == nullptr) {
+        return nullptr; // termino no encontrado
+    }
+
+    // buscar en el snapshot, la vista se crea solo la primera vez
+    std::lock_guard<std::mutex> lock(mutexVistas);
+    auto vista = vistasSnapshot.find(std::string(termino));
+    if (vista != vistasSnapshot.end()) {
+        return vista->second->listaPosteo;
+    }
+    int indice = snapshot->buscarTermino(termino);
+    if (indice < 0) {
+        return nullptr;
+    }
+    TermEntry* vistaNueva = new TermEntry(snapshot->crearVistaLista(indice));
+    vistasSnapshot[std::string(termino)] = vistaNueva;
+    return vistaNueva->listaPosteo;
+}
+
+bool InvertedIndex::cargarSnapshot(const std::string& filename, std::map<int, double>& pageRank, uint64_t huellaOrigen) {
+    if (modoPosicional) {
+        return false; // el snapshot no guarda posiciones
+    }
+    SnapshotIndice* nuevo = new SnapshotIndice();
+    if (!nuevo->abrir(filename)) {
+        delete nuevo;
+        return false;
+    }
+    if (nuevo->getHuellaOrigen() != huellaOrigen) {
+        std::cerr << "[SNAPSHOT] " << filename << " se armo con otros archivos o parametros, se reconstruye" << std::endl;
+        delete nuevo;
+        return false;
+    }
+
+    // el snapshot reemplaza todo lo que hubiera en el indice
+    for (TermEntry* entrada : entradas) {
+        delete entrada;
+    }
+    entradas.clear();
+    diccionario.clear();
+    for (const auto& vista_pair : vistasSnapshot) {
+        delete vista_pair.second;
+    }
+    vistasSnapshot.clear();
+    delete snapshot;
+    snapshot = nuevo;
+
+    longitudDocumentos.assign(snapshot->getNumDocumentos(), 0);
+    sumaLongitudes = 0;
+    for (int doc = 0; doc < snapshot->getNumDocumentos(); ++doc) {
+        longitudDocumentos[doc] = snapshot->getLongitudDocumento(doc);
+        sumaLongitudes += longitudDocumentos[doc];
+    }
+    pageRank = snapshot->leerPageRank();
+    return true;
+}
+
+// pasa al vocabulario todos los terminos que todavia estan solo en el snapshot
+void InvertedIndex::cargarTodoDelSnapshot() {
+    if (snapshot == nullptr) {
+        return;
+    }
+    for (int i = 0; i < snapshot->getNumTerminos(); ++i) {
+        obtenerEntrada(snapshot->getTermino(i));
     }
-    return nullptr; // termino no encontrado
 }
 
-// funcion auxiliar para interseccion de dos listas de posteo
-LinkedList<int>* InvertedIndex::interseccionListaPosteo(const LinkedList<int>* lista1, const LinkedList<int>* lista2) const {
+bool InvertedIndex::guardarSnapshot(const std::string& filename, const std::map<int, double>& pageRank, uint64_t huellaOrigen) {
+    // si el indice viene de un snapshot, las listas que no se tocaron siguen siendo vistas
+    // sobre el archivo viejo; se escriben desde ahi, asi que no se puede pisar el mismo archivo
+    if (modoPosicional) {
+        std::cerr << "Aviso: el snapshot no guarda posiciones, no se escribe en modo posicional." << std::endl;
+        return false;
+    }
+    cargarTodoDelSnapshot();
+    return SnapshotIndice::escribir(filename, *this, pageRank, huellaOrigen);
+}
+
+// funcion auxiliar para interseccion de una lista de resultados con una lista de posteo
+// por cada doc de lista1 se avanza el iterador de lista2, saltando los bloques que no sirven
+LinkedList<int>* InvertedIndex::interseccionListaPosteo(const LinkedList<int>* lista1, const ListaPosteo* lista2) const {
     if (lista1 == nullptr || lista2 == nullptr) {
         return nullptr;
     }
 
     LinkedList<int>* resultado = new LinkedList<int>();
     Node<int>* p1 = lista1->getHead();
-    Node<int>* p2 = lista2->getHead();
-
-    while (p1 != nullptr && p2 != nullptr) {
-        if (p1->data == p2->data) {
-            resultado->add(p1->data); // aniadir el documento comun
-            p1 = p1->next;
-            p2 = p2->next;
-    } else if (p1->data < p2->data) {
-        p1 = p1->next;
-    } else {
-        p2 = p2->next;
+    ListaPosteo::Iterador p2 = lista2->begin();
+
+    while (p1 != nullptr && p2.valido()) {
+        p2.avanzarA(p1->data);
+        if (!p2.valido()) {
+            break;
+        }
+        if (p2.docId() == p1->data) {
+            resultado->agregarAlFinal(p1->data); // aniadir el documento comun
+            p2.siguiente();
         }
+        p1 = p1->next;
     }
     return resultado;
 }
 
-// busca documentos que contengan TODOS los temrinos usand AND y intersecciones
+// busca documentos que contengan TODOS los temrinos (AND). se corta apenas falta un termino,
+// el resto (orden por df y estrategia de interseccion) lo decide Interseccion
 LinkedList<int>* InvertedIndex::search(const std::vector<std::string>& terminos) const {
+    LinkedList<int>* resultado = new LinkedList<int>();
     if (terminos.empty()) {
-        return new LinkedList<int>(); // devover una lista vacia si no hay terminos
+        return resultado; // devover una lista vacia si no hay terminos
     }
 
-    // obtener la primera lista de posteo
-    LinkedList<int>* resultadoActual = nullptr;
-    const LinkedList<int>* primeraLista = search(terminos[0]);
-    if (primeraLista) {
-        // hacer copia de la lista
-        resultadoActual = new LinkedList<int>();
-        Node<int>* nodoTermporal = primeraLista->getHead();
-        while (nodoTermporal != nullptr) {
-            resultadoActual->add(nodoTermporal->data);
-            nodoTermporal = nodoTermporal->next;
+    std::vector<const ListaPosteo*> listas;
+    listas.reserve(terminos.size());
+    for (const std::string& termino : terminos) {
+        const ListaPosteo* lista = search(termino);
+        if (lista == nullptr) {
+            return resultado;
         }
-    } else {
-        return new LinkedList<int>();
+        listas.push_back(lista);
+    }
+
+    for (int doc_id : Interseccion::intersectar(listas)) {
+        resultado->agregarAlFinal(doc_id); // ya vienen ordenados y sin repetidos
+    }
+    return resultado;
+}
+
+// termino de una consulta posicional con su iterador sobre la lista de posteo
+struct TerminoPosicional {
+    const TermEntry* entrada;
+    int desplazamiento; // posicion del termino dentro de la frase
+    ListaPosteo::Iterador it;
+    std::vector<uint32_t> posiciones; // del doc actual, se leen solo si hacen falta
+
+    TerminoPosicional(const TermEntry* e, int d) : entrada(e), desplazamiento(d), it(e->listaPosteo->begin()) {}
+
+    void leerPosiciones(int doc_id) {
+        it.avanzarA(doc_id); // el doc esta seguro, salio de la interseccion
+        posiciones.clear();
+        entrada->posiciones->leer(it.ordinal(), posiciones);
+    }
+};
+
+// arma los terminos ordenados por df (el mas raro primero) y la interseccion de sus docs.
+// retorna false si falta algun termino
+static bool prepararConsultaPosicional(const std::vector<const TermEntry*>& encontrados,
+                                       const std::vector<std::pair<std::string, int>>& terminos,
+                                       std::vector<TerminoPosicional>& salida, std::vector<int>& docs) {
+    std::vector<const ListaPosteo*> listas;
+    for (size_t i = 0; i < terminos.size(); ++i) {
+        if (encontrados[i] == nullptr || encontrados[i]->posiciones == nullptr) {
+            return false;
+        }
+        salida.emplace_back(encontrados[i], terminos[i].second);
+        listas.push_back(encontrados[i]->listaPosteo);
+    }
+    std::stable_sort(salida.begin(), salida.end(), [](const TerminoPosicional& a, const TerminoPosicional& b) {
+        return a.entrada->listaPosteo->getSize() < b.entrada->listaPosteo->getSize();
+    });
+    docs = Interseccion::intersectar(listas);
+    return true;
+}
+
+// por cada doc de la interseccion se leen las posiciones del termino mas raro y se
+// quedan los inicios de frase candidatos; los demas terminos se leen solo mientras
+// quede algun candidato
+std::vector<int> InvertedIndex::buscarFrase(const std::vector<std::pair<std::string, int>>& terminos) const {
+    std::vector<int> resultado;
+    std::vector<const TermEntry*> encontrados;
+    for (const auto& termino : terminos) {
+        encontrados.push_back(buscarEntrada(termino.first));
+    }
+    std::vector<TerminoPosicional> ordenados;
+    std::vector<int> docs;
+    if (terminos.empty() || !modoPosicional || !prepararConsultaPosicional(encontrados, terminos, ordenados, docs)) {
+        return resultado;
     }
 
-    // intersecta con las listas de los demas terminoss
-    for (size_t i = 1; i < terminos.size(); ++i) {
-        const LinkedList<int>* nuevaLista = search(terminos[i]);
-        if (!nuevaLista) {
-            delete resultadoActual;
-            return new LinkedList<int>();
+    std::vector<uint32_t> candidatos;
+    for (int doc_id : docs) {
+        TerminoPosicional& primero = ordenados[0];
+        primero.leerPosiciones(doc_id);
+        candidatos.clear();
+        for (uint32_t p : primero.posiciones) {
+            if (p >= static_cast<uint32_t>(primero.desplazamiento)) {
+                candidatos.push_back(p - primero.desplazamiento); // inicio de la frase
+            }
         }
 
-        LinkedList<int>* nuevaInterseccion = interseccionListaPosteo(resultadoActual, nuevaLista);
-        delete resultadoActual;
-        resultadoActual = nuevaInterseccion;
+        for (size_t t = 1; t < ordenados.size() && !candidatos.empty(); ++t) {
+            TerminoPosicional& termino = ordenados[t];
+            termino.leerPosiciones(doc_id);
+            // merge entre los inicios candidatos y las posiciones corridas del termino
+            size_t quedan = 0;
+            size_t j = 0;
+            for (uint32_t inicio : candidatos) {
+                uint32_t buscada = inicio + termino.desplazamiento;
+                while (j < termino.posiciones.size() && termino.posiciones[j] < buscada) {
+                    j++;
+                }
+                if (j == termino.posiciones.size()) {
+                    break;
+                }
+                if (termino.posiciones[j] == buscada) {
+                    candidatos[quedan++] = inicio;
+                }
+            }
+            candidatos.resize(quedan);
+        }
+        if (!candidatos.empty()) {
+            resultado.push_back(doc_id);
+        }
+    }
+    return resultado;
+}
 
-        if (resultadoActual->getSize() == 0) {
-            return resultadoActual;
+// ventana minima que cubre todos los terminos: se avanza siempre el termino con la
+// posicion mas chica, como en un merge de k listas
+std::vector<int> InvertedIndex::buscarProximidad(const std::vector<std::string>& terminos, int distanciaMaxima) const {
+    std::vector<int> resultado;
+    std::vector<std::pair<std::string, int>> distintos;
+    for (const std::string& termino : terminos) {
+        bool repetido = false;
+        for (const auto& d : distintos) {
+            repetido = repetido || d.first == termino;
+        }
+        if (!repetido) {
+            distintos.push_back({termino, 0});
         }
     }
-    return resultadoActual;
+    std::vector<const TermEntry*> encontrados;
+    for (const auto& termino : distintos) {
+        encontrados.push_back(buscarEntrada(termino.first));
+    }
+    std::vector<TerminoPosicional> ordenados;
+    std::vector<int> docs;
+    if (distintos.empty() || !modoPosicional || !prepararConsultaPosicional(encontrados, distintos, ordenados, docs)) {
+        return resultado;
+    }
+
+    std::vector<size_t> actual(ordenados.size());
+    for (int doc_id : docs) {
+        bool faltan = false;
+        for (TerminoPosicional& termino : ordenados) {
+            termino.leerPosiciones(doc_id);
+            faltan = faltan || termino.posiciones.empty(); // doc agregado sin posiciones
+        }
+        std::fill(actual.begin(), actual.end(), 0);
+        while (!faltan) {
+            size_t menor = 0;
+            uint32_t minimo = ordenados[0].posiciones[actual[0]];
+            uint32_t maximo = minimo;
+            for (size_t t = 1; t < ordenados.size(); ++t) {
+                uint32_t p = ordenados[t].posiciones[actual[t]];
+                if (p < minimo) {
+                    minimo = p;
+                    menor = t;
+                }
+                maximo = std::max(maximo, p);
+            }
+            if (maximo - minimo <= static_cast<uint32_t>(distanciaMaxima)) {
+                resultado.push_back(doc_id);
+                break;
+            }
+            if (++actual[menor] == ordenados[menor].posiciones.size()) {
+                break;
+            }
+        }
+    }
+    return resultado;
 }
 
 void InvertedIndex::printIndex() const {
     std::cout << "\n---Indice Invertido---" << std::endl;
-    for (const auto& vocab_pair : vocabulario) {
-    const std::string& termino = vocab_pair.first;
-    TermEntry* termEntry = vocab_pair.second;
+    // terminos del vocabulario (ya ordenados por el diccionario) y del snapshot juntos, en orden
+    std::vector<std::pair<std::string_view, const ListaPosteo*>> terminos;
+    for (uint32_t id : diccionario.ordenados()) {
+        terminos.push_back({diccionario.getTermino(id), entradas[id]->listaPosteo});
+    }
+    if (snapshot != nullptr) {
+        for (int i = 0; i < snapshot->getNumTerminos(); ++i) {
+            std::string_view termino = snapshot->getTermino(i);
+            if (diccionario.buscar(termino) == DiccionarioTerminos::NO_ENCONTRADO) {
+                terminos.push_back({termino, search(termino)});
+            }
+        }
+        std::sort(terminos.begin(), terminos.end());
+    }
+    for (const auto& vocab_pair : terminos) {
+    std::string_view termino = vocab_pair.first;
+    const ListaPosteo* listaPosteo = vocab_pair.second;
 
     std::cout << "Termino: '" << termino << "' -> Documentos: [";
-    Node<int>* nodoActual = termEntry->listaPosteo->getHead();
-    while (nodoActual != nullptr) {
-        std::cout << nodoActual->data;
-        if (nodoActual->next != nullptr) {
-        std::cout << ", ";
-    }
-        nodoActual = nodoActual->next;
+    bool primero = true;
+    for (ListaPosteo::Iterador it = listaPosteo->begin(); it.valido(); it.siguiente()) {
+        if (!primero) {
+            std::cout << ", ";
+        }
+        std::cout << it.docId();
+        primero = false;
     }
     std::cout << "]" << std::endl;
     }
     std::cout << "------------------" << std::endl;
-}
\ No newline at end of file
+}
+
+// reporte de memoria de las listas de posteo comprimidas vs la LinkedList<int> anterior
+void InvertedIndex::printEstadisticasMemoria() const {
+    long long totalPosteos = 0;
+    size_t bytesComprimidos = 0;
+    long long totalPosiciones = 0;
+    size_t bytesPosiciones = 0;
+    size_t bytesMapa = 0;
+    for (uint32_t id = 0; id < diccionario.size(); ++id) {
+        const TermEntry* entrada = entradas[id];
+        totalPosteos += entrada->listaPosteo->getSize();
+        bytesComprimidos += entrada->listaPosteo->bytesUsados();
+        if (entrada->posiciones != nullptr) {
+            totalPosiciones += entrada->posiciones->getNumPosiciones();
+            bytesPosiciones += entrada->posiciones->bytesUsados();
+        }
+        // std::string con mas de 15 caracteres reserva el texto aparte
+        if (diccionario.getTermino(id).size() > 15) {
+            bytesMapa += diccionario.getTermino(id).size() + 1 + 16;
+        }
+    }
+
+    // cada Node<int> era una reserva de heap aparte (~16 bytes de overhead de malloc)
+    const size_t OVERHEAD_MALLOC = 16;
+    size_t bytesLinkedList = totalPosteos * (sizeof(Node<int>) + OVERHEAD_MALLOC)
+                           + entradas.size() * sizeof(LinkedList<int>);
+    // el vocabulario antes era un std::map<std::string, TermEntry*>: cada nodo lleva
+    // 32 bytes de enlaces y color del arbol + el par, en su propia reserva
+    bytesMapa += entradas.size() * (32 + sizeof(std::pair<const std::string, TermEntry*>) + OVERHEAD_MALLOC);
+
+    std::cout << "\n---Memoria de listas de posteo---" << std::endl;
+    std::cout << "Terminos: " << entradas.size() << ", posteos: " << totalPosteos << std::endl;
+    std::cout << "Diccionario de terminos: " << diccionario.bytesUsados() << " bytes (std::map estimado: "
+              << bytesMapa << " bytes)" << std::endl;
+    if (totalPosteos > 0) {
+        std::cout << "LinkedList<int> (antes): " << bytesLinkedList << " bytes, "
+                  << (double)bytesLinkedList / totalPosteos << " bytes/posteo" << std::endl;
+        std::cout << "ListaPosteo (ahora): " << bytesComprimidos << " bytes, "
+                  << (double)bytesComprimidos / totalPosteos << " bytes/posteo" << std::endl;
+    }
+    if (modoPosicional && totalPosiciones > 0) {
+        std::cout << "Posiciones: " << totalPosiciones << ", " << bytesPosiciones << " bytes, "
+                  << (double)bytesPosiciones / totalPosiciones << " bytes/posicion" << std::endl;
+    }
+    if (snapshot != nullptr) {
+        std::cout << "Snapshot mapeado: " << snapshot->getNumTerminos() << " terminos, "
+                  << snapshot->getTamanio() << " bytes (listas leidas bajo demanda: " << vistasSnapshot.size() << ")" << std::endl;
+    }
+    std::cout << "---------------------------------" << std::endl;
+}
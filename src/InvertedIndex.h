@@ -2,45 +2,108 @@
 #define INVERTED_INDEX_H
 
 #include <string>
-#include <map> // para el vocabulario (palabra -> TermEntry*)
+#include <map>
 #include <vector>
 #include <algorithm>
 #include <iostream>
 #include <set>
 #include <numeric>
+#include <mutex>
 
+#include "DiccionarioTerminos.h"
 #include "LinkedList.h"
+#include "ListaPosteo.h"
+#include "ListaPosiciones.h"
 #include "Node.h"
 
 
 struct TermEntry {
     // std::string termino;
-    LinkedList<int>* listaPosteo;
+    ListaPosteo* listaPosteo;
+    ListaPosiciones* posiciones; // solo en modo posicional
 
-    TermEntry() : listaPosteo(new LinkedList<int>()) {} // Constructor
+    TermEntry() : listaPosteo(new ListaPosteo()), posiciones(nullptr) {} // Constructor
+    explicit TermEntry(ListaPosteo* lista) : listaPosteo(lista), posiciones(nullptr) {} // toma la lista (vista del snapshot)
     ~TermEntry() {
         delete listaPosteo;
+        delete posiciones;
     }
 };
 
 
+class SnapshotIndice;
+
 class InvertedIndex {
 public:
     InvertedIndex();
     ~InvertedIndex();
 
-    void addDocumento(const std::string& termino, int doc_id);
+    void addDocumento(const std::string& termino, int doc_id, int frecuencia = 1);
+    // agrega los primeros numDocs documentos de un indice parcial, sumando desplazamientoDocs a sus ids
+    void agregarParcial(const InvertedIndex& parcial, int desplazamientoDocs, int numDocs);
+    // agrega los docs [desde, hasta) de otro indice con ids desde primerDocDestino (un segmento
+    // por rango de documentos, o varios segmentos seguidos en uno). el origen no se modifica,
+    // puede venir de un snapshot
+    void agregarRango(const InvertedIndex& origen, int desde, int hasta, int primerDocDestino = 0);
+    // comprime el bloque abierto de cada lista (un segmento que ya no recibe docs)
+    void sellarListas();
+
+    // cantidad de terminos indexados de cada documento (sin stopwords)
+    void setLongitudDocumento(int doc_id, int longitud);
+    int getLongitudDocumento(int doc_id) const;
+    int getNumDocumentos() const { return static_cast<int>(longitudDocumentos.size()); }
+    long long getSumaLongitudes() const { return sumaLongitudes; }
+    double getLongitudPromedio() const { return longitudDocumentos.empty() ? 0.0 : (double)sumaLongitudes / longitudDocumentos.size(); }
+
+    // modo posicional: ademas de la frecuencia se guardan las posiciones de cada termino en
+    // cada doc (se activa con el indice vacio). los docs tienen que llegar en orden creciente
+    void setModoPosicional(bool activo);
+    bool esPosicional() const { return modoPosicional; }
+    // agrega el doc con frecuencia = cantidad de posiciones
+    void addDocumentoConPosiciones(const std::string& termino, int doc_id, const uint32_t* posiciones, int cantidad);
+
+    // frase: docs donde cada termino aparece en su posicion relativa (segundo valor del par,
+    // la posicion del termino en la consulta). proximidad: docs donde todos los terminos
+    // caen en una ventana de a lo sumo distanciaMaxima posiciones. primero se intersectan
+    // los doc ids y las posiciones se leen solo para los docs que quedan
+    std::vector<int> buscarFrase(const std::vector<std::pair<std::string, int>>& terminos) const;
+    std::vector<int> buscarProximidad(const std::vector<std::string>& terminos, int distanciaMaxima) const;
 
-    const LinkedList<int>* search(const std::string& termino) const;
+    const ListaPosteo* search(std::string_view termino) const;
     LinkedList<int>* search(const std::vector<std::string>& terminos) const;
 
+    // snapshot binario del indice + pagerank. al cargar, las listas no se leen: se crean
+    // vistas sobre el archivo mapeado la primera vez que se busca cada termino. huellaOrigen
+    // es la de SnapshotIndice::huellaOrigen: un snapshot con otra huella no se carga
+    bool cargarSnapshot(const std::string& filename, std::map<int, double>& pageRank, uint64_t huellaOrigen);
+    bool guardarSnapshot(const std::string& filename, const std::map<int, double>& pageRank, uint64_t huellaOrigen);
+    bool tieneSnapshot() const { return snapshot != nullptr; }
+
     void printIndex() const;
+    void printEstadisticasMemoria() const;
 
-    const std::map<std::string, TermEntry*>& getVocabulario() const { return vocabulario; } // para proyectyo 2
-    LinkedList<int>* interseccionListaPosteo(const LinkedList<int>* lista1, const LinkedList<int>* lista2) const;
+    // vocabulario: el id de cada termino es su posicion en las entradas
+    const DiccionarioTerminos& getDiccionario() const { return diccionario; }
+    const TermEntry* getEntrada(uint32_t id) const { return entradas[id]; }
+    LinkedList<int>* interseccionListaPosteo(const LinkedList<int>* lista1, const ListaPosteo* lista2) const;
 
 private:
-    std::map<std::string, TermEntry*> vocabulario;
+    DiccionarioTerminos diccionario;
+    std::vector<TermEntry*> entradas; // por id de termino
+    std::vector<int> longitudDocumentos;
+    long long sumaLongitudes;
+    bool modoPosicional;
+
+    SnapshotIndice* snapshot;
+    // vistas del snapshot ya creadas por search, se guardan para no crearlas de nuevo
+    mutable std::map<std::string, TermEntry*> vistasSnapshot;
+    mutable std::mutex mutexVistas;
+
+    TermEntry* obtenerEntrada(std::string_view termino);
+    void agregarLista(std::string_view termino, const ListaPosteo* lista, const ListaPosiciones* posicionesOrigen,
+                      int desde, int hasta, int desplazamientoDocs);
+    const TermEntry* buscarEntrada(std::string_view termino) const; // sin mirar el snapshot
+    void cargarTodoDelSnapshot();
 };
 
 #endif
\ No newline at end of file
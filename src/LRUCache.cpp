@@ -1,97 +1,108 @@
 #include "LRUCache.h"
+#include "PoliticasCache.h"
 #include <iostream>
 
 // CONSTRUCTOR setea los campos y punteros
-LRUNode::LRUNode(const std::string& k, LinkedList<int>* v)
-    : key(k), value(v), hitCount(0), prev(nullptr), next(nullptr) {}
-
-// CONSTRUCTOR inicializa el cache,  crea los nodos dumy
-LRUCache::LRUCache(int cap)
-    : cache(cap), capacidad(cap), actualSize(0), totalHits(0),
-      totalMisses(0), totalReemplazos(0), totalInserciones(0) {
-    head = new LRUNode("", nullptr);
-    tail = new LRUNode("", nullptr);
-    head->next = tail;
-    tail->prev = head;
-}
+LRUNode::LRUNode(const std::string& k, ResultadoCache v)
+    : key(k), value(std::move(v)), hitCount(0), prev(nullptr), next(nullptr), segmento(0) {}
 
-// DESTRUCTOR libera todos los nodos y vlaores
-LRUCache::~LRUCache() {
-    LRUNode* current = head;
-    while (current != nullptr) {
-        LRUNode* next = current->next;
-        if (current->value != nullptr) {
-            delete current->value;
-        }
-        delete current;
-        current = next;
-    }
-}
+// CONSTRUCTOR inicializa el cache con la politica pedida
+LRUCache::LRUCache(int cap, int tipo, size_t presupuesto)
+    : cache(cap), politica(crearPoliticaCache(tipo, cap)), tipoPolitica(tipo), capacidad(cap), actualSize(0),
+      totalHits(0), totalMisses(0), totalReemplazos(0), totalInserciones(0),
+      presupuestoBytes(presupuesto), bytesUsados(0), bytesDesalojados(0) {}
 
-void LRUCache::addToFront(LRUNode* node) {
-    node->next = head->next;
-    node->prev = head;
-    head->next->prev = node;
-    head->next = node;
+// DESTRUCTOR libera todos los nodos
+LRUCache::~LRUCache() {
+    clear();
+    delete politica;
 }
 
-void LRUCache::removeNode(LRUNode* node) {
-    node->prev->next = node->next;
-    node->next->prev = node->prev;
+// nodo + slot de la tabla (entrada y byte de control) + texto de la clave, que esta en el
+// nodo y en la tabla, si no entra en el string (libstdc++ guarda hasta 15 chars adentro)
+// + resultado y su bloque de conteo de referencias (make_shared lo pone junto al objeto:
+// puntero a la vtable y dos contadores)
+size_t LRUCache::costoEntrada(const std::string& key, const ResultadoCache& value) {
+    size_t costo = sizeof(LRUNode) + sizeof(HashEntry<std::string, LRUNode*>) + 1;
+    if (key.size() > 15) {
+        costo += 2 * (key.size() + 1);
+    }
+    if (value) {
+        costo += value->bytesUsados() + 2 * sizeof(void*);
+    }
+    return costo;
 }
 
-void LRUCache::moveToFront(LRUNode* node) {
-    removeNode(node);
-    addToFront(node);
+// saca de la tabla y libera los nodos que la politica mando a desalojar
+void LRUCache::borrarDesalojados() {
+    for (LRUNode* nodo : desalojados) {
+        size_t costo = costoEntrada(nodo->key, nodo->value);
+        bytesUsados -= costo;
+        bytesDesalojados += costo;
+        cache.remove(nodo->key);
+        delete nodo;
+        actualSize--;
+        totalReemplazos++;
+    }
+    desalojados.clear();
 }
 
-LRUNode* LRUCache::removeLast() {
-    LRUNode* last = tail->prev;
-    removeNode(last);
-    return last;
+void LRUCache::ajustarAlPresupuesto() {
+    while (presupuestoBytes > 0 && bytesUsados > presupuestoBytes && actualSize > 0) {
+        politica->desalojarUno(desalojados);
+        if (desalojados.empty()) {
+            break;
+        }
+        borrarDesalojados();
+    }
 }
 
 // busca un valor en la cache por clave
-LinkedList<int>* LRUCache::get(const std::string& key) {
+ResultadoCache LRUCache::get(std::string_view key) {
     LRUNode** nodePtr = cache.search(key);
-    if (nodePtr && *nodePtr) {
+    LRUNode* nodo = nodePtr ? *nodePtr : nullptr;
+    politica->acceso(key, nodo);
+    if (nodo) {
         // hace hit
         totalHits++;
-        (*nodePtr)->hitCount++;
-        moveToFront(*nodePtr);
-        return (*nodePtr)->value;
+        nodo->hitCount++;
+        return nodo->value;
     }
     // hace miss
     totalMisses++;
-    return nullptr;
+    return ResultadoCache();
 }
 
 // intersta o actualza el valor del cache
-void LRUCache::put(const std::string& key, LinkedList<int>* value) {
+void LRUCache::put(const std::string& key, ResultadoCache value) {
+    if (presupuestoBytes > 0 && costoEntrada(key, value) > presupuestoBytes) {
+        return; // ni con la cache vacia entraria
+    }
     LRUNode** nodePtr = cache.search(key);
     if (nodePtr && *nodePtr) {
-        // si ya existe lo borra
-        delete (*nodePtr)->value;
-        (*nodePtr)->value = value;
-        moveToFront(*nodePtr);
+        // si ya existe reemplaza el resultado
+        bytesUsados -= costoEntrada((*nodePtr)->key, (*nodePtr)->value);
+        (*nodePtr)->value = std::move(value);
+        bytesUsados += costoEntrada((*nodePtr)->key, (*nodePtr)->value);
+        politica->acceso(key, *nodePtr);
     } else {
-        LRUNode* newNode = new LRUNode(key, value);
-        if (actualSize >= capacidad) {
-            // si esta llena borra el menos reciente
-            LRUNode* last = removeLast();
-            cache.remove(last->key);
-            delete last->value;
-            delete last;
-            actualSize--;
-            totalReemplazos++;
-        }
-        // inserta el nuevo nodo al frente y en la tabla hash
-        addToFront(newNode);
+        // la politica puede desalojar otros nodos o no admitir el nuevo (W-TinyLFU),
+        // en ese caso el nuevo sale enseguida y cuenta como reemplazo
+        LRUNode* newNode = new LRUNode(key, std::move(value));
         cache.insert(key, newNode);
         actualSize++;
+        bytesUsados += costoEntrada(newNode->key, newNode->value);
         totalInserciones++;
-        trackerConsulta.push_back(key);
+        politica->insertar(newNode, desalojados);
+        borrarDesalojados();
     }
+    ajustarAlPresupuesto();
+}
+
+const LRUNode* LRUCache::masReciente() const {
+    std::vector<const LRUNode*> recientes;
+    politica->listar(recientes, 1);
+    return recientes.empty() ? nullptr : recientes[0];
 }
 
 void LRUCache::printCacheState() const {
@@ -99,14 +110,13 @@ void LRUCache::printCacheState() const {
     std::cout << "Elementos actuales: " << actualSize << "/" << capacidad << std::endl;
     std::cout << "Hits: " << totalHits << ", Misses: " << totalMisses << std::endl;
 
-    LRUNode* current = head->next;
-    int count = 0;
-    while (current != tail && count < 5) {
-        std::cout << "  " << (count + 1) << ". " << current->key
-                  << " (docs: " << (current->value ? current->value->getSize() : 0)
+    std::vector<const LRUNode*> recientes;
+    politica->listar(recientes, 5);
+    for (size_t i = 0; i < recientes.size(); ++i) {
+        const LRUNode* current = recientes[i];
+        std::cout << "  " << (i + 1) << ". " << current->key
+                  << " (docs: " << (current->value ? current->value->size() : 0)
                   << ", hits: " << current->hitCount << ")" << std::endl;
-        current = current->next;
-        count++;
     }
     if (actualSize > 5) {
         std::cout << "  ... y " << (actualSize - 5) << " mas" << std::endl;
@@ -132,17 +142,14 @@ double LRUCache::getMissRate() const {
 }
 
 void LRUCache::clear() {
-    LRUNode* current = head->next;
-    while (current != tail) {
-        LRUNode* next = current->next;
-        delete current->value;
-        delete current;
-        current = next;
+    std::vector<LRUNode*> nodos;
+    politica->vaciar(nodos);
+    for (LRUNode* nodo : nodos) {
+        delete nodo;
     }
-    head->next = tail;
-    tail->prev = head;
+    cache.clear();
     actualSize = 0;
-    trackerConsulta.clear();
+    bytesUsados = 0;
 }
 
 bool LRUCache::isEmpty() const {
@@ -155,16 +162,10 @@ bool LRUCache::isFull() const {
 
 void LRUCache::setCapacity(int nuevaCapacidad) {
     capacidad = nuevaCapacidad;
-    while (actualSize> capacidad) {
-        LRUNode* last = removeLast();
-        cache.remove(last->key);
-        delete last->value;
-        delete last;
-        actualSize--;
-        totalReemplazos++;
-    }
+    politica->setCapacidad(nuevaCapacidad, desalojados);
+    borrarDesalojados();
 }
 
 int LRUCache::getCapacity() const {
     return capacidad;
-}
\ No newline at end of file
+}
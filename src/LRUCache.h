@@ -1,45 +1,66 @@
 #ifndef LRU_CACHE_H
 #define LRU_CACHE_H
 
+#include <cstddef>
 #include <string>
+#include <string_view>
 #include <vector>
 #include "HashTable.h"
-#include "LinkedList.h"
+#include "ResultadoComprimido.h"
+
+// politicas de reemplazo de la cache (ver PoliticasCache.h)
+#define POLITICA_LRU 0
+#define POLITICA_SLRU 1
+#define POLITICA_ARC 2
+#define POLITICA_TINYLFU 3
 
 struct LRUNode {
     std::string key;
-    LinkedList<int>* value;
+    ResultadoCache value;
     int hitCount;
     LRUNode* prev;
     LRUNode* next;
+    int segmento; // lista de la politica en la que esta el nodo
 
-    LRUNode(const std::string& k, LinkedList<int>* v);
+    LRUNode(const std::string& k, ResultadoCache v);
 };
 
+class PoliticaCache;
+
+// cache de resultados: la tabla hash guarda los nodos y la politica decide el orden,
+// que entra y que sale. el nombre quedo de cuando solo habia LRU.
+// ademas del limite de entradas puede tener un presupuesto en bytes (clave, nodo, slot
+// de la tabla y resultado comprimido): si se pasa, se desaloja en el orden de la politica
+// hasta volver a entrar. un resultado que solo no entra en el presupuesto no se guarda
 class LRUCache {
 private:
     HashTable<std::string, LRUNode*> cache;
-    LRUNode* head;
-    LRUNode* tail;
+    PoliticaCache* politica;
+    int tipoPolitica;
     int capacidad;
     int actualSize;
     int totalHits;
     int totalMisses;
     int totalReemplazos;
     int totalInserciones;
-    std::vector<std::string> trackerConsulta;
+    size_t presupuestoBytes; // 0 = sin limite de bytes
+    size_t bytesUsados;
+    long long bytesDesalojados;
+    std::vector<LRUNode*> desalojados; // se reutiliza entre puts
 
-    void addToFront(LRUNode* node);
-    void removeNode(LRUNode* node);
-    void moveToFront(LRUNode* node);
-    LRUNode* removeLast();
+    void borrarDesalojados();
+    void ajustarAlPresupuesto();
 
 public:
-    LRUCache(int cap = 20);
+    LRUCache(int cap = 20, int tipoPolitica = POLITICA_LRU, size_t presupuestoBytes = 0);
     ~LRUCache();
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
 
-    LinkedList<int>* get(const std::string& key);
-    void put(const std::string& key, LinkedList<int>* value);
+    // la tabla acepta string_view, asi buscar no arma un std::string temporal
+    // el resultado guardado o un puntero vacio si no esta
+    ResultadoCache get(std::string_view key);
+    void put(const std::string& key, ResultadoCache value);
 
     void printCacheState() const;
     int getHits() const;
@@ -55,6 +76,14 @@ public:
     bool isFull() const;
     void setCapacity(int newCapacity);
     int getCapacity() const;
+    int getTipoPolitica() const { return tipoPolitica; }
+    size_t getPresupuestoBytes() const { return presupuestoBytes; }
+    size_t getBytesUsados() const { return bytesUsados; }
+    long long getBytesDesalojados() const { return bytesDesalojados; }
+    // bytes que ocupa una entrada con esta clave y este resultado
+    static size_t costoEntrada(const std::string& key, const ResultadoCache& value);
+    // entrada usada mas recientemente segun la politica, nullptr si esta vacia
+    const LRUNode* masReciente() const;
 };
 
-#endif // LRU_CACHE_H
\ No newline at end of file
+#endif // LRU_CACHE_H
@@ -0,0 +1,123 @@
+#include "LRUCacheConcurrente.h"
+#include "HashTable.h"
+#include <iostream>
+
+// CONSTRUCTOR reparte la capacidad entre los shards (todos con al menos CAPACIDAD_MINIMA_SHARD)
+LRUCacheConcurrente::LRUCacheConcurrente(int cap, int politica, size_t presupuesto, int numShards)
+    : capacidad(cap), presupuestoBytes(presupuesto) {
+    int maxShards = cap / CAPACIDAD_MINIMA_SHARD;
+    if (numShards > maxShards) {
+        numShards = maxShards;
+    }
+    if (numShards < 1) {
+        numShards = 1;
+    }
+    for (int i = 0; i < numShards; ++i) {
+        shards.push_back(new Shard(cap / numShards + (i < cap % numShards ? 1 : 0), politica,
+                                   (presupuesto + numShards - 1) / numShards));
+    }
+}
+
+LRUCacheConcurrente::~LRUCacheConcurrente() {
+    for (Shard* shard : shards) {
+        delete shard;
+    }
+}
+
+// la tabla de cada shard usa los bits bajos del mismo hash, el shard sale de los altos
+LRUCacheConcurrente::Shard& LRUCacheConcurrente::shardDe(std::string_view key) const {
+    if (shards.size() == 1) {
+        return *shards[0];
+    }
+    size_t h = HashPolicy<std::string>()(key);
+    return *shards[(h >> 32) % shards.size()];
+}
+
+ResultadoCache LRUCacheConcurrente::get(std::string_view key) {
+    Shard& shard = shardDe(key);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    return shard.lru.get(key);
+}
+
+void LRUCacheConcurrente::put(const std::string& key, ResultadoCache value) {
+    Shard& shard = shardDe(key);
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.lru.put(key, std::move(value));
+}
+
+template<typename F>
+long long LRUCacheConcurrente::sumar(F metrica) const {
+    long long total = 0;
+    for (const Shard* shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mtx);
+        total += metrica(shard->lru);
+    }
+    return total;
+}
+
+void LRUCacheConcurrente::printCacheState() const {
+    if (shards.size() == 1) {
+        std::lock_guard<std::mutex> lock(shards[0]->mtx);
+        shards[0]->lru.printCacheState();
+        return;
+    }
+    std::cout << "=== Estado de la Cache ===" << std::endl;
+    std::cout << "Elementos actuales: " << getCurrentSize() << "/" << capacidad << std::endl;
+    std::cout << "Hits: " << getHits() << ", Misses: " << getMisses() << std::endl;
+    std::cout << "Shards: " << shards.size() << " (primera entrada de cada uno)" << std::endl;
+    int mostrados = 0;
+    for (size_t i = 0; i < shards.size() && mostrados < 5; ++i) {
+        std::lock_guard<std::mutex> lock(shards[i]->mtx);
+        const LRUNode* reciente = shards[i]->lru.masReciente();
+        if (reciente != nullptr) {
+            std::cout << "  " << (i + 1) << ". " << reciente->key
+                      << " (docs: " << (reciente->value ? reciente->value->size() : 0)
+                      << ", hits: " << reciente->hitCount << ")" << std::endl;
+            mostrados++;
+        }
+    }
+    std::cout << "=========================" << std::endl;
+}
+
+int LRUCacheConcurrente::getHits() const { return static_cast<int>(sumar([](const LRUCache& c) { return c.getHits(); })); }
+int LRUCacheConcurrente::getMisses() const { return static_cast<int>(sumar([](const LRUCache& c) { return c.getMisses(); })); }
+int LRUCacheConcurrente::getReplacements() const { return static_cast<int>(sumar([](const LRUCache& c) { return c.getReplacements(); })); }
+int LRUCacheConcurrente::getInsertions() const { return static_cast<int>(sumar([](const LRUCache& c) { return c.getInsertions(); })); }
+int LRUCacheConcurrente::getCurrentSize() const { return static_cast<int>(sumar([](const LRUCache& c) { return c.getCurrentSize(); })); }
+
+long long LRUCacheConcurrente::getBytesUsados() const {
+    return sumar([](const LRUCache& c) { return static_cast<long long>(c.getBytesUsados()); });
+}
+
+long long LRUCacheConcurrente::getBytesDesalojados() const {
+    return sumar([](const LRUCache& c) { return c.getBytesDesalojados(); });
+}
+
+int LRUCacheConcurrente::getTotalQueries() const {
+    return static_cast<int>(sumar([](const LRUCache& c) { return c.getTotalQueries(); }));
+}
+
+// hits y total contados en la misma pasada, asi las tasas no mezclan momentos distintos
+void LRUCacheConcurrente::contarConsultas(long long& hits, long long& total) const {
+    hits = 0;
+    total = 0;
+    for (const Shard* shard : shards) {
+        std::lock_guard<std::mutex> lock(shard->mtx);
+        hits += shard->lru.getHits();
+        total += shard->lru.getTotalQueries();
+    }
+}
+
+double LRUCacheConcurrente::getHitRate() const {
+    long long hits;
+    long long total;
+    contarConsultas(hits, total);
+    return total > 0 ? (double)hits / total : 0.0;
+}
+
+double LRUCacheConcurrente::getMissRate() const {
+    long long hits;
+    long long total;
+    contarConsultas(hits, total);
+    return total > 0 ? (double)(total - hits) / total : 0.0;
+}
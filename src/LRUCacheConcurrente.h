@@ -0,0 +1,70 @@
+#ifndef LRU_CACHE_CONCURRENTE_H
+#define LRU_CACHE_CONCURRENTE_H
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "LRUCache.h"
+
+// cantidad maxima de shards y capacidad minima de cada uno. con una cache chica queda
+// un solo shard y el reemplazo es exactamente el de la politica sin repartir
+#define NUM_SHARDS_CACHE 16
+#define CAPACIDAD_MINIMA_SHARD 32
+
+// cache para varios hilos: las claves se reparten por hash entre shards, cada uno
+// con su propio LRUCache (tabla + politica de reemplazo) y su mutex. un get solo espera a otra consulta
+// que cayo en el mismo shard, no hay una lista LRU global. los contadores son los de
+// cada shard (protegidos por su mutex) y las metricas los suman
+class LRUCacheConcurrente {
+public:
+    // presupuestoBytes (0 = sin limite) se reparte en partes iguales entre los shards
+    LRUCacheConcurrente(int capacidad = 20, int politica = POLITICA_LRU, size_t presupuestoBytes = 0,
+                        int numShards = NUM_SHARDS_CACHE);
+    ~LRUCacheConcurrente();
+    LRUCacheConcurrente(const LRUCacheConcurrente&) = delete;
+    LRUCacheConcurrente& operator=(const LRUCacheConcurrente&) = delete;
+
+    // referencia al resultado guardado, o vacia si no esta. se toma con el shard bloqueado;
+    // despues sigue valida aunque otro hilo desaloje la entrada
+    ResultadoCache get(std::string_view key);
+    void put(const std::string& key, ResultadoCache value);
+
+    void printCacheState() const;
+    int getHits() const;
+    int getMisses() const;
+    int getReplacements() const;
+    int getInsertions() const;
+    int getCurrentSize() const;
+    int getTotalQueries() const;
+    double getHitRate() const;
+    double getMissRate() const;
+    long long getBytesUsados() const;
+    long long getBytesDesalojados() const;
+    size_t getPresupuestoBytes() const { return presupuestoBytes; }
+    int getCapacity() const { return capacidad; }
+    int getNumShards() const { return static_cast<int>(shards.size()); }
+    int getPolitica() const { return shards[0]->lru.getTipoPolitica(); }
+
+private:
+    // alineado a una linea de cache para que los mutex de shards vecinos no se pisen
+    struct alignas(64) Shard {
+        mutable std::mutex mtx;
+        LRUCache lru;
+
+        Shard(int cap, int politica, size_t presupuesto) : lru(cap, politica, presupuesto) {}
+    };
+
+    std::vector<Shard*> shards;
+    int capacidad;
+    size_t presupuestoBytes;
+
+    Shard& shardDe(std::string_view key) const;
+    template<typename F>
+    long long sumar(F metrica) const;
+    void contarConsultas(long long& hits, long long& total) const;
+};
+
+#endif // LRU_CACHE_CONCURRENTE_H
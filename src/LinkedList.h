@@ -6,10 +6,12 @@
 template <typename T>
 class LinkedList {
 public:
-    LinkedList() : head(nullptr), size(0) {}
+    LinkedList() : head(nullptr), tail(nullptr), size(0) {}
     ~LinkedList();
 
     bool add(T value);
+    // O(1), sin revisar duplicados: para valores que ya se sabe que son unicos (resultados ordenados)
+    void agregarAlFinal(T value);
     bool contains(T value) const;
     Node<T>* getHead() const { return head; }
     int getSize() const { return size; }
@@ -17,6 +19,7 @@ public:
 
 private:
     Node<T>* head;
+    Node<T>* tail;
     int size;
 };
 
@@ -10,19 +10,21 @@ bool LinkedList<T>::add(T value) {
         return false;
     }
 
-    // crea un nodo con el valor pasado y lo inserta en la lista
+    agregarAlFinal(value);
+    return true;
+}
+
+template <typename T>
+void LinkedList<T>::agregarAlFinal(T value) {
+    // crea un nodo con el valor pasado y lo inserta al final de la lista
     Node<T>* nuevoNodo = new Node<T>(value);
     if (!head) {
         head = nuevoNodo;
     } else {
-        Node<T>* actual = head;
-        while (actual->next != nullptr) {
-            actual = actual->next;
-        }
-        actual->next = nuevoNodo;
+        tail->next = nuevoNodo;
     }
+    tail = nuevoNodo;
     size++;
-    return true;
 }
 
 // Implementacion de contains
@@ -52,5 +54,6 @@ void LinkedList<T>::clear() {
         current = nextNode;
     }
     head = nullptr;
+    tail = nullptr;
     size = 0;
 }
\ No newline at end of file
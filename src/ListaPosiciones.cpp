@@ -0,0 +1,73 @@
+#include "ListaPosiciones.h"
+
+static void escribirVarint(std::vector<uint8_t>& salida, uint32_t v) {
+    while (v >= 0x80) {
+        salida.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    salida.push_back(static_cast<uint8_t>(v));
+}
+
+static const uint8_t* leerVarint(const uint8_t* p, uint32_t& v) {
+    uint32_t resultado = 0;
+    int desplazamiento = 0;
+    while (*p & 0x80) {
+        resultado |= static_cast<uint32_t>(*p & 0x7F) << desplazamiento;
+        desplazamiento += 7;
+        p++;
+    }
+    resultado |= static_cast<uint32_t>(*p) << desplazamiento;
+    v = resultado;
+    return p + 1;
+}
+
+// CONSTRUCTOR lista vacia
+ListaPosiciones::ListaPosiciones() : numDocs(0), numPosiciones(0) {}
+
+void ListaPosiciones::agregar(const uint32_t* posiciones, int cantidad) {
+    if (numDocs % ListaPosteo::TAMANIO_BLOQUE == 0) {
+        inicioBloques.push_back(static_cast<uint32_t>(datos.size()));
+    }
+    escribirVarint(datos, static_cast<uint32_t>(cantidad));
+    uint32_t anterior = 0;
+    for (int i = 0; i < cantidad; ++i) {
+        escribirVarint(datos, posiciones[i] - anterior);
+        anterior = posiciones[i];
+    }
+    numDocs++;
+    numPosiciones += cantidad;
+}
+
+void ListaPosiciones::leer(int ordinal, std::vector<uint32_t>& salida) const {
+    salida.clear();
+    if (ordinal < 0 || ordinal >= numDocs) {
+        return;
+    }
+
+    // saltar los docs anteriores del bloque: cada varint termina en un byte con el bit alto en 0
+    const uint8_t* p = datos.data() + inicioBloques[ordinal / ListaPosteo::TAMANIO_BLOQUE];
+    for (int saltar = ordinal % ListaPosteo::TAMANIO_BLOQUE; saltar > 0; --saltar) {
+        uint32_t cantidad;
+        p = leerVarint(p, cantidad);
+        while (cantidad > 0) {
+            if ((*p++ & 0x80) == 0) {
+                cantidad--;
+            }
+        }
+    }
+
+    uint32_t cantidad;
+    p = leerVarint(p, cantidad);
+    salida.resize(cantidad);
+    uint32_t posicion = 0;
+    for (uint32_t i = 0; i < cantidad; ++i) {
+        uint32_t gap;
+        p = leerVarint(p, gap);
+        posicion += gap;
+        salida[i] = posicion;
+    }
+}
+
+size_t ListaPosiciones::bytesUsados() const {
+    return sizeof(ListaPosiciones) + datos.capacity() + inicioBloques.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,36 @@
+#ifndef LISTA_POSICIONES_H
+#define LISTA_POSICIONES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "ListaPosteo.h"
+
+// posiciones de un termino en cada documento de su lista de posteo, en el mismo orden.
+// cada doc se guarda como cantidad + gaps entre posiciones, todo en varint, y cada
+// TAMANIO_BLOQUE docs se anota donde empieza el bloque (igual que los bloques de la lista
+// de posteo), asi para leer un doc solo se saltan los anteriores de su bloque.
+// nada se descomprime hasta que se piden las posiciones de un doc
+class ListaPosiciones {
+public:
+    ListaPosiciones();
+
+    // posiciones (crecientes) del siguiente doc de la lista de posteo
+    void agregar(const uint32_t* posiciones, int cantidad);
+
+    // posiciones del doc numero "ordinal" de la lista (ListaPosteo::Iterador::ordinal)
+    void leer(int ordinal, std::vector<uint32_t>& salida) const;
+
+    int getNumDocs() const { return numDocs; }
+    long long getNumPosiciones() const { return numPosiciones; }
+    size_t bytesUsados() const;
+
+private:
+    std::vector<uint8_t> datos;
+    std::vector<uint32_t> inicioBloques; // offset en datos del primer doc de cada bloque
+    int numDocs;
+    long long numPosiciones;
+};
+
+#endif
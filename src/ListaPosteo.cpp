@@ -0,0 +1,399 @@
+#include "ListaPosteo.h"
+
+#include <algorithm>
+
+// cantidad de bits necesarios para representar v
+static uint8_t bitsNecesarios(uint32_t v) {
+    uint8_t bits = 0;
+    while (v != 0) {
+        bits++;
+        v >>= 1;
+    }
+    return bits;
+}
+
+static size_t tamanioVarint(uint32_t v) {
+    size_t bytes = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        bytes++;
+    }
+    return bytes;
+}
+
+// varint: 7 bits por byte, el bit alto indica que sigue otro byte
+static void escribirVarint(std::vector<uint8_t>& salida, uint32_t v) {
+    while (v >= 0x80) {
+        salida.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    salida.push_back(static_cast<uint8_t>(v));
+}
+
+static const uint8_t* leerVarint(const uint8_t* p, uint32_t& v) {
+    uint32_t resultado = 0;
+    int desplazamiento = 0;
+    while (*p & 0x80) {
+        resultado |= static_cast<uint32_t>(*p & 0x7F) << desplazamiento;
+        desplazamiento += 7;
+        p++;
+    }
+    resultado |= static_cast<uint32_t>(*p) << desplazamiento;
+    v = resultado;
+    return p + 1;
+}
+
+// bitpack: todos los valores del bloque con el mismo ancho, empezando por los bits bajos
+static void escribirBitpack(std::vector<uint8_t>& salida, const uint32_t* valores, int n, uint8_t bits) {
+    uint64_t acumulador = 0;
+    int bitsAcumulados = 0;
+    for (int i = 0; i < n; ++i) {
+        acumulador |= static_cast<uint64_t>(valores[i]) << bitsAcumulados;
+        bitsAcumulados += bits;
+        while (bitsAcumulados >= 8) {
+            salida.push_back(static_cast<uint8_t>(acumulador));
+            acumulador >>= 8;
+            bitsAcumulados -= 8;
+        }
+    }
+    if (bitsAcumulados > 0) {
+        salida.push_back(static_cast<uint8_t>(acumulador));
+    }
+}
+
+static const uint8_t* leerBitpack(const uint8_t* p, uint32_t* valores, int n, uint8_t bits) {
+    if (bits == 0) {
+        std::fill(valores, valores + n, 0);
+        return p;
+    }
+    const uint64_t mascara = (bits == 32) ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+    uint64_t acumulador = 0;
+    int bitsAcumulados = 0;
+    for (int i = 0; i < n; ++i) {
+        while (bitsAcumulados < bits) {
+            acumulador |= static_cast<uint64_t>(*p++) << bitsAcumulados;
+            bitsAcumulados += 8;
+        }
+        valores[i] = static_cast<uint32_t>(acumulador & mascara);
+        acumulador >>= bits;
+        bitsAcumulados -= bits;
+    }
+    return p;
+}
+
+// escribe n valores con el codec que ocupe menos bytes
+static void codificarValores(std::vector<uint8_t>& salida, const uint32_t* valores, int n, uint8_t& codec, uint8_t& bits) {
+    uint32_t maximo = 0;
+    size_t bytesVarint = 0;
+    for (int i = 0; i < n; ++i) {
+        maximo = std::max(maximo, valores[i]);
+        bytesVarint += tamanioVarint(valores[i]);
+    }
+    bits = bitsNecesarios(maximo);
+    size_t bytesBitpack = (static_cast<size_t>(n) * bits + 7) / 8;
+
+    if (bytesBitpack < bytesVarint) {
+        codec = CODEC_BITPACK;
+        escribirBitpack(salida, valores, n, bits);
+    } else {
+        codec = CODEC_VARINT;
+        for (int i = 0; i < n; ++i) {
+            escribirVarint(salida, valores[i]);
+        }
+    }
+}
+
+// lee n valores escritos por codificarValores, retorna donde termina el bloque de valores
+static const uint8_t* decodificarValores(const uint8_t* p, uint32_t* valores, int n, uint8_t codec, uint8_t bits) {
+    if (codec == CODEC_BITPACK) {
+        return leerBitpack(p, valores, n, bits);
+    }
+    for (int i = 0; i < n; ++i) {
+        p = leerVarint(p, valores[i]);
+    }
+    return p;
+}
+
+// CONSTRUCTOR lista vacia
+ListaPosteo::ListaPosteo()
+    : size(0), ultimoDoc(-1), esVista(false), bloquesExternos(nullptr), numBloquesExternos(0),
+      datosExternos(nullptr), bytesDatosExternos(0) {}
+
+// CONSTRUCTOR vista sobre bloques sellados de otro lado
+ListaPosteo::ListaPosteo(const BloquePosteo* b, size_t numBloques, const uint8_t* d, size_t bytesDatos, int s, int ultimo)
+    : size(s), ultimoDoc(ultimo), esVista(true), bloquesExternos(b), numBloquesExternos(numBloques),
+      datosExternos(d), bytesDatosExternos(bytesDatos) {}
+
+// copia los bloques externos a memoria propia para poder modificar la lista
+void ListaPosteo::materializar() {
+    if (!esVista) {
+        return;
+    }
+    bloques.assign(bloquesExternos, bloquesExternos + numBloquesExternos);
+    datos.assign(datosExternos, datosExternos + bytesDatosExternos);
+    esVista = false;
+    bloquesExternos = nullptr;
+    numBloquesExternos = 0;
+    datosExternos = nullptr;
+    bytesDatosExternos = 0;
+}
+
+// vuelve a abrir el ultimo bloque sellado, para poder seguir sumando la frecuencia del ultimo doc
+void ListaPosteo::reabrirUltimoBloque() {
+    if (bloques.empty() || !pendientes.empty()) {
+        return;
+    }
+    size_t ultimo = bloques.size() - 1;
+    uint32_t docs[TAMANIO_BLOQUE];
+    uint32_t frecuencias[TAMANIO_BLOQUE];
+    const uint8_t* finDocs = nullptr;
+    int n = decodificarBloque(ultimo, docs, &finDocs);
+    decodificarFrecuencias(ultimo, finDocs, frecuencias);
+
+    datos.resize(bloques[ultimo].offset);
+    bloques.pop_back();
+    pendientes.assign(docs, docs + n);
+    pendientesFrecuencias.assign(frecuencias, frecuencias + n);
+}
+
+// agrega un doc id, si es mayor al ultimo se agrega al bloque abierto en O(1)
+// si es igual al ultimo solo se suma la frecuencia
+// si llega desordenado se reconstruye la lista completa (caso raro)
+bool ListaPosteo::add(int doc_id, int frecuencia) {
+    materializar();
+    if (size > 0 && doc_id == ultimoDoc) {
+        reabrirUltimoBloque();
+        pendientesFrecuencias.back() += frecuencia;
+        return false;
+    }
+
+    if (size == 0 || doc_id > ultimoDoc) {
+        // si se sello un bloque incompleto (sellar()) se vuelve a abrir, asi todos los
+        // bloques salvo el ultimo tienen TAMANIO_BLOQUE docs
+        if (pendientes.empty() && !bloques.empty() && bloques.back().cantidad < TAMANIO_BLOQUE) {
+            reabrirUltimoBloque();
+        }
+        if (static_cast<int>(pendientes.size()) == TAMANIO_BLOQUE) {
+            sellarBloque();
+        }
+        pendientes.push_back(static_cast<uint32_t>(doc_id));
+        pendientesFrecuencias.push_back(static_cast<uint32_t>(frecuencia));
+        ultimoDoc = doc_id;
+        size++;
+        return true;
+    }
+
+    if (contains(doc_id)) {
+        return false;
+    }
+
+    std::vector<uint32_t> docs;
+    std::vector<uint32_t> frecuencias;
+    docs.reserve(size + 1);
+    frecuencias.reserve(size + 1);
+    for (Iterador it = begin(); it.valido(); it.siguiente()) {
+        docs.push_back(static_cast<uint32_t>(it.docId()));
+        frecuencias.push_back(static_cast<uint32_t>(it.frecuencia()));
+    }
+    size_t pos = std::lower_bound(docs.begin(), docs.end(), static_cast<uint32_t>(doc_id)) - docs.begin();
+    docs.insert(docs.begin() + pos, static_cast<uint32_t>(doc_id));
+    frecuencias.insert(frecuencias.begin() + pos, static_cast<uint32_t>(frecuencia));
+    reconstruir(docs, frecuencias);
+    return true;
+}
+
+// busca el bloque que podria tener el doc id y lo descomprime
+bool ListaPosteo::contains(int doc_id) const {
+    if (size == 0 || doc_id < 0 || doc_id > ultimoDoc) {
+        return false;
+    }
+
+    const BloquePosteo* inicio = getBloques();
+    const BloquePosteo* fin = inicio + getNumBloques();
+    const BloquePosteo* it = std::lower_bound(inicio, fin, static_cast<uint32_t>(doc_id),
+                               [](const BloquePosteo& b, uint32_t d) { return b.maxDocId < d; });
+    size_t indiceBloque = it - inicio;
+
+    uint32_t buffer[TAMANIO_BLOQUE];
+    int n = decodificarBloque(indiceBloque, buffer);
+    return std::binary_search(buffer, buffer + n, static_cast<uint32_t>(doc_id));
+}
+
+void ListaPosteo::clear() {
+    materializar();
+    bloques.clear();
+    datos.clear();
+    pendientes.clear();
+    pendientesFrecuencias.clear();
+    size = 0;
+    ultimoDoc = -1;
+}
+
+size_t ListaPosteo::bytesUsados() const {
+    if (esVista) {
+        return sizeof(ListaPosteo) + numBloquesExternos * sizeof(BloquePosteo) + bytesDatosExternos;
+    }
+    return sizeof(ListaPosteo)
+         + bloques.capacity() * sizeof(BloquePosteo)
+         + datos.capacity() * sizeof(uint8_t)
+         + (pendientes.capacity() + pendientesFrecuencias.capacity()) * sizeof(uint32_t);
+}
+
+uint32_t ListaPosteo::maxDocBloque(size_t indiceBloque) const {
+    if (indiceBloque < getNumBloques()) {
+        return getBloques()[indiceBloque].maxDocId;
+    }
+    return static_cast<uint32_t>(ultimoDoc);
+}
+
+// descomprime los doc ids del bloque indicado en salida, retorna la cantidad
+// el indice bloques.size() corresponde al bloque abierto
+// en finDocs queda donde empiezan las frecuencias del bloque
+int ListaPosteo::decodificarBloque(size_t indiceBloque, uint32_t* salida, const uint8_t** finDocs) const {
+    if (indiceBloque >= getNumBloques()) {
+        std::copy(pendientes.begin(), pendientes.end(), salida);
+        return static_cast<int>(pendientes.size());
+    }
+
+    const BloquePosteo* bloquesLista = getBloques();
+    const BloquePosteo& bloque = bloquesLista[indiceBloque];
+    int n = bloque.cantidad;
+    const uint8_t* fin = decodificarValores(getDatos() + bloque.offset, salida, n, bloque.codec, bloque.bits);
+    if (finDocs != nullptr) {
+        *finDocs = fin;
+    }
+
+    // deshacer los gaps, el primer gap es relativo al maximo del bloque anterior
+    int64_t anterior = (indiceBloque == 0) ? -1 : static_cast<int64_t>(bloquesLista[indiceBloque - 1].maxDocId);
+    for (int i = 0; i < n; ++i) {
+        anterior = anterior + salida[i] + 1;
+        salida[i] = static_cast<uint32_t>(anterior);
+    }
+    return n;
+}
+
+void ListaPosteo::decodificarFrecuencias(size_t indiceBloque, const uint8_t* p, uint32_t* salida) const {
+    if (indiceBloque >= getNumBloques()) {
+        std::copy(pendientesFrecuencias.begin(), pendientesFrecuencias.end(), salida);
+        return;
+    }
+
+    const BloquePosteo& bloque = getBloques()[indiceBloque];
+    decodificarValores(p, salida, bloque.cantidad, bloque.codecFrecuencias, bloque.bitsFrecuencias);
+    for (int i = 0; i < bloque.cantidad; ++i) {
+        salida[i] += 1;
+    }
+}
+
+// comprime el bloque abierto, doc ids y frecuencias eligen cada uno el codec que ocupe menos
+void ListaPosteo::sellarBloque() {
+    if (pendientes.empty()) {
+        return;
+    }
+    materializar();
+
+    int n = static_cast<int>(pendientes.size());
+    uint32_t valores[TAMANIO_BLOQUE] = {}; // inicializado para que -O2 no avise
+    int64_t anterior = bloques.empty() ? -1 : static_cast<int64_t>(bloques.back().maxDocId);
+    for (int i = 0; i < n; ++i) {
+        valores[i] = static_cast<uint32_t>(pendientes[i] - anterior - 1);
+        anterior = pendientes[i];
+    }
+
+    BloquePosteo bloque;
+    bloque.maxDocId = pendientes.back();
+    bloque.offset = static_cast<uint32_t>(datos.size());
+    bloque.cantidad = static_cast<uint16_t>(n);
+    codificarValores(datos, valores, n, bloque.codec, bloque.bits);
+
+    for (int i = 0; i < n; ++i) {
+        valores[i] = pendientesFrecuencias[i] - 1;
+    }
+    codificarValores(datos, valores, n, bloque.codecFrecuencias, bloque.bitsFrecuencias);
+
+    bloques.push_back(bloque);
+    pendientes.clear();
+    pendientesFrecuencias.clear();
+}
+
+// vuelve a comprimir la lista completa a partir de doc ids ordenados
+void ListaPosteo::reconstruir(const std::vector<uint32_t>& docs, const std::vector<uint32_t>& frecuencias) {
+    clear();
+    for (size_t i = 0; i < docs.size(); ++i) {
+        add(static_cast<int>(docs[i]), static_cast<int>(frecuencias[i]));
+    }
+}
+
+// CONSTRUCTOR del iterador, queda posicionado en el primer doc id
+ListaPosteo::Iterador::Iterador(const ListaPosteo* l)
+    : lista(l), bloqueActual(0), posicion(0), cantidad(0), frecuenciasCargadas(false), datosFrecuencias(nullptr) {
+    cargarBloque(0);
+}
+
+void ListaPosteo::Iterador::cargarBloque(size_t indiceBloque) {
+    bloqueActual = indiceBloque;
+    posicion = 0;
+    frecuenciasCargadas = false;
+    if (lista == nullptr || indiceBloque >= lista->numBloquesVirtuales()) {
+        cantidad = 0;
+        return;
+    }
+    cantidad = lista->decodificarBloque(indiceBloque, buffer, &datosFrecuencias);
+}
+
+int ListaPosteo::Iterador::frecuencia() {
+    if (!frecuenciasCargadas) {
+        lista->decodificarFrecuencias(bloqueActual, datosFrecuencias, bufferFrecuencias);
+        frecuenciasCargadas = true;
+    }
+    return static_cast<int>(bufferFrecuencias[posicion]);
+}
+
+void ListaPosteo::Iterador::siguiente() {
+    posicion++;
+    if (posicion >= cantidad && cantidad > 0) {
+        cargarBloque(bloqueActual + 1);
+    }
+}
+
+void ListaPosteo::Iterador::avanzarA(int doc_id) {
+    if (!valido() || docId() >= doc_id) {
+        return;
+    }
+
+    // saltar bloques completos usando el maximo de cada uno: primero pasos que se duplican
+    // hasta pasarse y despues busqueda binaria en el ultimo tramo
+    uint32_t objetivo = static_cast<uint32_t>(doc_id);
+    if (lista->maxDocBloque(bloqueActual) < objetivo) {
+        size_t total = lista->numBloquesVirtuales();
+        size_t bajo = bloqueActual; // ultimo bloque conocido con maximo < objetivo
+        size_t paso = 1;
+        while (bajo + paso < total && lista->maxDocBloque(bajo + paso) < objetivo) {
+            bajo += paso;
+            paso *= 2;
+        }
+        size_t alto = std::min(bajo + paso, total); // primer candidato con maximo >= objetivo
+        while (bajo + 1 < alto) {
+            size_t medio = bajo + (alto - bajo) / 2;
+            if (lista->maxDocBloque(medio) < objetivo) {
+                bajo = medio;
+            } else {
+                alto = medio;
+            }
+        }
+        cargarBloque(alto);
+        if (!valido()) {
+            return;
+        }
+    }
+
+    // lo mismo dentro del bloque descomprimido
+    int bajo = posicion;
+    int paso = 1;
+    while (bajo + paso < cantidad && buffer[bajo + paso] < objetivo) {
+        bajo += paso;
+        paso *= 2;
+    }
+    int alto = std::min(bajo + paso, cantidad);
+    posicion = static_cast<int>(std::lower_bound(buffer + bajo, buffer + alto, objetivo) - buffer);
+}
@@ -0,0 +1,115 @@
+#ifndef LISTA_POSTEO_H
+#define LISTA_POSTEO_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// codecs posibles de un bloque
+#define CODEC_VARINT 0
+#define CODEC_BITPACK 1
+
+// cabecera de un bloque comprimido de la lista de posteo
+// los doc ids se guardan como gaps (doc - anterior - 1) para que sean numeros chicos
+// y justo despues van las frecuencias (frecuencia - 1) con su propio codec
+struct BloquePosteo {
+    uint32_t maxDocId;      // mayor doc id del bloque, sirve para saltar bloques completos
+    uint32_t offset;        // posicion del bloque dentro del arreglo de datos
+    uint16_t cantidad;      // cantidad de doc ids en el bloque
+    uint8_t codec;          // CODEC_VARINT o CODEC_BITPACK
+    uint8_t bits;           // ancho en bits de cada gap (solo bitpack)
+    uint8_t codecFrecuencias;
+    uint8_t bitsFrecuencias;
+};
+
+// lista de posteo comprimida por bloques de tamanio fijo, con la frecuencia del
+// termino en cada documento. los doc ids tienen que llegar ordenados para que add
+// sea O(1), el ultimo bloque queda abierto (sin comprimir) hasta que llega un doc
+// que ya no cabe, asi la frecuencia del ultimo doc se puede seguir sumando
+class ListaPosteo {
+public:
+    static const int TAMANIO_BLOQUE = 128;
+
+    // iterador que descomprime un bloque a la vez
+    class Iterador {
+    public:
+        Iterador(const ListaPosteo* lista);
+
+        bool valido() const { return posicion < cantidad; }
+        int docId() const { return static_cast<int>(buffer[posicion]); }
+        int frecuencia(); // las frecuencias del bloque se descomprimen solo si se piden
+        // numero del doc actual dentro de la lista (todos los bloques menos el ultimo estan llenos)
+        int ordinal() const { return static_cast<int>(bloqueActual) * TAMANIO_BLOQUE + posicion; }
+        void siguiente();
+        // avanza hasta el primer doc id >= doc_id, saltando los bloques cuyo maximo es menor
+        // (busqueda exponencial sobre las cabeceras y despues dentro del bloque)
+        void avanzarA(int doc_id);
+
+        // acceso al bloque descomprimido, para intersectar un bloque entero de una vez
+        const uint32_t* docsBloque() const { return buffer; }
+        int posicionBloque() const { return posicion; }
+        int cantidadBloque() const { return cantidad; }
+        void siguienteBloque() { cargarBloque(bloqueActual + 1); }
+
+    private:
+        const ListaPosteo* lista;
+        size_t bloqueActual;
+        int posicion;
+        int cantidad;
+        bool frecuenciasCargadas;
+        const uint8_t* datosFrecuencias; // donde empiezan las frecuencias del bloque actual
+        uint32_t buffer[TAMANIO_BLOQUE];
+        uint32_t bufferFrecuencias[TAMANIO_BLOQUE];
+
+        void cargarBloque(size_t indiceBloque);
+    };
+
+    ListaPosteo();
+    // vista de solo lectura sobre bloques ya comprimidos en memoria externa (snapshot mapeado)
+    // si despues se agrega un doc, la lista se copia a memoria propia
+    ListaPosteo(const BloquePosteo* bloques, size_t numBloques, const uint8_t* datos, size_t bytesDatos, int size, int ultimoDoc);
+
+    // retorna false si el doc ya estaba, en ese caso solo suma la frecuencia
+    bool add(int doc_id, int frecuencia = 1);
+    bool contains(int doc_id) const;
+    int getSize() const { return size; }
+    int getUltimoDoc() const { return ultimoDoc; }
+    Iterador begin() const { return Iterador(this); }
+    void clear();
+
+    // memoria ocupada por la lista (cabeceras + datos + bloque abierto)
+    size_t bytesUsados() const;
+
+    // comprime el bloque abierto, despues de esto getBloques/getDatos tienen toda la lista
+    void sellar() { sellarBloque(); }
+    const BloquePosteo* getBloques() const { return esVista ? bloquesExternos : bloques.data(); }
+    size_t getNumBloques() const { return esVista ? numBloquesExternos : bloques.size(); }
+    const uint8_t* getDatos() const { return esVista ? datosExternos : datos.data(); }
+    size_t getBytesDatos() const { return esVista ? bytesDatosExternos : datos.size(); }
+
+private:
+    std::vector<BloquePosteo> bloques;
+    std::vector<uint8_t> datos;
+    std::vector<uint32_t> pendientes; // bloque abierto, todavia sin comprimir
+    std::vector<uint32_t> pendientesFrecuencias;
+    int size;
+    int ultimoDoc;
+
+    // modo vista: los bloques y datos son de otro (no se liberan ni se modifican)
+    bool esVista;
+    const BloquePosteo* bloquesExternos;
+    size_t numBloquesExternos;
+    const uint8_t* datosExternos;
+    size_t bytesDatosExternos;
+
+    size_t numBloquesVirtuales() const { return getNumBloques() + (pendientes.empty() ? 0 : 1); }
+    void materializar();
+    void reabrirUltimoBloque();
+    uint32_t maxDocBloque(size_t indiceBloque) const;
+    int decodificarBloque(size_t indiceBloque, uint32_t* salida, const uint8_t** finDocs = nullptr) const;
+    void decodificarFrecuencias(size_t indiceBloque, const uint8_t* p, uint32_t* salida) const;
+    void sellarBloque();
+    void reconstruir(const std::vector<uint32_t>& docs, const std::vector<uint32_t>& frecuencias);
+};
+
+#endif
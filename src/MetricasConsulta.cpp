@@ -0,0 +1,153 @@
+#include "MetricasConsulta.h"
+
+#include <iomanip>
+
+// CONSTRUCTOR todos los contadores en 0
+HistogramaLatencia::HistogramaLatencia() {
+    clear();
+}
+
+void HistogramaLatencia::clear() {
+    for (std::atomic<uint64_t>& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    cantidad.store(0, std::memory_order_relaxed);
+    suma.store(0, std::memory_order_relaxed);
+    maximo.store(0, std::memory_order_relaxed);
+}
+
+// los valores chicos van directo a su bucket; para el resto, el bit mas alto elige la
+// potencia de 2 y los BITS_SUB_BUCKET siguientes el sub-bucket
+int HistogramaLatencia::indiceBucket(uint64_t valor) {
+    if (valor >= (1ULL << BITS_MAXIMOS)) {
+        return NUM_BUCKETS - 1;
+    }
+    if (valor < static_cast<uint64_t>(SUB_BUCKETS)) {
+        return static_cast<int>(valor);
+    }
+    int exponente = 63 - __builtin_clzll(valor);
+    int sub = static_cast<int>((valor >> (exponente - BITS_SUB_BUCKET)) & (SUB_BUCKETS - 1));
+    return (exponente - BITS_SUB_BUCKET + 1) * SUB_BUCKETS + sub;
+}
+
+// centro del rango de valores del bucket
+uint64_t HistogramaLatencia::valorBucket(int indice) {
+    if (indice < SUB_BUCKETS) {
+        return static_cast<uint64_t>(indice);
+    }
+    int exponente = indice / SUB_BUCKETS + BITS_SUB_BUCKET - 1;
+    uint64_t sub = static_cast<uint64_t>(indice % SUB_BUCKETS);
+    uint64_t ancho = 1ULL << (exponente - BITS_SUB_BUCKET);
+    return ((SUB_BUCKETS + sub) << (exponente - BITS_SUB_BUCKET)) + ancho / 2;
+}
+
+void HistogramaLatencia::registrar(uint64_t nanosegundos) {
+    buckets[indiceBucket(nanosegundos)].fetch_add(1, std::memory_order_relaxed);
+    cantidad.fetch_add(1, std::memory_order_relaxed);
+    suma.fetch_add(nanosegundos, std::memory_order_relaxed);
+    uint64_t actual = maximo.load(std::memory_order_relaxed);
+    while (nanosegundos > actual && !maximo.compare_exchange_weak(actual, nanosegundos, std::memory_order_relaxed)) {
+    }
+}
+
+uint64_t HistogramaLatencia::percentil(double p) const {
+    uint64_t total = getCantidad();
+    if (total == 0) {
+        return 0;
+    }
+    // el primer bucket donde la cantidad acumulada llega a p% del total
+    uint64_t objetivo = static_cast<uint64_t>(p / 100.0 * total + 0.999999);
+    if (objetivo < 1) {
+        objetivo = 1;
+    }
+    uint64_t acumulado = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        acumulado += buckets[i].load(std::memory_order_relaxed);
+        if (acumulado >= objetivo) {
+            uint64_t valor = valorBucket(i);
+            return valor < getMaximo() ? valor : getMaximo();
+        }
+    }
+    return getMaximo();
+}
+
+double HistogramaLatencia::getPromedio() const {
+    uint64_t total = getCantidad();
+    return total > 0 ? static_cast<double>(suma.load(std::memory_order_relaxed)) / total : 0.0;
+}
+
+void MetricasConsulta::clear() {
+    for (HistogramaLatencia& etapa : etapas) {
+        etapa.clear();
+    }
+}
+
+const char* MetricasConsulta::nombreEtapa(int etapa) {
+    switch (etapa) {
+        case ETAPA_NORMALIZACION: return "normalizacion";
+        case ETAPA_BUSQUEDA_CACHE: return "busqueda_cache";
+        case ETAPA_POSTEO: return "listas_posteo";
+        case ETAPA_INTERSECCION: return "interseccion";
+        case ETAPA_PAGERANK: return "pagerank";
+        case ETAPA_COPIA: return "copia_resultado";
+        case ETAPA_TOTAL: return "total";
+        default: return "?";
+    }
+}
+
+void MetricasConsulta::imprimir(std::ostream& salida) const {
+    salida << "\n=== LATENCIA POR ETAPA (us) ===" << std::endl;
+    salida << std::left << std::setw(18) << "etapa" << std::right << std::setw(10) << "n"
+           << std::setw(11) << "promedio" << std::setw(11) << "p50" << std::setw(11) << "p99"
+           << std::setw(11) << "p999" << std::setw(11) << "max" << std::endl;
+    std::ios::fmtflags formato = salida.flags();
+    std::streamsize precision = salida.precision();
+    salida << std::fixed << std::setprecision(2);
+    for (int e = 0; e < NUM_ETAPAS; ++e) {
+        const HistogramaLatencia& h = etapas[e];
+        salida << std::left << std::setw(18) << nombreEtapa(e) << std::right << std::setw(10) << h.getCantidad()
+               << std::setw(11) << h.getPromedio() / 1000.0 << std::setw(11) << h.percentil(50) / 1000.0
+               << std::setw(11) << h.percentil(99) / 1000.0 << std::setw(11) << h.percentil(99.9) / 1000.0
+               << std::setw(11) << h.getMaximo() / 1000.0 << std::endl;
+    }
+    salida.flags(formato);
+    salida.precision(precision);
+    salida << "===============================" << std::endl;
+}
+
+void MetricasConsulta::escribirJSON(std::ostream& salida) const {
+    salida << "{\"unidad\": \"ns\", \"etapas\": {";
+    for (int e = 0; e < NUM_ETAPAS; ++e) {
+        const HistogramaLatencia& h = etapas[e];
+        salida << (e > 0 ? ", " : "") << "\"" << nombreEtapa(e) << "\": {\"n\": " << h.getCantidad()
+               << ", \"promedio\": " << static_cast<uint64_t>(h.getPromedio()) << ", \"p50\": " << h.percentil(50)
+               << ", \"p99\": " << h.percentil(99) << ", \"p999\": " << h.percentil(99.9)
+               << ", \"max\": " << h.getMaximo() << "}";
+    }
+    salida << "}}" << std::endl;
+}
+
+// CONSTRUCTOR con las metricas apagadas no lee el reloj
+CronometroConsulta::CronometroConsulta(MetricasConsulta& m) : metricas(m.estanActivas() ? &m : nullptr) {
+    if (metricas != nullptr) {
+        inicio = std::chrono::steady_clock::now();
+        ultimaMarca = inicio;
+    }
+}
+
+void CronometroConsulta::marcar(int etapa) {
+    if (metricas == nullptr) {
+        return;
+    }
+    std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+    metricas->registrar(etapa, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(ahora - ultimaMarca).count()));
+    ultimaMarca = ahora;
+}
+
+void CronometroConsulta::terminar() {
+    if (metricas == nullptr) {
+        return;
+    }
+    std::chrono::steady_clock::time_point ahora = std::chrono::steady_clock::now();
+    metricas->registrar(ETAPA_TOTAL, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(ahora - inicio).count()));
+}
@@ -0,0 +1,93 @@
+#ifndef METRICAS_CONSULTA_H
+#define METRICAS_CONSULTA_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+// histograma de latencias en nanosegundos al estilo HDR: cada potencia de 2 se divide en
+// 32 sub-buckets lineales, asi cualquier valor queda a menos de ~3% de su bucket, desde
+// 1 ns hasta 2^40 ns (~18 minutos, lo de arriba va al ultimo). los contadores son
+// atomicos, se puede registrar desde varios hilos sin lock
+class HistogramaLatencia {
+public:
+    HistogramaLatencia();
+
+    void registrar(uint64_t nanosegundos);
+    // valor del percentil (0..100), aproximado al centro de su bucket
+    uint64_t percentil(double p) const;
+    uint64_t getCantidad() const { return cantidad.load(std::memory_order_relaxed); }
+    uint64_t getMaximo() const { return maximo.load(std::memory_order_relaxed); }
+    double getPromedio() const;
+    void clear();
+
+private:
+    static const int BITS_SUB_BUCKET = 5;
+    static const int SUB_BUCKETS = 1 << BITS_SUB_BUCKET;
+    static const int BITS_MAXIMOS = 40;
+    static const int NUM_BUCKETS = (BITS_MAXIMOS - BITS_SUB_BUCKET + 1) * SUB_BUCKETS;
+
+    std::atomic<uint64_t> buckets[NUM_BUCKETS];
+    std::atomic<uint64_t> cantidad;
+    std::atomic<uint64_t> suma;
+    std::atomic<uint64_t> maximo;
+
+    static int indiceBucket(uint64_t valor);
+    static uint64_t valorBucket(int indice);
+};
+
+// etapas de una consulta que se miden por separado
+#define ETAPA_NORMALIZACION 0  // limpiar y separar los terminos
+#define ETAPA_BUSQUEDA_CACHE 1 // armar la clave y buscar en la cache de resultados
+#define ETAPA_POSTEO 2         // obtener las listas de posteo de los terminos
+#define ETAPA_INTERSECCION 3   // intersectar (o filtrar un subconjunto guardado)
+#define ETAPA_PAGERANK 4       // reordenar por pagerank
+#define ETAPA_COPIA 5          // armar el resultado que se devuelve (y guardarlo en la cache)
+#define ETAPA_TOTAL 6          // la consulta completa
+#define NUM_ETAPAS 7
+
+// un histograma por etapa y contadores de consultas. apagado (por defecto) medir cuesta
+// solo un if por etapa
+class MetricasConsulta {
+public:
+    MetricasConsulta() : activas(false) {}
+
+    void setActivas(bool valor) { activas.store(valor, std::memory_order_relaxed); }
+    bool estanActivas() const { return activas.load(std::memory_order_relaxed); }
+
+    void registrar(int etapa, uint64_t nanosegundos) { etapas[etapa].registrar(nanosegundos); }
+    const HistogramaLatencia& getEtapa(int etapa) const { return etapas[etapa]; }
+    void clear();
+
+    // tabla con cantidad, promedio, p50, p99, p999 y maximo por etapa, en microsegundos
+    void imprimir(std::ostream& salida) const;
+    // lo mismo en JSON, los valores en nanosegundos
+    void escribirJSON(std::ostream& salida) const;
+
+    static const char* nombreEtapa(int etapa);
+
+private:
+    std::atomic<bool> activas;
+    HistogramaLatencia etapas[NUM_ETAPAS];
+};
+
+// mide etapas seguidas de una consulta: cada marcar() registra el tiempo desde la marca
+// anterior (o desde que se creo) en la etapa que se le pasa. terminar() registra el total.
+// si las metricas estan apagadas no lee el reloj
+class CronometroConsulta {
+public:
+    explicit CronometroConsulta(MetricasConsulta& m);
+    CronometroConsulta() : metricas(nullptr) {} // no mide nada
+
+
+    void marcar(int etapa);
+    void terminar();
+
+private:
+    MetricasConsulta* metricas; // nullptr si estan apagadas
+    std::chrono::steady_clock::time_point inicio;
+    std::chrono::steady_clock::time_point ultimaMarca;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include "PageRankIncremental.h"
+#include "Grafo.h"
+#include "GrafoCSR.h"
+
+#include <cmath>
+
+PageRankIncremental::PageRankIncremental(const Grafo& grafo, double damping_factor, double eps)
+    : damping(damping_factor), epsilon(eps) {
+    for (uint32_t nodo : grafo.indicesPorDocId()) {
+        int desde = obtenerIndice(grafo.getDocId(nodo));
+        for (const VecinoGrafo& vecino : grafo.getVecinos(nodo)) {
+            int hasta = obtenerIndice(grafo.getDocId(vecino.indice));
+            adyacencia[desde].push_back({hasta, vecino.peso});
+            salida[desde] += vecino.peso;
+        }
+    }
+    if (idsNodos.empty()) {
+        return;
+    }
+
+    // punto de partida: iteraciones de Jacobi sobre el CSR hasta que ningun nodo cambie mas
+    // que epsilon, y el residuo exacto de ese x. el push solo tiene que terminar lo que falte
+    GrafoCSR csr(grafo);
+    std::vector<double> x;
+    std::vector<double> r;
+    csr.calcularPageRank(x, 10000, damping, epsilon, CONVERGENCIA_MAXIMA);
+    csr.calcularResiduo(x, damping, r);
+    cola.clear();
+    for (int j = 0; j < csr.getNumNodos(); ++j) {
+        int indice = indicePorDoc[csr.getDocId(j)];
+        score[indice] = x[j];
+        residuo[indice] = r[j];
+        enCola[indice] = 0;
+    }
+    for (int indice = 0; indice < getNumNodos(); ++indice) {
+        encolarSiHaceFalta(indice);
+    }
+}
+
+// un nodo nuevo arranca con x = 0, asi su residuo es el termino constante (1-d)
+int PageRankIncremental::obtenerIndice(int doc_id) {
+    auto it = indicePorDoc.find(doc_id);
+    if (it != indicePorDoc.end()) {
+        return it->second;
+    }
+    int indice = static_cast<int>(idsNodos.size());
+    indicePorDoc[doc_id] = indice;
+    idsNodos.push_back(doc_id);
+    adyacencia.emplace_back();
+    salida.push_back(0.0);
+    score.push_back(0.0);
+    residuo.push_back(1.0 - damping);
+    enCola.push_back(0);
+    encolarSiHaceFalta(indice);
+    return indice;
+}
+
+void PageRankIncremental::sumarPeso(int desde, int hasta, double peso) {
+    for (Vecino& vecino : adyacencia[desde]) {
+        if (vecino.indice == hasta) {
+            vecino.peso += peso;
+            return;
+        }
+    }
+    adyacencia[desde].push_back({hasta, peso});
+}
+
+void PageRankIncremental::encolarSiHaceFalta(int indice) {
+    if (!enCola[indice] && std::abs(residuo[indice]) > epsilon) {
+        enCola[indice] = 1;
+        cola.push_back(indice);
+    }
+}
+
+// suma (signo = 1) o resta (signo = -1) lo que el nodo aporta a sus vecinos con su x actual,
+// o sea la columna del nodo en d*P*x
+void PageRankIncremental::repartirColumna(int indice, double signo) {
+    if (score[indice] == 0.0 || salida[indice] <= 0.0) {
+        return;
+    }
+    double factor = signo * damping * score[indice] / salida[indice];
+    for (const Vecino& vecino : adyacencia[indice]) {
+        residuo[vecino.indice] += factor * vecino.peso;
+        encolarSiHaceFalta(vecino.indice);
+    }
+}
+
+// la arista cambia las columnas de los dos nodos: se saca lo que aportaban con los pesos
+// viejos y se vuelve a poner con los nuevos
+void PageRankIncremental::agregarArista(int doc1_id, int doc2_id, double peso) {
+    int a = obtenerIndice(doc1_id);
+    int b = obtenerIndice(doc2_id);
+    repartirColumna(a, -1.0);
+    repartirColumna(b, -1.0);
+
+    sumarPeso(a, b, peso);
+    sumarPeso(b, a, peso);
+    salida[a] += peso;
+    salida[b] += peso;
+
+    repartirColumna(a, 1.0);
+    repartirColumna(b, 1.0);
+}
+
+long long PageRankIncremental::actualizar() {
+    long long pushes = 0;
+    while (!cola.empty()) {
+        int u = cola.front();
+        cola.pop_front();
+        enCola[u] = 0;
+
+        double r = residuo[u];
+        if (std::abs(r) <= epsilon) {
+            continue;
+        }
+        score[u] += r;
+        residuo[u] = 0.0;
+        pushes++;
+
+        if (salida[u] <= 0.0) {
+            continue;
+        }
+        double factor = damping * r / salida[u];
+        for (const Vecino& vecino : adyacencia[u]) {
+            residuo[vecino.indice] += factor * vecino.peso;
+            encolarSiHaceFalta(vecino.indice);
+        }
+    }
+    return pushes;
+}
+
+double PageRankIncremental::cotaError() const {
+    double suma = 0.0;
+    for (double r : residuo) {
+        suma += std::abs(r);
+    }
+    return suma / (1.0 - damping);
+}
+
+std::map<int, double> PageRankIncremental::getPageRank() const {
+    double total_pr_sum = 0.0;
+    for (double x : score) {
+        total_pr_sum += x;
+    }
+
+    std::map<int, double> scores;
+    for (size_t i = 0; i < idsNodos.size(); ++i) {
+        scores[idsNodos[i]] = total_pr_sum > 0 ? score[i] / total_pr_sum : 0.0;
+    }
+    return scores;
+}
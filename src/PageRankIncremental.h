@@ -0,0 +1,68 @@
+#ifndef PAGERANK_INCREMENTAL_H
+#define PAGERANK_INCREMENTAL_H
+
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class Grafo;
+
+// residuo maximo que se deja sin repartir en cada nodo (scores sin normalizar, cerca de 1)
+#ifndef EPSILON_PAGERANK_INCREMENTAL
+#define EPSILON_PAGERANK_INCREMENTAL 1e-6
+#endif
+
+// PageRank que se mantiene al dia mientras se agregan aristas, con "push" de residuos.
+// se busca el mismo punto fijo que Grafo::calcularPageRank: x = (1-d) + d*P*x con
+// P_ji = w_ij / salida_i. se guarda x y el residuo r = (1-d) + d*P*x - x de cada nodo:
+// - agregar una arista cambia las columnas de sus dos extremos, el residuo se corrige solo
+//   en los vecinos de esos dos nodos
+// - actualizar() toma los nodos con |r| > epsilon, pasa su residuo a x y lo reparte a sus
+//   vecinos (Gauss-Seidel), asi solo se toca la zona a la que llega el cambio
+// como P es estocastica por columnas, ||x* - x||_1 <= ||r||_1 / (1-d)
+class PageRankIncremental {
+public:
+    // arranca desde el grafo actual (Jacobi sobre el CSR + residuo exacto)
+    PageRankIncremental(const Grafo& grafo, double damping_factor = 0.85, double epsilon = EPSILON_PAGERANK_INCREMENTAL);
+
+    // lo llama Grafo::addVertice: suma peso a la arista en los dos sentidos
+    void agregarArista(int doc1_id, int doc2_id, double peso = 1.0);
+
+    // reparte residuos hasta que todos queden bajo epsilon, retorna la cantidad de pushes
+    long long actualizar();
+
+    // cota del error L1 de los scores sin normalizar contra el punto fijo exacto
+    double cotaError() const;
+    // scores normalizados (suman 1) por doc id, como los de calcularPageRank
+    std::map<int, double> getPageRank() const;
+    int getNumNodos() const { return static_cast<int>(idsNodos.size()); }
+    size_t getPendientes() const { return cola.size(); }
+
+private:
+    struct Vecino {
+        int indice;
+        double peso;
+    };
+
+    double damping;
+    double epsilon;
+
+    // copia densa de la adyacencia, para que cada push sea un recorrido de un arreglo
+    std::unordered_map<int, int> indicePorDoc;
+    std::vector<int> idsNodos;
+    std::vector<std::vector<Vecino>> adyacencia;
+    std::vector<double> salida;   // peso total de las aristas de cada nodo
+    std::vector<double> score;    // x
+    std::vector<double> residuo;  // r
+    std::vector<char> enCola;
+    std::deque<int> cola;         // nodos con |r| > epsilon, en orden de llegada
+
+    int obtenerIndice(int doc_id);
+    void sumarPeso(int desde, int hasta, double peso);
+    void encolarSiHaceFalta(int indice);
+    void repartirColumna(int indice, double signo);
+};
+
+#endif
@@ -0,0 +1,555 @@
+#include "PoliticasCache.h"
+
+#include <algorithm>
+
+namespace {
+
+// valores de LRUNode::segmento
+const int SEGMENTO_PRUEBA = 0;
+const int SEGMENTO_PROTEGIDO = 1;
+const int SEGMENTO_VENTANA = 2;
+const int SEGMENTO_T1 = 0;
+const int SEGMENTO_T2 = 1;
+const int SEGMENTO_B1 = 2;
+const int SEGMENTO_B2 = 3;
+
+} // namespace
+
+// ---------- ListaNodosCache ----------
+
+// CONSTRUCTOR crea los nodos dummy
+ListaNodosCache::ListaNodosCache() : size(0) {
+    head = new LRUNode("", nullptr);
+    tail = new LRUNode("", nullptr);
+    head->next = tail;
+    tail->prev = head;
+}
+
+// los nodos reales los libera quien los creo
+ListaNodosCache::~ListaNodosCache() {
+    delete head;
+    delete tail;
+}
+
+void ListaNodosCache::alFrente(LRUNode* nodo) {
+    nodo->next = head->next;
+    nodo->prev = head;
+    head->next->prev = nodo;
+    head->next = nodo;
+    size++;
+}
+
+void ListaNodosCache::quitar(LRUNode* nodo) {
+    nodo->prev->next = nodo->next;
+    nodo->next->prev = nodo->prev;
+    nodo->prev = nullptr;
+    nodo->next = nullptr;
+    size--;
+}
+
+LRUNode* ListaNodosCache::ultimo() const {
+    return tail->prev != head ? tail->prev : nullptr;
+}
+
+void ListaNodosCache::listar(std::vector<const LRUNode*>& salida, int max) const {
+    for (LRUNode* actual = head->next; actual != tail && static_cast<int>(salida.size()) < max; actual = actual->next) {
+        salida.push_back(actual);
+    }
+}
+
+void ListaNodosCache::vaciar(std::vector<LRUNode*>& salida) {
+    for (LRUNode* actual = head->next; actual != tail; actual = actual->next) {
+        salida.push_back(actual);
+    }
+    head->next = tail;
+    tail->prev = head;
+    size = 0;
+}
+
+// ---------- CountMinSketch ----------
+
+CountMinSketch::CountMinSketch(int capacidad) : mascara(0), muestras(0), tamanioMuestra(0) {
+    redimensionar(capacidad);
+}
+
+// ancho potencia de 2 de al menos 4 contadores por entrada, asi los choques son pocos
+void CountMinSketch::redimensionar(int capacidad) {
+    size_t necesarios = std::max(64, 4 * std::max(capacidad, 1));
+    size_t ancho = 64;
+    while (ancho < necesarios) {
+        ancho *= 2;
+    }
+    contadores.assign(ancho * FILAS, 0);
+    mascara = ancho - 1;
+    muestras = 0;
+    tamanioMuestra = 10 * std::max(capacidad, 1);
+}
+
+// las filas usan h1 + fila * h2 con las dos mitades del mismo hash de 64 bits
+size_t CountMinSketch::posicion(size_t hash, int fila) const {
+    size_t h1 = hash & 0xFFFFFFFFULL;
+    size_t h2 = (hash >> 32) | 1;
+    return static_cast<size_t>(fila) * (mascara + 1) + ((h1 + fila * h2) & mascara);
+}
+
+void CountMinSketch::incrementar(std::string_view key) {
+    size_t hash = HashPolicy<std::string>()(key);
+    for (int fila = 0; fila < FILAS; ++fila) {
+        uint8_t& contador = contadores[posicion(hash, fila)];
+        if (contador < MAXIMO) {
+            contador++;
+        }
+    }
+    if (++muestras >= tamanioMuestra) {
+        envejecer();
+    }
+}
+
+int CountMinSketch::frecuencia(std::string_view key) const {
+    size_t hash = HashPolicy<std::string>()(key);
+    int minimo = MAXIMO;
+    for (int fila = 0; fila < FILAS; ++fila) {
+        minimo = std::min(minimo, static_cast<int>(contadores[posicion(hash, fila)]));
+    }
+    return minimo;
+}
+
+void CountMinSketch::envejecer() {
+    for (uint8_t& contador : contadores) {
+        contador >>= 1;
+    }
+    muestras /= 2;
+}
+
+void CountMinSketch::clear() {
+    std::fill(contadores.begin(), contadores.end(), 0);
+    muestras = 0;
+}
+
+// ---------- LRU ----------
+
+PoliticaLRU::PoliticaLRU(int cap) : capacidad(cap) {}
+
+void PoliticaLRU::acceso(std::string_view, LRUNode* nodo) {
+    if (nodo) {
+        lista.quitar(nodo);
+        lista.alFrente(nodo);
+    }
+}
+
+// si esta llena sale el menos reciente antes de poner el nuevo al frente
+void PoliticaLRU::insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) {
+    if (capacidad <= 0) {
+        desalojados.push_back(nodo);
+        return;
+    }
+    if (lista.getSize() >= capacidad) {
+        LRUNode* ultimo = lista.ultimo();
+        lista.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+    lista.alFrente(nodo);
+}
+
+void PoliticaLRU::setCapacidad(int cap, std::vector<LRUNode*>& desalojados) {
+    capacidad = cap;
+    while (lista.getSize() > std::max(capacidad, 0)) {
+        LRUNode* ultimo = lista.ultimo();
+        lista.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+}
+
+void PoliticaLRU::desalojarUno(std::vector<LRUNode*>& desalojados) {
+    LRUNode* ultimo = lista.ultimo();
+    if (ultimo) {
+        lista.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+}
+
+void PoliticaLRU::vaciar(std::vector<LRUNode*>& nodos) {
+    lista.vaciar(nodos);
+}
+
+void PoliticaLRU::listar(std::vector<const LRUNode*>& salida, int max) const {
+    lista.listar(salida, max);
+}
+
+// ---------- SLRU ----------
+
+PoliticaSLRU::PoliticaSLRU(int cap) : capacidad(cap), capacidadProtegido(cap * 4 / 5) {}
+
+// si el protegido se pasa, su menos reciente vuelve al frente de prueba
+void PoliticaSLRU::ajustarProtegido() {
+    while (protegido.getSize() > capacidadProtegido) {
+        LRUNode* ultimo = protegido.ultimo();
+        protegido.quitar(ultimo);
+        ultimo->segmento = SEGMENTO_PRUEBA;
+        prueba.alFrente(ultimo);
+    }
+}
+
+void PoliticaSLRU::acceso(std::string_view, LRUNode* nodo) {
+    if (!nodo) {
+        return;
+    }
+    if (nodo->segmento == SEGMENTO_PRUEBA) {
+        prueba.quitar(nodo);
+        nodo->segmento = SEGMENTO_PROTEGIDO;
+        protegido.alFrente(nodo);
+        ajustarProtegido();
+    } else {
+        protegido.quitar(nodo);
+        protegido.alFrente(nodo);
+    }
+}
+
+void PoliticaSLRU::insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) {
+    if (capacidad <= 0) {
+        desalojados.push_back(nodo);
+        return;
+    }
+    if (prueba.getSize() + protegido.getSize() >= capacidad) {
+        ListaNodosCache& origen = prueba.getSize() > 0 ? prueba : protegido;
+        LRUNode* ultimo = origen.ultimo();
+        origen.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+    nodo->segmento = SEGMENTO_PRUEBA;
+    prueba.alFrente(nodo);
+}
+
+void PoliticaSLRU::setCapacidad(int cap, std::vector<LRUNode*>& desalojados) {
+    capacidad = cap;
+    capacidadProtegido = std::max(cap, 0) * 4 / 5;
+    ajustarProtegido();
+    while (prueba.getSize() + protegido.getSize() > std::max(capacidad, 0)) {
+        ListaNodosCache& origen = prueba.getSize() > 0 ? prueba : protegido;
+        LRUNode* ultimo = origen.ultimo();
+        origen.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+}
+
+void PoliticaSLRU::desalojarUno(std::vector<LRUNode*>& desalojados) {
+    ListaNodosCache& origen = prueba.getSize() > 0 ? prueba : protegido;
+    LRUNode* ultimo = origen.ultimo();
+    if (ultimo) {
+        origen.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+}
+
+void PoliticaSLRU::vaciar(std::vector<LRUNode*>& nodos) {
+    protegido.vaciar(nodos);
+    prueba.vaciar(nodos);
+}
+
+void PoliticaSLRU::listar(std::vector<const LRUNode*>& salida, int max) const {
+    protegido.listar(salida, max);
+    prueba.listar(salida, max);
+}
+
+// ---------- ARC ----------
+
+PoliticaARC::PoliticaARC(int cap) : fantasmas(cap > 0 ? 2 * cap : 1), capacidad(cap), objetivoT1(0) {}
+
+// los nodos de T1 y T2 los libera LRUCache, los fantasmas son de la politica
+PoliticaARC::~PoliticaARC() {
+    std::vector<LRUNode*> nodos;
+    b1.vaciar(nodos);
+    b2.vaciar(nodos);
+    for (LRUNode* fantasma : nodos) {
+        delete fantasma;
+    }
+}
+
+void PoliticaARC::borrarFantasma(LRUNode* fantasma) {
+    (fantasma->segmento == SEGMENTO_B1 ? b1 : b2).quitar(fantasma);
+    fantasmas.remove(fantasma->key);
+    delete fantasma;
+}
+
+// un acierto en T1 o T2 pasa al frente de T2. los fantasmas se miran al insertar
+void PoliticaARC::acceso(std::string_view, LRUNode* nodo) {
+    if (!nodo) {
+        return;
+    }
+    (nodo->segmento == SEGMENTO_T1 ? t1 : t2).quitar(nodo);
+    nodo->segmento = SEGMENTO_T2;
+    t2.alFrente(nodo);
+}
+
+// REPLACE del paper: sale el menos reciente de T1 si T1 pasa el objetivo, si no el de T2.
+// la clave que sale queda como fantasma en B1 o B2
+void PoliticaARC::reemplazar(bool estabaEnB2, std::vector<LRUNode*>& desalojados) {
+    bool desdeT1 = t1.getSize() > 0
+        && (t1.getSize() > objetivoT1 || (estabaEnB2 && t1.getSize() == objetivoT1) || t2.getSize() == 0);
+    ListaNodosCache& origen = desdeT1 ? t1 : t2;
+    LRUNode* victima = origen.ultimo();
+    if (!victima) {
+        return;
+    }
+    origen.quitar(victima);
+    desalojados.push_back(victima);
+
+    LRUNode* fantasma = new LRUNode(victima->key, nullptr);
+    fantasma->segmento = desdeT1 ? SEGMENTO_B1 : SEGMENTO_B2;
+    (desdeT1 ? b1 : b2).alFrente(fantasma);
+    fantasmas.insert(fantasma->key, fantasma);
+}
+
+// |T1| + |B1| <= c y |T1| + |T2| + |B1| + |B2| <= 2c
+void PoliticaARC::recortarFantasmas() {
+    int c = std::max(capacidad, 0);
+    while (b1.getSize() > 0 && t1.getSize() + b1.getSize() > c) {
+        borrarFantasma(b1.ultimo());
+    }
+    while (t1.getSize() + t2.getSize() + b1.getSize() + b2.getSize() > 2 * c) {
+        if (b2.getSize() > 0) {
+            borrarFantasma(b2.ultimo());
+        } else if (b1.getSize() > 0) {
+            borrarFantasma(b1.ultimo());
+        } else {
+            break;
+        }
+    }
+}
+
+void PoliticaARC::insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) {
+    if (capacidad <= 0) {
+        desalojados.push_back(nodo);
+        return;
+    }
+    int c = capacidad;
+    bool llena = t1.getSize() + t2.getSize() >= c;
+    LRUNode** fantasmaPtr = fantasmas.search(nodo->key);
+    LRUNode* fantasma = fantasmaPtr ? *fantasmaPtr : nullptr;
+
+    if (fantasma && fantasma->segmento == SEGMENTO_B1) {
+        // caso II: T1 deberia ser mas grande
+        objetivoT1 = std::min(c, objetivoT1 + std::max(b2.getSize() / b1.getSize(), 1));
+        if (llena) {
+            reemplazar(false, desalojados);
+        }
+        borrarFantasma(fantasma);
+        nodo->segmento = SEGMENTO_T2;
+        t2.alFrente(nodo);
+        recortarFantasmas();
+        return;
+    }
+    if (fantasma) {
+        // caso III: T2 deberia ser mas grande
+        objetivoT1 = std::max(0, objetivoT1 - std::max(b1.getSize() / b2.getSize(), 1));
+        if (llena) {
+            reemplazar(true, desalojados);
+        }
+        borrarFantasma(fantasma);
+        nodo->segmento = SEGMENTO_T2;
+        t2.alFrente(nodo);
+        recortarFantasmas();
+        return;
+    }
+
+    // caso IV: clave que no se recuerda
+    if (t1.getSize() + b1.getSize() >= c) {
+        if (t1.getSize() < c) {
+            borrarFantasma(b1.ultimo());
+            if (llena) {
+                reemplazar(false, desalojados);
+            }
+        } else {
+            // T1 ocupa toda la cache: su menos reciente sale sin dejar fantasma
+            LRUNode* victima = t1.ultimo();
+            t1.quitar(victima);
+            desalojados.push_back(victima);
+        }
+    } else if (llena || t1.getSize() + t2.getSize() + b1.getSize() + b2.getSize() >= c) {
+        if (t1.getSize() + t2.getSize() + b1.getSize() + b2.getSize() >= 2 * c && b2.getSize() > 0) {
+            borrarFantasma(b2.ultimo());
+        }
+        if (llena) {
+            reemplazar(false, desalojados);
+        }
+    }
+    nodo->segmento = SEGMENTO_T1;
+    t1.alFrente(nodo);
+    recortarFantasmas();
+}
+
+void PoliticaARC::setCapacidad(int cap, std::vector<LRUNode*>& desalojados) {
+    capacidad = cap;
+    objetivoT1 = std::min(objetivoT1, std::max(cap, 0));
+    while (t1.getSize() + t2.getSize() > std::max(cap, 0)) {
+        reemplazar(false, desalojados);
+    }
+    recortarFantasmas();
+}
+
+// como un reemplazo normal, la clave queda como fantasma
+void PoliticaARC::desalojarUno(std::vector<LRUNode*>& desalojados) {
+    reemplazar(false, desalojados);
+    recortarFantasmas();
+}
+
+void PoliticaARC::vaciar(std::vector<LRUNode*>& nodos) {
+    t2.vaciar(nodos);
+    t1.vaciar(nodos);
+    std::vector<LRUNode*> viejos;
+    b1.vaciar(viejos);
+    b2.vaciar(viejos);
+    for (LRUNode* fantasma : viejos) {
+        delete fantasma;
+    }
+    fantasmas.clear();
+    objetivoT1 = 0;
+}
+
+void PoliticaARC::listar(std::vector<const LRUNode*>& salida, int max) const {
+    t2.listar(salida, max);
+    t1.listar(salida, max);
+}
+
+// ---------- W-TinyLFU ----------
+
+PoliticaTinyLFU::PoliticaTinyLFU(int cap) : sketch(cap), capacidad(cap) {
+    calcularCapacidades();
+}
+
+// ventana del 1% (al menos 1), el protegido es el 80% del resto
+void PoliticaTinyLFU::calcularCapacidades() {
+    int c = std::max(capacidad, 0);
+    capacidadVentana = c > 0 ? std::max(1, c / 100) : 0;
+    capacidadProtegido = (c - capacidadVentana) * 4 / 5;
+}
+
+void PoliticaTinyLFU::ajustarProtegido() {
+    while (protegido.getSize() > capacidadProtegido) {
+        LRUNode* ultimo = protegido.ultimo();
+        protegido.quitar(ultimo);
+        ultimo->segmento = SEGMENTO_PRUEBA;
+        prueba.alFrente(ultimo);
+    }
+}
+
+void PoliticaTinyLFU::acceso(std::string_view key, LRUNode* nodo) {
+    sketch.incrementar(key);
+    if (!nodo) {
+        return;
+    }
+    if (nodo->segmento == SEGMENTO_VENTANA) {
+        ventana.quitar(nodo);
+        ventana.alFrente(nodo);
+    } else if (nodo->segmento == SEGMENTO_PRUEBA) {
+        prueba.quitar(nodo);
+        nodo->segmento = SEGMENTO_PROTEGIDO;
+        protegido.alFrente(nodo);
+        ajustarProtegido();
+    } else {
+        protegido.quitar(nodo);
+        protegido.alFrente(nodo);
+    }
+}
+
+// el candidato que sale de la ventana entra al SLRU si hay lugar; si no, compite con el
+// que saldria de prueba (o del protegido si prueba esta vacio). en empate gana el que ya
+// estaba, asi una clave nueva no desplaza a otra igual de frecuente
+void PoliticaTinyLFU::admitir(LRUNode* candidato, std::vector<LRUNode*>& desalojados) {
+    int capacidadPrincipal = std::max(capacidad, 0) - capacidadVentana;
+    if (prueba.getSize() + protegido.getSize() < capacidadPrincipal) {
+        candidato->segmento = SEGMENTO_PRUEBA;
+        prueba.alFrente(candidato);
+        return;
+    }
+    ListaNodosCache& origen = prueba.getSize() > 0 ? prueba : protegido;
+    LRUNode* victima = origen.ultimo();
+    if (victima && sketch.frecuencia(candidato->key) > sketch.frecuencia(victima->key)) {
+        origen.quitar(victima);
+        desalojados.push_back(victima);
+        candidato->segmento = SEGMENTO_PRUEBA;
+        prueba.alFrente(candidato);
+    } else {
+        desalojados.push_back(candidato);
+    }
+}
+
+void PoliticaTinyLFU::insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) {
+    if (capacidad <= 0) {
+        desalojados.push_back(nodo);
+        return;
+    }
+    nodo->segmento = SEGMENTO_VENTANA;
+    ventana.alFrente(nodo);
+    while (ventana.getSize() > capacidadVentana) {
+        LRUNode* candidato = ventana.ultimo();
+        ventana.quitar(candidato);
+        admitir(candidato, desalojados);
+    }
+}
+
+void PoliticaTinyLFU::setCapacidad(int cap, std::vector<LRUNode*>& desalojados) {
+    capacidad = cap;
+    calcularCapacidades();
+    sketch.redimensionar(cap);
+    int c = std::max(cap, 0);
+    while (ventana.getSize() + prueba.getSize() + protegido.getSize() > c) {
+        ListaNodosCache& origen = ventana.getSize() > capacidadVentana ? ventana
+                                : prueba.getSize() > 0 ? prueba
+                                : protegido.getSize() > 0 ? protegido : ventana;
+        LRUNode* victima = origen.ultimo();
+        origen.quitar(victima);
+        desalojados.push_back(victima);
+    }
+    // lo que sobra de la ventana pasa a prueba, el total ya entra en la capacidad
+    while (ventana.getSize() > capacidadVentana) {
+        LRUNode* ultimo = ventana.ultimo();
+        ventana.quitar(ultimo);
+        ultimo->segmento = SEGMENTO_PRUEBA;
+        prueba.alFrente(ultimo);
+    }
+    ajustarProtegido();
+}
+
+// el mismo orden que el SLRU principal, la ventana al final
+void PoliticaTinyLFU::desalojarUno(std::vector<LRUNode*>& desalojados) {
+    ListaNodosCache& origen = prueba.getSize() > 0 ? prueba : protegido.getSize() > 0 ? protegido : ventana;
+    LRUNode* ultimo = origen.ultimo();
+    if (ultimo) {
+        origen.quitar(ultimo);
+        desalojados.push_back(ultimo);
+    }
+}
+
+void PoliticaTinyLFU::vaciar(std::vector<LRUNode*>& nodos) {
+    ventana.vaciar(nodos);
+    protegido.vaciar(nodos);
+    prueba.vaciar(nodos);
+    sketch.clear();
+}
+
+void PoliticaTinyLFU::listar(std::vector<const LRUNode*>& salida, int max) const {
+    ventana.listar(salida, max);
+    protegido.listar(salida, max);
+    prueba.listar(salida, max);
+}
+
+// ---------- fabrica ----------
+
+PoliticaCache* crearPoliticaCache(int tipo, int capacidad) {
+    switch (tipo) {
+        case POLITICA_SLRU: return new PoliticaSLRU(capacidad);
+        case POLITICA_ARC: return new PoliticaARC(capacidad);
+        case POLITICA_TINYLFU: return new PoliticaTinyLFU(capacidad);
+        default: return new PoliticaLRU(capacidad);
+    }
+}
+
+const char* nombrePoliticaCache(int tipo) {
+    switch (tipo) {
+        case POLITICA_SLRU: return "SLRU (Segmented LRU)";
+        case POLITICA_ARC: return "ARC (Adaptive Replacement Cache)";
+        case POLITICA_TINYLFU: return "W-TinyLFU (ventana LRU + admision por frecuencia)";
+        default: return "LRU (Least Recently Used)";
+    }
+}
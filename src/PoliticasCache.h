@@ -0,0 +1,185 @@
+#ifndef POLITICAS_CACHE_H
+#define POLITICAS_CACHE_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "HashTable.h"
+#include "LRUCache.h"
+
+// lista doble de nodos de la cache con nodos dummy al principio y al final,
+// el frente es lo mas reciente
+class ListaNodosCache {
+public:
+    ListaNodosCache();
+    ~ListaNodosCache();
+    ListaNodosCache(const ListaNodosCache&) = delete;
+    ListaNodosCache& operator=(const ListaNodosCache&) = delete;
+
+    void alFrente(LRUNode* nodo);
+    void quitar(LRUNode* nodo);
+    LRUNode* ultimo() const; // nullptr si esta vacia
+    int getSize() const { return size; }
+    // agrega a salida hasta max nodos desde el frente
+    void listar(std::vector<const LRUNode*>& salida, int max) const;
+    // saca todos los nodos y los agrega a salida
+    void vaciar(std::vector<LRUNode*>& salida);
+
+private:
+    LRUNode* head;
+    LRUNode* tail;
+    int size;
+};
+
+// frecuencias aproximadas de las claves: 4 filas de contadores de 4 bits (guardados en
+// un byte, topan en 15). cada clave cae en un contador por fila y la estimacion es el
+// minimo. cada 10 * capacidad incrementos todos los contadores se dividen por 2, asi
+// lo que fue popular hace mucho deja de pesar
+class CountMinSketch {
+public:
+    explicit CountMinSketch(int capacidad);
+
+    void incrementar(std::string_view key);
+    int frecuencia(std::string_view key) const;
+    void redimensionar(int capacidad);
+    void clear();
+
+private:
+    static const int FILAS = 4;
+    static const uint8_t MAXIMO = 15;
+
+    std::vector<uint8_t> contadores; // FILAS * ancho
+    size_t mascara;                  // ancho - 1, el ancho es potencia de 2
+    int muestras;
+    int tamanioMuestra;
+
+    size_t posicion(size_t hash, int fila) const;
+    void envejecer();
+};
+
+// politica de reemplazo: ordena los nodos que ya estan en la tabla de la cache y decide
+// a quien sacar. LRUCache crea y libera los nodos, la politica solo los enlaza en sus
+// listas y devuelve en desalojados los que hay que borrar
+class PoliticaCache {
+public:
+    virtual ~PoliticaCache() {}
+
+    // cada get: nodo es la entrada encontrada o nullptr si fue miss
+    virtual void acceso(std::string_view key, LRUNode* nodo) = 0;
+    // nodo nuevo; puede terminar en desalojados si la politica no lo admite
+    virtual void insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) = 0;
+    virtual void setCapacidad(int capacidad, std::vector<LRUNode*>& desalojados) = 0;
+    // saca el siguiente nodo que desalojaria (para el presupuesto de bytes), nada si esta vacia
+    virtual void desalojarUno(std::vector<LRUNode*>& desalojados) = 0;
+    // saca todos los nodos (y olvida el historial) y los agrega a nodos
+    virtual void vaciar(std::vector<LRUNode*>& nodos) = 0;
+    // hasta max nodos, primero los que la politica mas quiere conservar
+    virtual void listar(std::vector<const LRUNode*>& salida, int max) const = 0;
+};
+
+// el LRU de siempre: una lista, sale el menos reciente
+class PoliticaLRU : public PoliticaCache {
+public:
+    explicit PoliticaLRU(int capacidad);
+
+    void acceso(std::string_view key, LRUNode* nodo) override;
+    void insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) override;
+    void setCapacidad(int capacidad, std::vector<LRUNode*>& desalojados) override;
+    void desalojarUno(std::vector<LRUNode*>& desalojados) override;
+    void vaciar(std::vector<LRUNode*>& nodos) override;
+    void listar(std::vector<const LRUNode*>& salida, int max) const override;
+
+private:
+    ListaNodosCache lista;
+    int capacidad;
+};
+
+// LRU segmentado: lo nuevo entra a prueba y solo pasa al segmento protegido (80% de
+// la capacidad) si se vuelve a pedir. se desaloja desde prueba, asi una rafaga de
+// consultas que se piden una sola vez no saca a las que se repiten
+class PoliticaSLRU : public PoliticaCache {
+public:
+    explicit PoliticaSLRU(int capacidad);
+
+    void acceso(std::string_view key, LRUNode* nodo) override;
+    void insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) override;
+    void setCapacidad(int capacidad, std::vector<LRUNode*>& desalojados) override;
+    void desalojarUno(std::vector<LRUNode*>& desalojados) override;
+    void vaciar(std::vector<LRUNode*>& nodos) override;
+    void listar(std::vector<const LRUNode*>& salida, int max) const override;
+
+private:
+    ListaNodosCache prueba;
+    ListaNodosCache protegido;
+    int capacidad;
+    int capacidadProtegido;
+
+    void ajustarProtegido();
+};
+
+// ARC (Megiddo y Modha): T1 tiene lo pedido una vez y T2 lo pedido mas de una vez.
+// B1 y B2 recuerdan solo las claves que salieron de T1 y T2 (fantasmas). si llega una
+// clave que esta en B1, T1 era muy chico y el objetivo p de T1 crece; si esta en B2
+// p se achica. asi el reparto entre recencia y frecuencia se ajusta solo
+class PoliticaARC : public PoliticaCache {
+public:
+    explicit PoliticaARC(int capacidad);
+    ~PoliticaARC() override;
+
+    void acceso(std::string_view key, LRUNode* nodo) override;
+    void insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) override;
+    void setCapacidad(int capacidad, std::vector<LRUNode*>& desalojados) override;
+    void desalojarUno(std::vector<LRUNode*>& desalojados) override;
+    void vaciar(std::vector<LRUNode*>& nodos) override;
+    void listar(std::vector<const LRUNode*>& salida, int max) const override;
+
+private:
+    ListaNodosCache t1;
+    ListaNodosCache t2;
+    ListaNodosCache b1; // nodos fantasma: solo clave, sin resultado
+    ListaNodosCache b2;
+    HashTable<std::string, LRUNode*> fantasmas;
+    int capacidad;
+    int objetivoT1; // p
+
+    void reemplazar(bool estabaEnB2, std::vector<LRUNode*>& desalojados);
+    void borrarFantasma(LRUNode* fantasma);
+    void recortarFantasmas();
+};
+
+// W-TinyLFU (como en Caffeine): una ventana LRU chica (1% de la capacidad) recibe todo
+// lo nuevo y el resto es un SLRU. cuando la ventana se llena su menos reciente compite
+// con el que saldria del SLRU y se queda el que tenga mas frecuencia en el sketch.
+// las frecuencias se cuentan en cada get, aunque la clave no este en la cache
+class PoliticaTinyLFU : public PoliticaCache {
+public:
+    explicit PoliticaTinyLFU(int capacidad);
+
+    void acceso(std::string_view key, LRUNode* nodo) override;
+    void insertar(LRUNode* nodo, std::vector<LRUNode*>& desalojados) override;
+    void setCapacidad(int capacidad, std::vector<LRUNode*>& desalojados) override;
+    void desalojarUno(std::vector<LRUNode*>& desalojados) override;
+    void vaciar(std::vector<LRUNode*>& nodos) override;
+    void listar(std::vector<const LRUNode*>& salida, int max) const override;
+
+private:
+    ListaNodosCache ventana;
+    ListaNodosCache prueba;
+    ListaNodosCache protegido;
+    CountMinSketch sketch;
+    int capacidad;
+    int capacidadVentana;
+    int capacidadProtegido;
+
+    void calcularCapacidades();
+    void ajustarProtegido();
+    void admitir(LRUNode* candidato, std::vector<LRUNode*>& desalojados);
+};
+
+// POLITICA_LRU, POLITICA_SLRU, POLITICA_ARC o POLITICA_TINYLFU; otro valor usa LRU
+PoliticaCache* crearPoliticaCache(int tipo, int capacidad);
+const char* nombrePoliticaCache(int tipo);
+
+#endif // POLITICAS_CACHE_H
@@ -1,11 +1,74 @@
 #include "ProcesadorDocumentos.h"
 #include "InvertedIndex.h"
 #include "Utils.h"
+#include "ArchivoMapeado.h"
 #include <iostream>
 #include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 
-ProcesadorDocumentos::ProcesadorDocumentos() {
+// tamanio de cada lectura del archivo en la carga paralela
+#ifndef TAMANIO_TROZO
+#define TAMANIO_TROZO (4 * 1024 * 1024)
+#endif
+
+// trozo de lineas completas del archivo. en la lectura con stream los bytes quedan en
+// texto, con el archivo mapeado solo se guarda la vista
+struct TrozoDocumentos {
+    int indice;
+    std::string texto;
+    std::string_view vista;
+};
+
+// indice de un trozo, sus doc ids son locales (empiezan en 0)
+struct IndiceParcial {
+    int numDocs;
+    InvertedIndex indice;
+};
+
+// estado compartido entre el productor de trozos, los trabajadores y la fusion
+struct PipelineCarga {
+    std::mutex mtx;
+    std::condition_variable cvTrozos;
+    std::condition_variable cvParciales;
+    std::deque<TrozoDocumentos> colaTrozos;
+    std::map<int, std::unique_ptr<IndiceParcial>> parcialesListos;
+    size_t maxTrozosEnCola;
+    int totalTrozos;
+    bool lecturaTerminada;
+    std::atomic<bool> detener;
+
+    PipelineCarga(size_t maxEnCola)
+        : maxTrozosEnCola(maxEnCola), totalTrozos(0), lecturaTerminada(false), detener(false) {}
+
+    // bloquea mientras la cola este llena, retorna false si la fusion pidio detenerse
+    bool encolar(std::string texto, std::string_view vista) {
+        std::unique_lock<std::mutex> lock(mtx);
+        cvTrozos.wait(lock, [&]() { return colaTrozos.size() < maxTrozosEnCola || detener; });
+        if (detener) {
+            return false;
+        }
+        colaTrozos.push_back({totalTrozos, std::move(texto), vista});
+        totalTrozos++;
+        cvTrozos.notify_all();
+        return true;
+    }
+
+    void terminarLectura() {
+        std::lock_guard<std::mutex> lock(mtx);
+        lecturaTerminada = true;
+        cvTrozos.notify_all();
+        cvParciales.notify_all();
+    }
+};
+
+ProcesadorDocumentos::ProcesadorDocumentos() : modoBulk(false), numHilos(1), limitePalabras(500'000) {
     // Constructor
 }
 
@@ -30,6 +93,9 @@ void ProcesadorDocumentos::cargarStopwords(const std::string& filename) {
 }
 
 int ProcesadorDocumentos::procesarContenidoDocumentos(const std::string& linea, int doc_id, InvertedIndex& index) {
+    if (index.esPosicional()) {
+        return procesarContenidoDocumentosPosicional(linea, doc_id, index);
+    }
     // std::cout << "VERBOSE: Iniciando procesamiento de Doc ID: " << doc_id << std::endl; // Opcional
 
     size_t separadoUltimaPos = linea.rfind("||"); // rfind retorna el primer caracter del ultimo match "https://cplusplus.com/reference/string/string/rfind/"
@@ -41,13 +107,12 @@ int ProcesadorDocumentos::procesarContenidoDocumentos(const std::string& linea,
     }
     std::string contenido = linea.substr(separadoUltimaPos+ 2); // +2 para saltas los ||
 
-    std::istringstream iss(contenido);
-    std::string palabraIndividial;
+    Utils::Tokenizador tokenizador(contenido);
+    std::string palabraLimpia;
     int contadorPalabrasSumDocActual = 0;
 
-    while (iss >> palabraIndividial) {
-        std::string palabraLimpia = Utils::cleanWord(palabraIndividial);
-
+    // el tokenizador separa por espacios y limpia cada palabra (minusculas, alfanumericos)
+    while (tokenizador.siguiente(palabraLimpia)) {
         if (!palabraLimpia.empty()) {
             if (stopWords.find(palabraLimpia) == stopWords.end()) {
                 index.addDocumento(palabraLimpia, doc_id);
@@ -59,21 +124,150 @@ int ProcesadorDocumentos::procesarContenidoDocumentos(const std::string& linea,
     return contadorPalabrasSumDocActual;
 }
 
+// el mismo chequeo que hacen los procesar* antes de tokenizar
+bool ProcesadorDocumentos::lineaBienFormada(std::string_view linea) {
+    size_t separadoUltimaPos = linea.rfind("||");
+    return separadoUltimaPos != std::string_view::npos && separadoUltimaPos + 2 < linea.length();
+}
+
+// igual que procesarContenidoDocumentos pero sin copias: la linea es una vista y cada
+// palabra limpia se escribe en un buffer por hilo que se reutiliza entre palabras
+int ProcesadorDocumentos::procesarContenidoDocumentosVista(std::string_view linea, int doc_id, InvertedIndex& index) const {
+    if (index.esPosicional()) {
+        return procesarContenidoDocumentosPosicional(linea, doc_id, index);
+    }
+    thread_local std::string palabraLimpia;
+
+    size_t separadoUltimaPos = linea.rfind("||");
+    if(separadoUltimaPos == std::string_view::npos || separadoUltimaPos + 2 >= linea.length()) {
+        std::cerr << "Advertencia: Línea mal formada (Doc ID: " << doc_id << "): " 
+        << linea.substr(0, 50)
+        << "..." << std::endl;
+        return 0;
+    }
+    std::string_view contenido = linea.substr(separadoUltimaPos + 2);
+
+    Utils::Tokenizador tokenizador(contenido);
+    int contadorPalabrasSumDocActual = 0;
+    while (tokenizador.siguiente(palabraLimpia)) {
+        if (!palabraLimpia.empty() && stopWords.find(palabraLimpia) == stopWords.end()) {
+            index.addDocumento(palabraLimpia, doc_id);
+            contadorPalabrasSumDocActual++;
+        }
+    }
+    return contadorPalabrasSumDocActual;
+}
+
+// igual que procesarContenidoDocumentos pero cuenta las palabras del documento primero,
+// asi el vocabulario se consulta una vez por termino distinto y no por cada palabra
+int ProcesadorDocumentos::procesarContenidoDocumentosBulk(const std::string& linea, int doc_id, InvertedIndex& index) {
+    if (index.esPosicional()) {
+        return procesarContenidoDocumentosPosicional(linea, doc_id, index);
+    }
+    size_t separadoUltimaPos = linea.rfind("||");
+    if(separadoUltimaPos == std::string::npos || separadoUltimaPos + 2 >= linea.length()) {
+        std::cerr << "Advertencia: Línea mal formada (Doc ID: " << doc_id << "): " 
+        << linea.substr(0, 50)
+        << "..." << std::endl;
+        return 0;
+    }
+    std::string contenido = linea.substr(separadoUltimaPos+ 2);
+
+    Utils::Tokenizador tokenizador(contenido);
+    std::string palabraLimpia;
+    int contadorPalabrasSumDocActual = 0;
+    frecuenciasDocumento.clear();
+
+    while (tokenizador.siguiente(palabraLimpia)) {
+        if (!palabraLimpia.empty() && stopWords.find(palabraLimpia) == stopWords.end()) {
+            frecuenciasDocumento[palabraLimpia]++;
+            contadorPalabrasSumDocActual++;
+        }
+    }
+
+    // los doc ids llegan en orden creciente, asi que cada add es un append O(1)
+    for (const auto& par : frecuenciasDocumento) {
+        index.addDocumento(par.first, doc_id, par.second);
+    }
+    return contadorPalabrasSumDocActual;
+}
+
+// como el bulk pero con la lista de posiciones de cada termino en vez de la frecuencia.
+// la posicion cuenta todas las palabras no vacias, stopwords incluidas, asi una frase con
+// stopwords en el medio sigue teniendo los huecos en el lugar correcto
+int ProcesadorDocumentos::procesarContenidoDocumentosPosicional(std::string_view linea, int doc_id, InvertedIndex& index) const {
+    thread_local std::string palabraLimpia;
+    thread_local std::unordered_map<std::string, std::vector<uint32_t>> posicionesDocumento;
+
+    size_t separadoUltimaPos = linea.rfind("||");
+    if(separadoUltimaPos == std::string_view::npos || separadoUltimaPos + 2 >= linea.length()) {
+        std::cerr << "Advertencia: Línea mal formada (Doc ID: " << doc_id << "): " 
+        << linea.substr(0, 50)
+        << "..." << std::endl;
+        return 0;
+    }
+    std::string_view contenido = linea.substr(separadoUltimaPos + 2);
+
+    posicionesDocumento.clear();
+
+    Utils::Tokenizador tokenizador(contenido);
+    int contadorPalabrasSumDocActual = 0;
+    uint32_t posicion = 0;
+    while (tokenizador.siguiente(palabraLimpia)) {
+        if (palabraLimpia.empty()) {
+            continue;
+        }
+        if (stopWords.find(palabraLimpia) == stopWords.end()) {
+            posicionesDocumento[palabraLimpia].push_back(posicion);
+            contadorPalabrasSumDocActual++;
+        }
+        posicion++;
+    }
+
+    for (const auto& par : posicionesDocumento) {
+        index.addDocumentoConPosiciones(par.first, doc_id, par.second.data(), static_cast<int>(par.second.size()));
+    }
+    return contadorPalabrasSumDocActual;
+}
+
+std::vector<std::pair<std::string, int>> ProcesadorDocumentos::getCleanWordsConPosicion(const std::string& text) const {
+    std::vector<std::pair<std::string, int>> cleanWords;
+    Utils::Tokenizador tokenizador(text);
+    std::string palabraLimpia;
+    int posicion = 0;
+
+    while (tokenizador.siguiente(palabraLimpia)) {
+        if (palabraLimpia.empty()) {
+            continue;
+        }
+        if (stopWords.find(palabraLimpia) == stopWords.end()) {
+            cleanWords.push_back({palabraLimpia, posicion});
+        }
+        posicion++;
+    }
+    return cleanWords;
+}
+
 std::vector<std::string> ProcesadorDocumentos::getCleanWords(const std::string& text) const {
     std::vector<std::string> cleanWords;
-    std::istringstream iss(text);
-    std::string palabraInicial;
+    Utils::Tokenizador tokenizador(text);
+    std::string palabraLimpia;
 
-    while (iss >> palabraInicial) {
-        std::string palabraLimpia = Utils::cleanWord(palabraInicial);
-        if (!palabraInicial.empty() && stopWords.find(palabraLimpia) == stopWords.end()) {
-            cleanWords.push_back(palabraInicial); // se aniade la palabra al final del vector
+    // mismo tokenizador que la indexacion, asi la consulta se normaliza igual que los documentos
+    while (tokenizador.siguiente(palabraLimpia)) {
+        if (!palabraLimpia.empty() && stopWords.find(palabraLimpia) == stopWords.end()) {
+            cleanWords.push_back(palabraLimpia); // se aniade la palabra al final del vector
         }
     }
     return cleanWords;
 }
 
 void ProcesadorDocumentos::cargaYProcesadoDocumentos(const std::string& filename, InvertedIndex& index) {
+    if (numHilos > 1) {
+        cargaYProcesadoDocumentosParalelo(filename, index);
+        return;
+    }
+
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error al abrir el archivo de documentos: " << filename << std::endl;
@@ -85,16 +279,18 @@ void ProcesadorDocumentos::cargaYProcesadoDocumentos(const std::string& filename
     int doc_id = 0;
     int contadorPalabrasProcesadas = 0;
     long long totalPalabrasIndexadas = 0; // Contador de palabras totales indexadas
-    const long long LIMITE_INDEX= 500'000; // Límite de palabras a indexar
 
     while (std::getline(file, linea)) {
-        if (totalPalabrasIndexadas>= LIMITE_INDEX) {
-            std::cout << "VERBOSE: Limite de " <<   LIMITE_INDEX << " palabras alcanzado. Deteniendo la indexacion inicial." << std::endl;
+        if (limitePalabras > 0 && totalPalabrasIndexadas >= limitePalabras) {
+            std::cout << "VERBOSE: Limite de " << limitePalabras << " palabras alcanzado. Deteniendo la indexacion inicial." << std::endl;
             break;
         }
 
         // Procesa la línea y obtiene el número de palabras añadidas
-        totalPalabrasIndexadas += procesarContenidoDocumentos(linea, doc_id, index);
+        int palabrasDocumento = modoBulk ? procesarContenidoDocumentosBulk(linea, doc_id, index)
+                                         : procesarContenidoDocumentos(linea, doc_id, index);
+        index.setLongitudDocumento(doc_id, palabrasDocumento);
+        totalPalabrasIndexadas += palabrasDocumento;
 
         doc_id++; // Incrementa el ID para el siguiente documento
         contadorPalabrasProcesadas++;
@@ -111,4 +307,218 @@ void ProcesadorDocumentos::cargaYProcesadoDocumentos(const std::string& filename
     std::cout << "VERBOSE: Finalizado el procesamiento de " << contadorPalabrasProcesadas 
             << " documentos. Total palabras indexadas: " << totalPalabrasIndexadas << std::endl;
     std::cout << "Carga y procesamiento de documentos completado." << std::endl;
-}
\ No newline at end of file
+}
+
+// carga con el archivo mapeado en memoria: las lineas y palabras se recorren con
+// string_view sobre el mapeo, sin getline ni substr ni istringstream
+void ProcesadorDocumentos::cargaYProcesadoDocumentosMmap(const std::string& filename, InvertedIndex& index) {
+    ArchivoMapeado archivo;
+    if (!archivo.abrir(filename)) {
+        std::cerr << "Error al abrir el archivo de documentos: " << filename << std::endl;
+        return;
+    }
+    std::string_view contenido = archivo.getVista();
+
+    if (numHilos > 1) {
+        std::cout << "VERBOSE: Iniciando la carga paralela mapeada (" << numHilos << " hilos) desde: " << filename << std::endl;
+        // los trozos son vistas sobre el mapeo que terminan en un salto de linea
+        indexarEnParalelo(index, [&](PipelineCarga& pipeline) {
+            size_t inicio = 0;
+            while (inicio < contenido.size()) {
+                size_t salto = std::string_view::npos;
+                if (inicio + TAMANIO_TROZO < contenido.size()) {
+                    salto = contenido.find('\n', inicio + TAMANIO_TROZO - 1);
+                }
+                size_t fin = (salto == std::string_view::npos) ? contenido.size() : salto + 1;
+                if (!pipeline.encolar(std::string(), contenido.substr(inicio, fin - inicio))) {
+                    break;
+                }
+                inicio = fin;
+            }
+        });
+        return;
+    }
+
+    std::cout << "VERBOSE: Iniciando la carga mapeada y procesamiento de documentos desde: " << filename << std::endl;
+    int doc_id = 0;
+    int contadorPalabrasProcesadas = 0;
+    long long totalPalabrasIndexadas = 0;
+    size_t inicio = 0;
+
+    while (inicio < contenido.size()) {
+        if (limitePalabras > 0 && totalPalabrasIndexadas >= limitePalabras) {
+            std::cout << "VERBOSE: Limite de " << limitePalabras << " palabras alcanzado. Deteniendo la indexacion inicial." << std::endl;
+            break;
+        }
+
+        size_t fin = contenido.find('\n', inicio);
+        if (fin == std::string_view::npos) {
+            fin = contenido.size();
+        }
+        int palabrasDocumento = procesarContenidoDocumentosVista(contenido.substr(inicio, fin - inicio), doc_id, index);
+        index.setLongitudDocumento(doc_id, palabrasDocumento);
+        totalPalabrasIndexadas += palabrasDocumento;
+        inicio = fin + 1;
+
+        doc_id++;
+        contadorPalabrasProcesadas++;
+
+        const int VERBOSE_DOC_STEP = 100;
+        if (contadorPalabrasProcesadas % VERBOSE_DOC_STEP == 0) {
+            std::cout << "VERBOSE: " << contadorPalabrasProcesadas 
+                        << " documentos procesados. Palabras indexadas: " 
+                        << totalPalabrasIndexadas << std::endl;
+        }
+    }
+    std::cout << "VERBOSE: Finalizado el procesamiento de " << contadorPalabrasProcesadas 
+            << " documentos. Total palabras indexadas: " << totalPalabrasIndexadas << std::endl;
+    std::cout << "Carga y procesamiento de documentos completado." << std::endl;
+}
+
+// carga paralela con stream: un hilo lector corta el archivo en trozos de lineas completas
+void ProcesadorDocumentos::cargaYProcesadoDocumentosParalelo(const std::string& filename, InvertedIndex& index) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error al abrir el archivo de documentos: " << filename << std::endl;
+        return;
+    }
+
+    std::cout << "VERBOSE: Iniciando la carga paralela (" << numHilos << " hilos) desde: " << filename << std::endl;
+
+    indexarEnParalelo(index, [&](PipelineCarga& pipeline) {
+        std::vector<char> buffer(TAMANIO_TROZO);
+        std::string resto;
+
+        while (file) {
+            file.read(buffer.data(), buffer.size());
+            std::streamsize leidos = file.gcount();
+            if (leidos <= 0) {
+                break;
+            }
+            resto.append(buffer.data(), leidos);
+
+            size_t ultimoSalto = resto.rfind('\n');
+            if (ultimoSalto == std::string::npos) {
+                continue; // linea mas larga que el trozo, se sigue leyendo
+            }
+            std::string texto = resto.substr(0, ultimoSalto + 1);
+            resto.erase(0, ultimoSalto + 1);
+            if (!pipeline.encolar(std::move(texto), std::string_view())) {
+                return;
+            }
+        }
+        // la ultima linea puede no terminar en salto de linea, getline igual la cuenta
+        if (!resto.empty()) {
+            pipeline.encolar(std::move(resto), std::string_view());
+        }
+    });
+    file.close();
+}
+
+// el productor corre en su propio hilo, los trabajadores indexan cada trozo en un
+// InvertedIndex parcial y el hilo principal los fusiona en orden de trozo. el doc id
+// base de cada trozo es la suma de los documentos de los trozos anteriores y el limite
+// de palabras se aplica documento por documento, igual que la carga secuencial
+void ProcesadorDocumentos::indexarEnParalelo(InvertedIndex& index, const std::function<void(PipelineCarga&)>& productor) {
+    PipelineCarga pipeline(numHilos * 2);
+
+    std::thread lector([&]() {
+        productor(pipeline);
+        pipeline.terminarLectura();
+    });
+
+    auto trabajador = [&]() {
+        while (true) {
+            TrozoDocumentos trozo;
+            {
+                std::unique_lock<std::mutex> lock(pipeline.mtx);
+                pipeline.cvTrozos.wait(lock, [&]() { return !pipeline.colaTrozos.empty() || pipeline.lecturaTerminada; });
+                if (pipeline.colaTrozos.empty()) {
+                    return;
+                }
+                trozo = std::move(pipeline.colaTrozos.front());
+                pipeline.colaTrozos.pop_front();
+            }
+            pipeline.cvTrozos.notify_all();
+
+            std::string_view texto = trozo.texto.empty() ? trozo.vista : std::string_view(trozo.texto);
+            std::unique_ptr<IndiceParcial> parcial(new IndiceParcial());
+            parcial->numDocs = 0;
+            parcial->indice.setModoPosicional(index.esPosicional());
+            size_t inicio = 0;
+            while (!pipeline.detener && inicio < texto.size()) {
+                size_t fin = texto.find('\n', inicio);
+                if (fin == std::string_view::npos) {
+                    fin = texto.size();
+                }
+                int palabrasDocumento = procesarContenidoDocumentosVista(texto.substr(inicio, fin - inicio), parcial->numDocs, parcial->indice);
+                parcial->indice.setLongitudDocumento(parcial->numDocs, palabrasDocumento);
+                parcial->numDocs++;
+                inicio = fin + 1;
+            }
+
+            std::lock_guard<std::mutex> lock(pipeline.mtx);
+            pipeline.parcialesListos[trozo.indice] = std::move(parcial);
+            pipeline.cvParciales.notify_all();
+        }
+    };
+
+    std::vector<std::thread> trabajadores;
+    for (int i = 0; i < numHilos; ++i) {
+        trabajadores.emplace_back(trabajador);
+    }
+
+    int siguienteTrozo = 0;
+    int contadorDocumentos = 0;
+    long long totalPalabrasIndexadas = 0;
+    bool limiteAlcanzado = false;
+    while (!limiteAlcanzado) {
+        std::unique_ptr<IndiceParcial> parcial;
+        {
+            std::unique_lock<std::mutex> lock(pipeline.mtx);
+            pipeline.cvParciales.wait(lock, [&]() {
+                return pipeline.parcialesListos.count(siguienteTrozo) > 0
+                    || (pipeline.lecturaTerminada && siguienteTrozo >= pipeline.totalTrozos);
+            });
+            auto it = pipeline.parcialesListos.find(siguienteTrozo);
+            if (it == pipeline.parcialesListos.end()) {
+                break;
+            }
+            parcial = std::move(it->second);
+            pipeline.parcialesListos.erase(it);
+        }
+
+        int docsAFusionar = 0;
+        while (docsAFusionar < parcial->numDocs) {
+            if (limitePalabras > 0 && totalPalabrasIndexadas >= limitePalabras) {
+                limiteAlcanzado = true;
+                break;
+            }
+            totalPalabrasIndexadas += parcial->indice.getLongitudDocumento(docsAFusionar);
+            docsAFusionar++;
+        }
+        index.agregarParcial(parcial->indice, contadorDocumentos, docsAFusionar);
+        contadorDocumentos += docsAFusionar;
+        siguienteTrozo++;
+
+        std::cout << "VERBOSE: " << contadorDocumentos
+                  << " documentos procesados. Palabras indexadas: "
+                  << totalPalabrasIndexadas << std::endl;
+    }
+
+    if (limiteAlcanzado) {
+        std::cout << "VERBOSE: Limite de " << limitePalabras << " palabras alcanzado. Deteniendo la indexacion inicial." << std::endl;
+        std::lock_guard<std::mutex> lock(pipeline.mtx);
+        pipeline.detener = true;
+        pipeline.cvTrozos.notify_all();
+    }
+
+    lector.join();
+    for (std::thread& t : trabajadores) {
+        t.join();
+    }
+
+    std::cout << "VERBOSE: Finalizado el procesamiento de " << contadorDocumentos
+            << " documentos. Total palabras indexadas: " << totalPalabrasIndexadas << std::endl;
+    std::cout << "Carga y procesamiento de documentos completado." << std::endl;
+}
@@ -2,12 +2,16 @@
 #define PROCESADOR_DOCUMENTOS_H
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <functional>
 #include <unordered_set> 
+#include <unordered_map>
 #include <fstream>       
 
 // foward declaration de InvertedIndex
 class InvertedIndex;
+struct PipelineCarga;
 
 class ProcesadorDocumentos {
 public:
@@ -17,13 +21,48 @@ public:
     void cargarStopwords(const std::string& filename);
 
     int procesarContenidoDocumentos(const std::string& contenido, int documentoId, InvertedIndex& index);
+    int procesarContenidoDocumentosBulk(const std::string& contenido, int documentoId, InvertedIndex& index);
+    int procesarContenidoDocumentosVista(std::string_view contenido, int documentoId, InvertedIndex& index) const;
+    // para indices posicionales: agrupa las posiciones de cada termino del documento
+    // (las stopwords cuentan como posicion pero no se indexan)
+    int procesarContenidoDocumentosPosicional(std::string_view contenido, int documentoId, InvertedIndex& index) const;
+    // la linea tiene el separador "||" y texto despues del ultimo. las cargas del corpus
+    // (cargaYProcesado*) indexan las mal formadas como docs vacios para que el doc id siga
+    // siendo el numero de linea; IndiceParticionado::agregarDocumento las rechaza
+    static bool lineaBienFormada(std::string_view linea);
 
     std::vector<std::string> getCleanWords(const std::string& text) const;
+    // palabras de la consulta con su posicion, numerada igual que en los documentos
+    std::vector<std::pair<std::string, int>> getCleanWordsConPosicion(const std::string& text) const;
 
     void cargaYProcesadoDocumentos(const std::string& filename, InvertedIndex& index);
+    // cargador alternativo: mmap del archivo y palabras con string_view, sin copias por palabra
+    void cargaYProcesadoDocumentosMmap(const std::string& filename, InvertedIndex& index);
+
+    // en modo bulk cada documento se agrupa antes de pasar al indice: un addDocumento
+    // por termino distinto, con su frecuencia
+    void setModoBulk(bool activo) { modoBulk = activo; }
+    bool getModoBulk() const { return modoBulk; }
+
+    // con mas de un hilo la carga se hace en paralelo: el archivo se corta en trozos de
+    // lineas completas, cada trozo se indexa en un indice parcial y al final se fusionan
+    // en orden, asi los doc ids quedan iguales a la carga secuencial
+    void setNumHilos(int hilos) { numHilos = hilos < 1 ? 1 : hilos; }
+    int getNumHilos() const { return numHilos; }
+
+    // limite de palabras a indexar, 0 = sin limite
+    void setLimitePalabras(long long limite) { limitePalabras = limite; }
+    long long getLimitePalabras() const { return limitePalabras; }
 
 private:
     std::unordered_set<std::string> stopWords;
+    std::unordered_map<std::string, int> frecuenciasDocumento; // se reutiliza entre documentos
+    bool modoBulk;
+    int numHilos;
+    long long limitePalabras;
+
+    void cargaYProcesadoDocumentosParalelo(const std::string& filename, InvertedIndex& index);
+    void indexarEnParalelo(InvertedIndex& index, const std::function<void(PipelineCarga&)>& productor);
 };
 
 #endif // PROCESADOR_DOCUMENTOS_H
\ No newline at end of file
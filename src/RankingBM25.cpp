@@ -0,0 +1,320 @@
+#include "RankingBM25.h"
+#include "Interseccion.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <queue>
+#include <set>
+
+// orden del resultado: mayor score primero, en empate el doc id menor
+static bool mejorResultado(const ResultadoRankeado& a, const ResultadoRankeado& b) {
+    if (a.score != b.score) {
+        return a.score > b.score;
+    }
+    return a.docId < b.docId;
+}
+
+struct PeorArriba {
+    bool operator()(const ResultadoRankeado& a, const ResultadoRankeado& b) const {
+        return mejorResultado(a, b);
+    }
+};
+
+// heap de tamanio k con el peor resultado arriba
+typedef std::priority_queue<ResultadoRankeado, std::vector<ResultadoRankeado>, PeorArriba> HeapTopK;
+
+static void ofrecer(HeapTopK& heap, int k, const ResultadoRankeado& resultado) {
+    if (static_cast<int>(heap.size()) < k) {
+        heap.push(resultado);
+    } else if (mejorResultado(resultado, heap.top())) {
+        heap.pop();
+        heap.push(resultado);
+    }
+}
+
+static std::vector<ResultadoRankeado> vaciarHeap(HeapTopK& heap) {
+    std::vector<ResultadoRankeado> resultado(heap.size());
+    for (size_t i = resultado.size(); i > 0; --i) {
+        resultado[i - 1] = heap.top();
+        heap.pop();
+    }
+    return resultado;
+}
+
+// lista de un termino de la consulta mientras se recorre
+struct CursorTermino {
+    const ListaPosteo* lista;
+    ListaPosteo::Iterador it;
+    double idf;
+    double cota;
+    size_t posicion; // del termino entre los distintos de la consulta
+
+    CursorTermino(const ListaPosteo* l, double i, double c, size_t p) : lista(l), it(l->begin()), idf(i), cota(c), posicion(p) {}
+};
+
+RankingBM25::RankingBM25(const InvertedIndex* idx)
+    : index(idx), pesoPageRank(0.0) {}
+
+void RankingBM25::setPageRank(const std::map<int, double>* scores, double peso, int desdeDoc, int hastaDoc) {
+    pageRankEscalado.clear();
+    pesoPageRank = 0.0;
+    if (scores == nullptr || scores->empty() || peso <= 0.0) {
+        return;
+    }
+
+    double maximo = 0.0;
+    for (const auto& pr_pair : *scores) {
+        maximo = std::max(maximo, pr_pair.second);
+    }
+    if (maximo <= 0.0) {
+        return;
+    }
+    auto desde = scores->lower_bound(std::max(desdeDoc, 0));
+    auto hasta = scores->lower_bound(hastaDoc);
+    if (desde != hasta) {
+        pageRankEscalado.assign(std::prev(hasta)->first - desdeDoc + 1, 0.0);
+        for (auto it = desde; it != hasta; ++it) {
+            pageRankEscalado[it->first - desdeDoc] = peso * it->second / maximo;
+        }
+    }
+    pesoPageRank = peso;
+}
+
+int RankingBM25::df(const std::string& termino, const ListaPosteo* lista, const EstadisticasColeccion* coleccion) {
+    if (coleccion != nullptr) {
+        auto it = coleccion->df.find(termino);
+        if (it != coleccion->df.end()) {
+            return it->second;
+        }
+    }
+    return lista->getSize();
+}
+
+double RankingBM25::aportePageRank(int doc_id) const {
+    if (doc_id < 0 || doc_id >= static_cast<int>(pageRankEscalado.size())) {
+        return 0.0;
+    }
+    return pageRankEscalado[doc_id];
+}
+
+double RankingBM25::idf(int df) const {
+    return idf(df, nullptr);
+}
+
+double RankingBM25::idf(int df, const EstadisticasColeccion* coleccion) const {
+    double n = coleccion != nullptr ? coleccion->numDocumentos : index->getNumDocumentos();
+    return std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+}
+
+double RankingBM25::scoreTermino(double idfTermino, int tf, int doc_id) const {
+    return scoreTermino(idfTermino, tf, doc_id, index->getLongitudPromedio());
+}
+
+double RankingBM25::scoreTermino(double idfTermino, int tf, int doc_id, double promedio) const {
+    return scoreLargo(idfTermino, tf, index->getLongitudDocumento(doc_id), promedio);
+}
+
+double RankingBM25::scoreLargo(double idfTermino, int tf, int largo, double promedio) {
+    double normalizacion = 1.0 - BM25_B;
+    if (promedio > 0) {
+        normalizacion += BM25_B * largo / promedio;
+    }
+    return idfTermino * tf * (BM25_K1 + 1.0) / (tf + BM25_K1 * normalizacion);
+}
+
+// el score crece con el tf y baja con el largo del doc, asi que el maximo esta en un par que
+// nadie domina. la lista se recorre una vez (y de nuevo solo si crecio); despues cada consulta
+// evalua los candidatos con su idf y su largo promedio
+double RankingBM25::cotaTermino(const std::string& termino, const ListaPosteo* lista, double idfTermino, double promedio) const {
+    std::unique_lock<std::mutex> lock(mutexCotas);
+    auto it = cotas.find(termino);
+    if (it == cotas.end() || it->second.tamanioLista != lista->getSize()) {
+        lock.unlock();
+        std::unordered_map<int, int> maxTfPorLargo;
+        for (ListaPosteo::Iterador posteo = lista->begin(); posteo.valido(); posteo.siguiente()) {
+            int& maximo = maxTfPorLargo[index->getLongitudDocumento(posteo.docId())];
+            maximo = std::max(maximo, posteo.frecuencia());
+        }
+        std::vector<std::pair<int, int>> porLargo(maxTfPorLargo.begin(), maxTfPorLargo.end());
+        std::sort(porLargo.begin(), porLargo.end());
+        Cota nueva;
+        nueva.tamanioLista = lista->getSize();
+        for (const std::pair<int, int>& par : porLargo) {
+            if (nueva.candidatos.empty() || par.second > nueva.candidatos.back().second) {
+                nueva.candidatos.push_back(par);
+            }
+        }
+        lock.lock();
+        it = cotas.insert_or_assign(termino, std::move(nueva)).first;
+    }
+
+    double cota = 0.0;
+    for (const std::pair<int, int>& par : it->second.candidatos) {
+        cota = std::max(cota, scoreLargo(idfTermino, par.second, par.first, promedio));
+    }
+    return cota * (1.0 + 1e-12); // margen por el redondeo de las sumas
+}
+
+// el score que entra al heap se suma en el orden de los terminos y no en el de las cotas,
+// asi no depende de que listas quedaron esenciales: es el mismo (bit a bit) que da
+// topKExhaustivo y que da cada segmento de un IndiceParticionado con sus propias cotas
+std::vector<ResultadoRankeado> RankingBM25::topK(const std::vector<std::string>& terminos, int k, bool conjuntiva,
+                                                 const EstadisticasColeccion* coleccion) const {
+    if (k <= 0) {
+        return std::vector<ResultadoRankeado>();
+    }
+    if (conjuntiva) {
+        return topKExhaustivo(terminos, k, true, coleccion); // la interseccion ya deja pocos candidatos
+    }
+
+    double promedio = longitudPromedio(coleccion);
+    std::set<std::string> distintos(terminos.begin(), terminos.end());
+    std::vector<CursorTermino> cursores;
+    for (const std::string& termino : distintos) {
+        const ListaPosteo* lista = index->search(termino);
+        if (lista != nullptr && lista->getSize() > 0) {
+            double idfTermino = idf(df(termino, lista, coleccion), coleccion);
+            cursores.emplace_back(lista, idfTermino, cotaTermino(termino, lista, idfTermino, promedio), cursores.size());
+        }
+    }
+    if (cursores.empty()) {
+        return std::vector<ResultadoRankeado>();
+    }
+
+    // de menor a mayor cota; acumuladas[i] = cota de los terminos 0..i + la de pagerank
+    std::sort(cursores.begin(), cursores.end(), [](const CursorTermino& a, const CursorTermino& b) {
+        return a.cota < b.cota;
+    });
+    std::vector<double> acumuladas(cursores.size());
+    double suma = pesoPageRank;
+    for (size_t i = 0; i < cursores.size(); ++i) {
+        suma += cursores[i].cota;
+        acumuladas[i] = suma;
+    }
+
+    HeapTopK heap;
+    double umbral = -1.0; // score del K-esimo, los docs se recorren en orden asi que un empate no entra
+    size_t primeraEsencial = 0; // las listas antes de esta no alcanzan solas el umbral
+    std::vector<double> aportes(cursores.size(), 0.0); // por posicion del termino
+
+    while (primeraEsencial < cursores.size()) {
+        // candidato: el menor doc de las listas esenciales
+        int doc = -1;
+        for (size_t i = primeraEsencial; i < cursores.size(); ++i) {
+            if (cursores[i].it.valido() && (doc < 0 || cursores[i].it.docId() < doc)) {
+                doc = cursores[i].it.docId();
+            }
+        }
+        if (doc < 0) {
+            break;
+        }
+
+        std::fill(aportes.begin(), aportes.end(), 0.0);
+        double score = 0.0;
+        for (size_t i = primeraEsencial; i < cursores.size(); ++i) {
+            ListaPosteo::Iterador& it = cursores[i].it;
+            if (it.valido() && it.docId() == doc) {
+                aportes[cursores[i].posicion] = scoreTermino(cursores[i].idf, it.frecuencia(), doc, promedio);
+                score += aportes[cursores[i].posicion];
+                it.siguiente();
+            }
+        }
+
+        // las no esenciales de mayor a menor cota, cortando si ya no puede superar el umbral
+        bool descartado = false;
+        for (size_t i = primeraEsencial; i > 0; --i) {
+            if (score + acumuladas[i - 1] <= umbral) {
+                descartado = true;
+                break;
+            }
+            ListaPosteo::Iterador& it = cursores[i - 1].it;
+            it.avanzarA(doc);
+            if (it.valido() && it.docId() == doc) {
+                aportes[cursores[i - 1].posicion] = scoreTermino(cursores[i - 1].idf, it.frecuencia(), doc, promedio);
+                score += aportes[cursores[i - 1].posicion];
+            }
+        }
+        if (descartado || (primeraEsencial == 0 && score + pesoPageRank <= umbral)) {
+            continue;
+        }
+
+        score = 0.0;
+        for (double aporte : aportes) {
+            score += aporte;
+        }
+        score += aportePageRank(doc);
+        ofrecer(heap, k, {doc, score});
+        if (static_cast<int>(heap.size()) == k) {
+            umbral = heap.top().score;
+            while (primeraEsencial < cursores.size() && acumuladas[primeraEsencial] <= umbral) {
+                primeraEsencial++;
+            }
+        }
+    }
+    return vaciarHeap(heap);
+}
+
+std::vector<ResultadoRankeado> RankingBM25::topKExhaustivo(const std::vector<std::string>& terminos, int k, bool conjuntiva,
+                                                           const EstadisticasColeccion* coleccion) const {
+    std::vector<ResultadoRankeado> vacio;
+    if (k <= 0) {
+        return vacio;
+    }
+
+    double promedio = longitudPromedio(coleccion);
+    std::set<std::string> distintos(terminos.begin(), terminos.end());
+    std::vector<const ListaPosteo*> listas;
+    std::vector<double> idfs;
+    for (const std::string& termino : distintos) {
+        const ListaPosteo* lista = index->search(termino);
+        if (lista == nullptr) {
+            if (conjuntiva) {
+                return vacio;
+            }
+            continue;
+        }
+        listas.push_back(lista);
+        idfs.push_back(idf(df(termino, lista, coleccion), coleccion));
+    }
+
+    HeapTopK heap;
+    if (conjuntiva) {
+        std::vector<int> docs = Interseccion::intersectar(listas);
+        std::vector<ListaPosteo::Iterador> iteradores;
+        for (const ListaPosteo* lista : listas) {
+            iteradores.push_back(lista->begin());
+        }
+        for (int doc : docs) {
+            double score = 0.0;
+            for (size_t i = 0; i < listas.size(); ++i) {
+                iteradores[i].avanzarA(doc);
+                score += scoreTermino(idfs[i], iteradores[i].frecuencia(), doc, promedio);
+            }
+            ofrecer(heap, k, {doc, score + aportePageRank(doc)});
+        }
+        return vaciarHeap(heap);
+    }
+
+    // OR: acumular el score de cada doc que aparece en alguna lista
+    std::vector<double> scores(index->getNumDocumentos(), 0.0);
+    std::vector<char> visto(scores.size(), 0);
+    for (size_t i = 0; i < listas.size(); ++i) {
+        double idfTermino = idfs[i];
+        for (ListaPosteo::Iterador it = listas[i]->begin(); it.valido(); it.siguiente()) {
+            int doc = it.docId();
+            if (doc >= static_cast<int>(scores.size())) {
+                scores.resize(doc + 1, 0.0);
+                visto.resize(doc + 1, 0);
+            }
+            scores[doc] += scoreTermino(idfTermino, it.frecuencia(), doc, promedio);
+            visto[doc] = 1;
+        }
+    }
+    for (size_t doc = 0; doc < scores.size(); ++doc) {
+        if (visto[doc]) {
+            ofrecer(heap, k, {static_cast<int>(doc), scores[doc] + aportePageRank(static_cast<int>(doc))});
+        }
+    }
+    return vaciarHeap(heap);
+}
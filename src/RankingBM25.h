@@ -0,0 +1,93 @@
+#ifndef RANKING_BM25_H
+#define RANKING_BM25_H
+
+#include <climits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "InvertedIndex.h"
+
+// parametros de BM25
+#ifndef BM25_K1
+#define BM25_K1 1.2
+#endif
+#ifndef BM25_B
+#define BM25_B 0.75
+#endif
+// peso del pagerank escalado a [0, 1] cuando se suma al BM25
+#ifndef PESO_PAGERANK_BM25
+#define PESO_PAGERANK_BM25 1.0
+#endif
+
+struct ResultadoRankeado {
+    int docId;
+    double score;
+};
+
+// datos de toda la coleccion para puntuar un pedazo (un segmento de IndiceParticionado): con
+// la cantidad de docs, el largo promedio y el df de cada termino de toda la coleccion los
+// scores son los mismos que con un solo indice. se pasan en cada consulta porque cambian
+// cuando se agregan docs y el mismo segmento puede estar en consultas de antes y de despues
+struct EstadisticasColeccion {
+    int numDocumentos;
+    double longitudPromedio;
+    std::map<std::string, int> df; // los terminos que falten usan el df de la lista del indice
+};
+
+// ranking BM25 (frecuencias y largos guardados en el indice), opcionalmente mezclado con
+// PageRank, que devuelve solo los K mejores con un heap acotado.
+// la consulta disyuntiva (OR) usa MaxScore: cada termino tiene una cota del mayor score
+// que puede aportar; las listas cuyas cotas sumadas no alcanzan al K-esimo actual dejan
+// de proponer candidatos y solo se consultan (con saltos) para los docs que si pueden entrar
+class RankingBM25 {
+public:
+    explicit RankingBM25(const InvertedIndex* index);
+
+    // pesoPageRank: el pagerank de cada doc se escala a [0, peso] (dividido por el maximo) y
+    // se suma al BM25. con nullptr o peso 0 se rankea solo por BM25.
+    // en un segmento solo se guardan los docs [desdeDoc, hastaDoc) de scores, con desdeDoc restado
+    // (ids locales), pero la escala sale del maximo de todo scores
+    void setPageRank(const std::map<int, double>* scores, double pesoPageRank, int desdeDoc = 0, int hastaDoc = INT_MAX);
+
+    // resultado ordenado de mayor a menor score (empates por doc id menor).
+    // coleccion: nullptr = las estadisticas del propio indice
+    std::vector<ResultadoRankeado> topK(const std::vector<std::string>& terminos, int k, bool conjuntiva = false,
+                                        const EstadisticasColeccion* coleccion = nullptr) const;
+    // lo mismo sin poda: se puntua cada doc de cada lista, para comparar
+    std::vector<ResultadoRankeado> topKExhaustivo(const std::vector<std::string>& terminos, int k, bool conjuntiva = false,
+                                                  const EstadisticasColeccion* coleccion = nullptr) const;
+
+    double idf(int df) const;
+    double scoreTermino(double idf, int tf, int doc_id) const;
+
+private:
+    const InvertedIndex* index;
+    std::vector<double> pageRankEscalado; // por doc id
+    double pesoPageRank;
+
+    // para la cota de cada termino (mayor score que aporta a algun doc): los pares (largo del
+    // doc, tf) que ningun otro doc de la lista supera con menos largo y mas tf. el mayor score
+    // sale siempre de uno de ellos, sea cual sea el idf y el largo promedio, asi que vale para
+    // cualquier vista de la coleccion y solo se rehace si la lista cambia. suelen ser pocos
+    struct Cota {
+        int tamanioLista;
+        std::vector<std::pair<int, int>> candidatos;
+    };
+    mutable std::unordered_map<std::string, Cota> cotas;
+    mutable std::mutex mutexCotas;
+
+    double cotaTermino(const std::string& termino, const ListaPosteo* lista, double idfTermino, double promedio) const;
+    double aportePageRank(int doc_id) const;
+    double idf(int df, const EstadisticasColeccion* coleccion) const;
+    double scoreTermino(double idf, int tf, int doc_id, double promedio) const;
+    static double scoreLargo(double idf, int tf, int largo, double promedio);
+    double longitudPromedio(const EstadisticasColeccion* coleccion) const {
+        return coleccion != nullptr ? coleccion->longitudPromedio : index->getLongitudPromedio();
+    }
+    static int df(const std::string& termino, const ListaPosteo* lista, const EstadisticasColeccion* coleccion);
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "ReproductorCache.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#include "BuscadorConCache.h"
+#include "LRUCacheConcurrente.h"
+#include "PoliticasCache.h"
+
+void reproducirLogCache(const std::string& archivoLog, const ProcesadorDocumentos& pd,
+                        const std::vector<int>& capacidades, int limite) {
+    std::ifstream log(archivoLog);
+    if (!log.is_open()) {
+        std::cerr << "[ERROR] No se pudo abrir el archivo de consultas: " << archivoLog << std::endl;
+        return;
+    }
+
+    // las claves se arman una sola vez y se reproducen con cada combinacion
+    std::vector<std::string> claves;
+    std::string linea;
+    while (std::getline(log, linea) && (limite <= 0 || static_cast<int>(claves.size()) < limite)) {
+        std::vector<std::string> terminos = pd.getCleanWords(linea);
+        if (!terminos.empty()) {
+            claves.push_back(BuscadorConCache::crearLlaveCache(terminos));
+        }
+    }
+    std::cout << "=== Reproduccion de cache: " << archivoLog << " (" << claves.size() << " consultas) ===" << std::endl;
+
+    const int politicas[] = {POLITICA_LRU, POLITICA_SLRU, POLITICA_ARC, POLITICA_TINYLFU};
+    std::cout << std::left << std::setw(12) << "politica";
+    for (int capacidad : capacidades) {
+        std::cout << std::right << std::setw(10) << capacidad;
+    }
+    std::cout << "   (tasa de aciertos %)" << std::endl;
+
+    // todas las entradas comparten el mismo resultado vacio
+    ResultadoCache vacio = std::make_shared<const ResultadoComprimido>();
+    std::cout << std::fixed << std::setprecision(2);
+    for (int politica : politicas) {
+        std::string nombre = nombrePoliticaCache(politica);
+        std::cout << std::left << std::setw(12) << nombre.substr(0, nombre.find(' '));
+        auto inicio = std::chrono::high_resolution_clock::now();
+        for (int capacidad : capacidades) {
+            LRUCacheConcurrente cache(capacidad, politica);
+            for (const std::string& clave : claves) {
+                if (!cache.get(clave)) {
+                    cache.put(clave, vacio);
+                }
+            }
+            std::cout << std::right << std::setw(10) << cache.getHitRate() * 100;
+        }
+        auto fin = std::chrono::high_resolution_clock::now();
+        std::cout << "   " << std::chrono::duration_cast<std::chrono::milliseconds>(fin - inicio).count() << " ms" << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout << std::setprecision(6);
+}
+
+void compararCacheSubconjuntos(const std::string& archivoLog, InvertedIndex* index, ProcesadorDocumentos* pd,
+                               const std::map<int, double>* pageRank, int cacheSize, int capacidadIntersecciones,
+                               int maxPares, int limite) {
+    std::ifstream log(archivoLog);
+    if (!log.is_open()) {
+        std::cerr << "[ERROR] No se pudo abrir el archivo de consultas: " << archivoLog << std::endl;
+        return;
+    }
+    std::vector<std::string> consultas;
+    std::string linea;
+    while (std::getline(log, linea) && (limite <= 0 || static_cast<int>(consultas.size()) < limite)) {
+        if (!linea.empty()) {
+            consultas.push_back(linea);
+        }
+    }
+
+    std::cout << "=== Cache de intersecciones: " << archivoLog << " (" << consultas.size()
+              << " consultas, cache de resultados de " << cacheSize << ") ===" << std::endl;
+    std::cout << std::left << std::setw(26) << "modo" << std::right << std::setw(10) << "ms"
+              << std::setw(16) << "intersecciones" << std::setw(10) << "evitadas"
+              << std::setw(10) << "reusadas" << std::setw(12) << "hits exact" << std::endl;
+
+    // 0 = clave exacta, 1 = + subconjuntos, 2 = + pares fijos
+    for (int modo = 0; modo < 3; ++modo) {
+        BuscadorConCache bs(index, pd, cacheSize, POLITICA_LRU, modo == 0 ? 0 : capacidadIntersecciones);
+        bs.setPageRankScores(pageRank);
+        bs.setMensajes(false); // sin el aviso de HIT por cada consulta
+        std::string nombre = modo == 0 ? "clave exacta" : "+ subconjuntos";
+        if (modo == 2) {
+            int fijados = bs.getIntersecciones().fijarParesFrecuentes(archivoLog, *pd, maxPares, limite);
+            nombre = "+ " + std::to_string(fijados) + " pares fijos";
+        }
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        for (const std::string& consulta : consultas) {
+            bs.queryConCache(consulta);
+        }
+        auto fin = std::chrono::high_resolution_clock::now();
+
+        EstadisticasIntersecciones estadisticas = bs.getIntersecciones().getEstadisticas();
+        std::cout << std::left << std::setw(26) << nombre << std::right << std::setw(10)
+                  << std::chrono::duration_cast<std::chrono::milliseconds>(fin - inicio).count()
+                  << std::setw(16) << estadisticas.interseccionesHechas << std::setw(10) << estadisticas.interseccionesEvitadas
+                  << std::setw(10) << estadisticas.reusadas << std::setw(12) << bs.getCache().getHits() << std::endl;
+    }
+}
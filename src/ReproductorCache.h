@@ -0,0 +1,25 @@
+#ifndef REPRODUCTOR_CACHE_H
+#define REPRODUCTOR_CACHE_H
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "InvertedIndex.h"
+#include "ProcesadorDocumentos.h"
+
+// reproduce un log de consultas contra la cache con cada politica y capacidad y
+// muestra la tasa de aciertos. solo usa las claves (terminos limpios y ordenados, igual
+// que BuscadorConCache), no necesita el indice: todo miss se guarda en la cache, aunque
+// en el motor las consultas sin resultados no se guardan. limite 0 = todo el log
+void reproducirLogCache(const std::string& archivoLog, const ProcesadorDocumentos& pd,
+                        const std::vector<int>& capacidades, int limite = 0);
+
+// reproduce el log con BuscadorConCache (indice ya cargado) solo con clave exacta, con
+// la cache de intersecciones por subconjuntos y ademas con los pares frecuentes fijos;
+// muestra el tiempo total y cuantas intersecciones se hicieron y se evitaron
+void compararCacheSubconjuntos(const std::string& archivoLog, InvertedIndex* index, ProcesadorDocumentos* pd,
+                               const std::map<int, double>* pageRank, int cacheSize, int capacidadIntersecciones,
+                               int maxPares, int limite = 0);
+
+#endif
@@ -0,0 +1,49 @@
+#include "ResultadoComprimido.h"
+
+static void escribirVarint(std::vector<uint8_t>& salida, uint32_t v) {
+    while (v >= 0x80) {
+        salida.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    salida.push_back(static_cast<uint8_t>(v));
+}
+
+static const uint8_t* leerVarint(const uint8_t* p, uint32_t& v) {
+    v = 0;
+    int desplazamiento = 0;
+    while (*p & 0x80) {
+        v |= static_cast<uint32_t>(*p & 0x7F) << desplazamiento;
+        desplazamiento += 7;
+        p++;
+    }
+    v |= static_cast<uint32_t>(*p) << desplazamiento;
+    return p + 1;
+}
+
+// CONSTRUCTOR codifica los docs; la reserva inicial es la de 2 bytes por doc y al final
+// se devuelve lo que sobra
+ResultadoComprimido::ResultadoComprimido(const std::vector<int>& docs) : cantidad(docs.size()) {
+    datos.reserve(docs.size() * 2);
+    int64_t anterior = 0;
+    for (int doc : docs) {
+        int64_t diferencia = static_cast<int64_t>(doc) - anterior;
+        escribirVarint(datos, static_cast<uint32_t>((static_cast<uint64_t>(diferencia) << 1) ^ static_cast<uint64_t>(diferencia >> 63)));
+        anterior = doc;
+    }
+    datos.shrink_to_fit();
+}
+
+std::vector<int> ResultadoComprimido::descomprimir(size_t maximo) const {
+    size_t cuantos = maximo < cantidad ? maximo : cantidad;
+    std::vector<int> docs;
+    docs.reserve(cuantos);
+    const uint8_t* p = datos.data();
+    int64_t anterior = 0;
+    for (size_t i = 0; i < cuantos; ++i) {
+        uint32_t zigzag;
+        p = leerVarint(p, zigzag);
+        anterior += static_cast<int64_t>(zigzag >> 1) ^ -static_cast<int64_t>(zigzag & 1);
+        docs.push_back(static_cast<int>(anterior));
+    }
+    return docs;
+}
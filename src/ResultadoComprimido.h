@@ -0,0 +1,35 @@
+#ifndef RESULTADO_COMPRIMIDO_H
+#define RESULTADO_COMPRIMIDO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// resultado de una consulta tal como lo guarda la cache: los doc ids en el orden del
+// resultado, cada uno como diferencia con el anterior en varint. la diferencia va en
+// zigzag porque los resultados ordenados por pagerank no son crecientes; los ordenados
+// por doc id (un solo termino, intersecciones) quedan en 1 o 2 bytes por doc.
+// es inmutable, asi se puede compartir entre hilos sin copiarlo
+class ResultadoComprimido {
+public:
+    ResultadoComprimido() : cantidad(0) {}
+    explicit ResultadoComprimido(const std::vector<int>& docs);
+
+    size_t size() const { return cantidad; }
+    bool empty() const { return cantidad == 0; }
+    // los primeros maximo doc ids (todos por defecto), solo se decodifica lo que se pide
+    std::vector<int> descomprimir(size_t maximo = SIZE_MAX) const;
+    // objeto + bytes comprimidos
+    size_t bytesUsados() const { return sizeof(ResultadoComprimido) + datos.capacity(); }
+
+private:
+    std::vector<uint8_t> datos;
+    size_t cantidad;
+};
+
+// un hit entrega otra referencia al mismo resultado (sin copiar) y desalojar solo suelta
+// la referencia de la cache, quien lo este leyendo lo sigue teniendo
+using ResultadoCache = std::shared_ptr<const ResultadoComprimido>;
+
+#endif
@@ -0,0 +1,461 @@
+#include "ServidorConsultas.h"
+#include "IndiceParticionado.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// CONSTRUCTOR el socket se crea en escuchar()
+ServidorConsultas::ServidorConsultas(const BuscadorConCache* b, int hilos, int k)
+    : buscador(b), indexador(nullptr), procesador(nullptr), numHilos(hilos > 0 ? hilos : static_cast<int>(std::thread::hardware_concurrency())), topK(k),
+      fdEscucha(-1), fdEpoll(-1), fdAviso(-1), detenido(false), consultasAtendidas(0), conexionesAceptadas(0),
+      siguienteConexion(1) {
+    if (numHilos < 1) {
+        numHilos = 1;
+    }
+}
+
+// el JSON de una consulta: total, los topK primeros docs y el tiempo en el servidor
+std::string ServidorConsultas::responder(const std::string& consulta) const {
+    if (indexador != nullptr && !consulta.empty() && consulta[0] == '+') {
+        int docId = indexador->agregarDocumento(std::string_view(consulta).substr(1), *procesador);
+        if (docId < 0) {
+            return "{\"error\":\"documento mal formado, se espera +id||url||texto\"}\n";
+        }
+        return "{\"doc\":" + std::to_string(docId) + "}\n";
+    }
+    auto inicio = std::chrono::steady_clock::now();
+    ResultadoCache resultado = buscador->queryConCache(consulta);
+    std::vector<int> docs = resultado->descomprimir(static_cast<size_t>(topK));
+    auto fin = std::chrono::steady_clock::now();
+
+    std::string texto = "{\"total\":" + std::to_string(resultado->size()) + ",\"docs\":[";
+    for (size_t i = 0; i < docs.size(); ++i) {
+        if (i > 0) {
+            texto += ',';
+        }
+        texto += std::to_string(docs[i]);
+    }
+    texto += "],\"us\":" + std::to_string(std::chrono::duration_cast<std::chrono::microseconds>(fin - inicio).count()) + "}\n";
+    return texto;
+}
+
+void ServidorConsultas::trabajar() {
+    while (true) {
+        Pedido pedido;
+        {
+            std::unique_lock<std::mutex> lock(mutexPedidos);
+            hayPedidos.wait(lock, [this]() { return !pedidos.empty() || detenido.load(); });
+            if (detenido.load()) {
+                return;
+            }
+            pedido = std::move(pedidos.front());
+            pedidos.pop_front();
+        }
+        Respuesta respuesta{pedido.conexion, pedido.secuencia, responder(pedido.consulta)};
+        consultasAtendidas++;
+        bool estabaVacia;
+        {
+            std::lock_guard<std::mutex> lock(mutexRespuestas);
+            estabaVacia = respuestas.empty();
+            respuestas.push_back(std::move(respuesta));
+        }
+        // si ya habia respuestas el hilo de epoll ya fue avisado y todavia no las junto
+        if (estabaVacia) {
+            avisar();
+        }
+    }
+}
+
+#ifdef __linux__
+
+#define ERROR_CONSULTA_LARGA "{\"error\":\"consulta demasiado larga\"}\n"
+#define ERROR_DOCUMENTO_LARGO "{\"error\":\"documento demasiado largo\"}\n"
+
+ServidorConsultas::~ServidorConsultas() {
+    detener();
+    despertarTrabajadores();
+    for (std::thread& t : trabajadores) {
+        t.join();
+    }
+    while (!conexiones.empty()) {
+        cerrar(conexiones.begin()->first);
+    }
+    if (fdEscucha >= 0) {
+        close(fdEscucha);
+        unlink(rutaSocket.c_str());
+    }
+    if (fdEpoll >= 0) {
+        close(fdEpoll);
+    }
+    if (fdAviso >= 0) {
+        close(fdAviso);
+    }
+}
+
+bool ServidorConsultas::escuchar(const std::string& ruta) {
+    sockaddr_un direccion;
+    std::memset(&direccion, 0, sizeof(direccion));
+    direccion.sun_family = AF_UNIX;
+    if (ruta.size() >= sizeof(direccion.sun_path)) {
+        std::cerr << "[SERVIDOR] Ruta de socket demasiado larga: " << ruta << std::endl;
+        return false;
+    }
+    std::memcpy(direccion.sun_path, ruta.c_str(), ruta.size() + 1);
+
+    fdEscucha = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    fdEpoll = epoll_create1(EPOLL_CLOEXEC);
+    fdAviso = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fdEscucha < 0 || fdEpoll < 0 || fdAviso < 0) {
+        std::cerr << "[SERVIDOR] No se pudo crear el socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    unlink(ruta.c_str());
+    if (bind(fdEscucha, reinterpret_cast<sockaddr*>(&direccion), sizeof(direccion)) < 0 || listen(fdEscucha, SOMAXCONN) < 0) {
+        std::cerr << "[SERVIDOR] No se pudo escuchar en " << ruta << ": " << std::strerror(errno) << std::endl;
+        close(fdEscucha);
+        fdEscucha = -1;
+        return false;
+    }
+    rutaSocket = ruta;
+
+    // las conexiones se registran con su id (>= 1); 0 es el socket de escucha y el eventfd
+    // se distingue por el fd
+    epoll_event evento;
+    std::memset(&evento, 0, sizeof(evento));
+    evento.events = EPOLLIN;
+    evento.data.u64 = 0;
+    epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fdEscucha, &evento);
+    evento.data.u64 = UINT64_MAX;
+    epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fdAviso, &evento);
+    return true;
+}
+
+void ServidorConsultas::avisar() {
+    uint64_t uno = 1;
+    ssize_t escrito = write(fdAviso, &uno, sizeof(uno));
+    (void)escrito; // si el contador ya esta lleno el aviso ya esta pendiente
+}
+
+// solo el store atomico y el aviso por el eventfd, se puede llamar desde un manejador de
+// senial. el hilo de epoll sale de correr() y ahi despierta a los trabajadores
+void ServidorConsultas::detener() {
+    detenido = true;
+    if (fdAviso >= 0) {
+        avisar();
+    }
+}
+
+// detenido se marca con mutexPedidos tomado: un trabajador que ya reviso la condicion y la vio
+// en false todavia tiene el mutex hasta quedar esperando, asi que no puede perderse el aviso
+void ServidorConsultas::despertarTrabajadores() {
+    {
+        std::lock_guard<std::mutex> lock(mutexPedidos);
+        detenido = true;
+    }
+    hayPedidos.notify_all();
+}
+
+void ServidorConsultas::correr() {
+    if (fdEscucha < 0) {
+        return;
+    }
+    for (int i = 0; i < numHilos; ++i) {
+        trabajadores.emplace_back(&ServidorConsultas::trabajar, this);
+    }
+
+    const int MAX_EVENTOS = 256;
+    epoll_event eventos[MAX_EVENTOS];
+    while (!detenido.load()) {
+        int cantidad = epoll_wait(fdEpoll, eventos, MAX_EVENTOS, -1);
+        if (cantidad < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "[SERVIDOR] epoll_wait: " << std::strerror(errno) << std::endl;
+            break;
+        }
+        for (int i = 0; i < cantidad; ++i) {
+            uint64_t id = eventos[i].data.u64;
+            if (id == 0) {
+                aceptar();
+            } else if (id == UINT64_MAX) {
+                uint64_t contador;
+                ssize_t leido = read(fdAviso, &contador, sizeof(contador));
+                (void)leido;
+                repartirRespuestas();
+            } else if (eventos[i].events & (EPOLLERR | EPOLLHUP)) {
+                cerrar(id);
+            } else {
+                if (eventos[i].events & EPOLLIN) {
+                    leer(id);
+                }
+                if ((eventos[i].events & EPOLLOUT) && conexiones.count(id)) {
+                    escribir(id);
+                }
+            }
+        }
+    }
+
+    despertarTrabajadores();
+    for (std::thread& t : trabajadores) {
+        t.join();
+    }
+    trabajadores.clear();
+}
+
+void ServidorConsultas::aceptar() {
+    while (true) {
+        int fd = accept4(fdEscucha, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+                std::cerr << "[SERVIDOR] accept: " << std::strerror(errno) << std::endl;
+            }
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        uint64_t id = siguienteConexion++;
+        Conexion* conexion = new Conexion();
+        conexion->id = id;
+        conexion->fd = fd;
+        conexion->enviado = 0;
+        conexion->siguienteSecuencia = 0;
+        conexion->siguienteAEnviar = 0;
+        conexion->eventos = EPOLLIN | EPOLLRDHUP;
+        conexion->leyendo = true;
+        conexion->finEntrada = false;
+        conexion->descartando = false;
+        conexion->sinFinDeLinea = 0;
+        conexiones[id] = conexion;
+        conexionesAceptadas++;
+
+        epoll_event evento;
+        std::memset(&evento, 0, sizeof(evento));
+        evento.events = conexion->eventos;
+        evento.data.u64 = id;
+        epoll_ctl(fdEpoll, EPOLL_CTL_ADD, fd, &evento);
+    }
+}
+
+void ServidorConsultas::leer(uint64_t id) {
+    auto it = conexiones.find(id);
+    if (it == conexiones.end()) {
+        return;
+    }
+    Conexion* conexion = it->second;
+    char buffer[16384];
+    while (conexion->leyendo) {
+        ssize_t leido = read(conexion->fd, buffer, sizeof(buffer));
+        if (leido > 0) {
+            conexion->entrada.append(buffer, static_cast<size_t>(leido));
+            procesarLineas(id);
+            continue;
+        }
+        if (leido == 0) {
+            conexion->finEntrada = true;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+            cerrar(id);
+            return;
+        }
+        break;
+    }
+    if (conexion->finEntrada) {
+        conexion->leyendo = false;
+    }
+    // escribe lo que ya este listo (un error de linea larga), cierra si el cliente termino
+    // y no queda nada por responder, y actualiza los eventos de epoll
+    escribir(id);
+}
+
+bool ServidorConsultas::esDocumento(const std::string& entrada, size_t inicio) const {
+    return indexador != nullptr && inicio < entrada.size() && entrada[inicio] == '+';
+}
+
+// cada linea completa pasa a ser un pedido, hasta el maximo de pendientes. un documento puede
+// llegar en muchas lecturas: lo ya revisado de la linea sin terminar no se vuelve a recorrer
+void ServidorConsultas::procesarLineas(uint64_t id) {
+    Conexion* conexion = conexiones[id];
+    size_t inicio = 0;
+    bool lineaIncompleta = false;
+    std::vector<Pedido> nuevos;
+    while (conexion->siguienteSecuencia - conexion->siguienteAEnviar < MAX_PENDIENTES_CONEXION) {
+        size_t fin = conexion->entrada.find('\n', inicio == 0 ? conexion->sinFinDeLinea : inicio);
+        if (fin == std::string::npos) {
+            lineaIncompleta = true;
+            break;
+        }
+        size_t largo = fin - inicio;
+        if (largo > 0 && conexion->entrada[fin - 1] == '\r') {
+            largo--;
+        }
+        bool documento = esDocumento(conexion->entrada, inicio);
+        if (conexion->descartando) {
+            // el final de una linea demasiado larga, su error ya se respondio
+            conexion->descartando = false;
+        } else if (largo > (documento ? MAX_LARGO_DOCUMENTO : MAX_LARGO_CONSULTA)) {
+            conexion->terminadas[conexion->siguienteSecuencia++] = documento ? ERROR_DOCUMENTO_LARGO : ERROR_CONSULTA_LARGA;
+        } else {
+            nuevos.push_back(Pedido{id, conexion->siguienteSecuencia++, conexion->entrada.substr(inicio, largo)});
+        }
+        inicio = fin + 1;
+    }
+    conexion->entrada.erase(0, inicio);
+    conexion->sinFinDeLinea = lineaIncompleta ? conexion->entrada.size() : 0;
+
+    // una linea sin terminar que ya pasa el maximo: error y se descarta hasta el "\n"
+    bool documento = esDocumento(conexion->entrada, 0);
+    if (lineaIncompleta && conexion->entrada.size() > (documento ? MAX_LARGO_DOCUMENTO : MAX_LARGO_CONSULTA)) {
+        if (!conexion->descartando) {
+            conexion->terminadas[conexion->siguienteSecuencia++] = documento ? ERROR_DOCUMENTO_LARGO : ERROR_CONSULTA_LARGA;
+            conexion->descartando = true;
+        }
+        conexion->entrada.clear();
+        conexion->sinFinDeLinea = 0;
+    }
+
+    if (!nuevos.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutexPedidos);
+            for (Pedido& pedido : nuevos) {
+                pedidos.push_back(std::move(pedido));
+            }
+        }
+        if (nuevos.size() == 1) {
+            hayPedidos.notify_one();
+        } else {
+            hayPedidos.notify_all();
+        }
+    }
+
+    // demasiadas pendientes: no se lee mas hasta que respondan
+    if (conexion->siguienteSecuencia - conexion->siguienteAEnviar >= MAX_PENDIENTES_CONEXION && conexion->leyendo) {
+        conexion->leyendo = false;
+        actualizarEventos(conexion);
+    }
+}
+
+void ServidorConsultas::repartirRespuestas() {
+    std::vector<Respuesta> listas;
+    {
+        std::lock_guard<std::mutex> lock(mutexRespuestas);
+        listas.swap(respuestas);
+    }
+    std::vector<uint64_t> tocadas;
+    for (Respuesta& respuesta : listas) {
+        auto it = conexiones.find(respuesta.conexion);
+        if (it == conexiones.end()) {
+            continue; // la conexion se cerro mientras se respondia
+        }
+        it->second->terminadas[respuesta.secuencia] = std::move(respuesta.texto);
+        tocadas.push_back(respuesta.conexion);
+    }
+    std::sort(tocadas.begin(), tocadas.end());
+    tocadas.erase(std::unique(tocadas.begin(), tocadas.end()), tocadas.end());
+    for (uint64_t id : tocadas) {
+        escribir(id);
+    }
+}
+
+// pasa a la salida las respuestas que ya pueden ir (en orden) y escribe lo que se pueda
+void ServidorConsultas::escribir(uint64_t id) {
+    auto it = conexiones.find(id);
+    if (it == conexiones.end()) {
+        return;
+    }
+    Conexion* conexion = it->second;
+    auto pasarTerminadas = [conexion]() {
+        auto terminada = conexion->terminadas.begin();
+        while (terminada != conexion->terminadas.end() && terminada->first == conexion->siguienteAEnviar) {
+            conexion->salida += terminada->second;
+            conexion->siguienteAEnviar++;
+            terminada = conexion->terminadas.erase(terminada);
+        }
+    };
+    pasarTerminadas();
+    // se libero lugar: volver a leer, primero las lineas que ya estaban en el buffer
+    if (!conexion->leyendo && !conexion->finEntrada
+        && conexion->siguienteSecuencia - conexion->siguienteAEnviar <= MAX_PENDIENTES_CONEXION / 2) {
+        conexion->leyendo = true;
+        procesarLineas(id);
+        pasarTerminadas();
+    }
+
+    while (conexion->enviado < conexion->salida.size()) {
+        ssize_t escrito = send(conexion->fd, conexion->salida.data() + conexion->enviado,
+                               conexion->salida.size() - conexion->enviado, MSG_NOSIGNAL);
+        if (escrito > 0) {
+            conexion->enviado += static_cast<size_t>(escrito);
+        } else if (escrito < 0 && errno == EINTR) {
+            continue;
+        } else if (escrito < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        } else {
+            cerrar(id);
+            return;
+        }
+    }
+    if (conexion->enviado == conexion->salida.size()) {
+        conexion->salida.clear();
+        conexion->enviado = 0;
+    }
+
+    if (conexion->finEntrada && conexion->siguienteSecuencia == conexion->siguienteAEnviar && conexion->salida.empty()) {
+        cerrar(id);
+        return;
+    }
+    actualizarEventos(conexion);
+}
+
+// solo llama a epoll_ctl si cambian los eventos
+void ServidorConsultas::actualizarEventos(Conexion* conexion) {
+    uint32_t eventos = (conexion->leyendo ? EPOLLIN | EPOLLRDHUP : 0u) | (conexion->salida.empty() ? 0u : EPOLLOUT);
+    if (eventos == conexion->eventos) {
+        return;
+    }
+    conexion->eventos = eventos;
+    epoll_event evento;
+    std::memset(&evento, 0, sizeof(evento));
+    evento.events = eventos;
+    evento.data.u64 = conexion->id;
+    epoll_ctl(fdEpoll, EPOLL_CTL_MOD, conexion->fd, &evento);
+}
+
+void ServidorConsultas::cerrar(uint64_t id) {
+    auto it = conexiones.find(id);
+    if (it == conexiones.end()) {
+        return;
+    }
+    epoll_ctl(fdEpoll, EPOLL_CTL_DEL, it->second->fd, nullptr);
+    close(it->second->fd);
+    delete it->second;
+    conexiones.erase(it);
+}
+
+#else
+
+ServidorConsultas::~ServidorConsultas() {}
+
+bool ServidorConsultas::escuchar(const std::string& ruta) {
+    std::cerr << "[SERVIDOR] El modo servidor (" << ruta << ") solo esta disponible en Linux." << std::endl;
+    return false;
+}
+
+void ServidorConsultas::avisar() {}
+void ServidorConsultas::detener() { detenido = true; }
+void ServidorConsultas::correr() {}
+
+#endif
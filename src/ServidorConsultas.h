@@ -0,0 +1,124 @@
+#ifndef SERVIDOR_CONSULTAS_H
+#define SERVIDOR_CONSULTAS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "BuscadorConCache.h"
+
+class IndiceParticionado;
+
+// consultas de una conexion sin responder; con mas se deja de leer esa conexion hasta
+// que baje a la mitad
+#define MAX_PENDIENTES_CONEXION 1024
+// una linea mas larga que esto se responde con error y se descarta
+#define MAX_LARGO_CONSULTA 4096
+// lo mismo para las lineas "+id||url||texto" (con indexador), que traen un documento entero
+#define MAX_LARGO_DOCUMENTO (16u << 20)
+
+// modo servidor: el indice se carga una vez y las consultas llegan por un socket Unix.
+// protocolo: una consulta por linea, y por cada una una linea JSON en el mismo orden:
+//   {"total":N,"docs":[los topK primeros],"us":T}   (T = microsegundos en el servidor)
+// con indexador, una linea "+id||url||texto" agrega ese doc y se responde {"doc":ID}, o
+// {"error":...} si esta mal formada; aparece en las consultas cuando se sella su segmento
+// (ver IndiceParticionado)
+// un solo hilo atiende todos los sockets con epoll (aceptar, leer y escribir sin
+// bloquear) y un pool de hilos corre queryConCache. una conexion puede mandar muchas
+// consultas sin esperar las respuestas (pipelining): cada consulta lleva un numero de
+// secuencia y las respuestas que terminan antes esperan a las anteriores. solo Linux
+class ServidorConsultas {
+public:
+    // numHilos 0 = uno por nucleo
+    ServidorConsultas(const BuscadorConCache* buscador, int numHilos = 0, int topK = 10);
+    ~ServidorConsultas();
+    ServidorConsultas(const ServidorConsultas&) = delete;
+    ServidorConsultas& operator=(const ServidorConsultas&) = delete;
+
+    // los docs que llegan con "+" se agregan a indice, tokenizados con pd
+    void setIndexador(IndiceParticionado* indice, const ProcesadorDocumentos* pd) { indexador = indice; procesador = pd; }
+
+    // crea el socket en ruta (si ya habia un archivo ahi se borra)
+    bool escuchar(const std::string& ruta);
+    // atiende hasta que se llame detener()
+    void correr();
+    // se puede llamar desde otro hilo o desde un manejador de senial
+    void detener();
+
+    long long getConsultasAtendidas() const { return consultasAtendidas.load(); }
+    long long getConexionesAceptadas() const { return conexionesAceptadas; }
+
+private:
+    struct Pedido {
+        uint64_t conexion;
+        uint64_t secuencia;
+        std::string consulta;
+    };
+    struct Respuesta {
+        uint64_t conexion;
+        uint64_t secuencia;
+        std::string texto;
+    };
+    struct Conexion {
+        uint64_t id;
+        int fd;
+        std::string entrada;     // bytes leidos que todavia no forman una linea completa
+        std::string salida;      // respuestas listas para escribir, en orden
+        size_t enviado;          // bytes de salida ya escritos
+        uint64_t siguienteSecuencia;
+        uint64_t siguienteAEnviar;
+        std::map<uint64_t, std::string> terminadas; // respuestas que esperan a una anterior
+        uint32_t eventos;        // los registrados en epoll
+        bool leyendo;            // EPOLLIN activo
+        bool finEntrada;         // el cliente cerro su lado, se cierra al responder todo
+        bool descartando;        // salteando el resto de una linea demasiado larga
+        size_t sinFinDeLinea;    // bytes del principio de entrada que ya se sabe que no tienen '\n'
+    };
+
+    const BuscadorConCache* buscador;
+    IndiceParticionado* indexador;
+    const ProcesadorDocumentos* procesador;
+    int numHilos;
+    int topK;
+    std::string rutaSocket;
+    int fdEscucha;
+    int fdEpoll;
+    int fdAviso; // eventfd: respuestas nuevas o pedido de detener
+
+    std::atomic<bool> detenido;
+    std::atomic<long long> consultasAtendidas;
+    long long conexionesAceptadas;
+    uint64_t siguienteConexion;
+    std::unordered_map<uint64_t, Conexion*> conexiones;
+
+    std::mutex mutexPedidos;
+    std::condition_variable hayPedidos;
+    std::deque<Pedido> pedidos;
+    std::mutex mutexRespuestas;
+    std::vector<Respuesta> respuestas;
+    std::vector<std::thread> trabajadores;
+
+    void trabajar();
+    void despertarTrabajadores();
+    std::string responder(const std::string& consulta) const;
+    void avisar();
+
+    void aceptar();
+    void leer(uint64_t id);
+    void procesarLineas(uint64_t id);
+    // la linea que empieza en inicio es un documento para agregar (y no una consulta)
+    bool esDocumento(const std::string& entrada, size_t inicio) const;
+    void repartirRespuestas();
+    void escribir(uint64_t id);
+    void actualizarEventos(Conexion* conexion);
+    void cerrar(uint64_t id);
+};
+
+#endif
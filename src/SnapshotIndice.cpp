@@ -0,0 +1,265 @@
+#include "SnapshotIndice.h"
+#include "InvertedIndex.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+// FNV-1a de 64 bits, se puede ir acumulando por partes
+static uint64_t fnv1a(const void* datos, size_t largo, uint64_t hash = 1469598103934665603ull) {
+    const uint8_t* p = static_cast<const uint8_t*>(datos);
+    for (size_t i = 0; i < largo; ++i) {
+        hash ^= p[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static uint64_t alinear8(uint64_t v) {
+    return (v + 7) & ~static_cast<uint64_t>(7);
+}
+
+// escribe bytes y los suma al checksum si corresponde
+static void escribirBytes(std::ofstream& out, const void* datos, size_t largo, uint64_t* checksum) {
+    out.write(static_cast<const char*>(datos), largo);
+    if (checksum != nullptr) {
+        *checksum = fnv1a(datos, largo, *checksum);
+    }
+}
+
+static void escribirRelleno(std::ofstream& out, uint64_t posicion, uint64_t* checksum) {
+    static const char ceros[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+    escribirBytes(out, ceros, alinear8(posicion) - posicion, checksum);
+}
+
+// CONSTRUCTOR snapshot sin abrir
+SnapshotIndice::SnapshotIndice()
+    : cabecera(nullptr), terminos(nullptr), texto(nullptr), bloques(nullptr),
+      datos(nullptr), longitudes(nullptr), pageRank(nullptr) {}
+
+// un archivo que no esta cuenta con tamanio y fecha -1, asi aparecer o desaparecer tambien cambia la huella
+uint64_t SnapshotIndice::huellaOrigen(const std::vector<std::string>& archivos, const std::vector<long long>& parametros) {
+    uint64_t hash = fnv1a(nullptr, 0);
+    for (const std::string& ruta : archivos) {
+        std::error_code error;
+        long long datos[2] = {-1, -1};
+        uintmax_t tamanio = std::filesystem::file_size(ruta, error);
+        if (!error) {
+            datos[0] = static_cast<long long>(tamanio);
+            std::filesystem::file_time_type fecha = std::filesystem::last_write_time(ruta, error);
+            datos[1] = error ? -1 : static_cast<long long>(fecha.time_since_epoch().count());
+        }
+        hash = fnv1a(ruta.data(), ruta.size() + 1, hash); // con el '\0' para separar las rutas
+        hash = fnv1a(datos, sizeof(datos), hash);
+    }
+    return fnv1a(parametros.data(), parametros.size() * sizeof(long long), hash);
+}
+
+bool SnapshotIndice::escribir(const std::string& filename, InvertedIndex& index, const std::map<int, double>& scores,
+                              uint64_t huellaOrigen) {
+    // los terminos se escriben en orden alfabetico para buscarlos con busqueda binaria
+    const DiccionarioTerminos& diccionario = index.getDiccionario();
+    const std::vector<uint32_t>& ids = diccionario.ordenados();
+
+    // primera pasada: sellar las listas y calcular donde va cada una
+    std::vector<EntradaTerminoSnapshot> entradas;
+    entradas.reserve(ids.size());
+    uint64_t largoTexto = 0;
+    uint64_t totalBloques = 0;
+    uint64_t totalDatos = 0;
+    for (uint32_t id : ids) {
+        ListaPosteo* lista = index.getEntrada(id)->listaPosteo;
+        lista->sellar();
+
+        EntradaTerminoSnapshot entrada;
+        entrada.offsetTexto = largoTexto;
+        entrada.largoTexto = static_cast<uint32_t>(diccionario.getTermino(id).size());
+        entrada.primerBloque = totalBloques;
+        entrada.numBloques = static_cast<uint32_t>(lista->getNumBloques());
+        entrada.offsetDatos = totalDatos;
+        entrada.bytesDatos = lista->getBytesDatos();
+        entrada.numPosteos = lista->getSize();
+        entrada.ultimoDoc = lista->getUltimoDoc();
+        entradas.push_back(entrada);
+
+        largoTexto += entrada.largoTexto;
+        totalBloques += entrada.numBloques;
+        totalDatos += entrada.bytesDatos;
+    }
+
+    CabeceraSnapshot cabecera;
+    std::memset(&cabecera, 0, sizeof(cabecera));
+    std::memcpy(cabecera.magic, SNAPSHOT_MAGIC, sizeof(cabecera.magic));
+    cabecera.version = SNAPSHOT_VERSION;
+    cabecera.huellaOrigen = huellaOrigen;
+    cabecera.numTerminos = static_cast<uint32_t>(entradas.size());
+    cabecera.numDocumentos = static_cast<uint32_t>(index.getNumDocumentos());
+    cabecera.numPageRank = static_cast<uint32_t>(scores.size());
+    cabecera.offsetTerminos = alinear8(sizeof(CabeceraSnapshot));
+    cabecera.offsetTexto = alinear8(cabecera.offsetTerminos + entradas.size() * sizeof(EntradaTerminoSnapshot));
+    cabecera.offsetBloques = alinear8(cabecera.offsetTexto + largoTexto);
+    cabecera.offsetDatos = alinear8(cabecera.offsetBloques + totalBloques * sizeof(BloquePosteo));
+    cabecera.offsetLongitudes = alinear8(cabecera.offsetDatos + totalDatos);
+    cabecera.offsetPageRank = alinear8(cabecera.offsetLongitudes + cabecera.numDocumentos * sizeof(int32_t));
+    cabecera.tamanioTotal = cabecera.offsetPageRank + scores.size() * sizeof(EntradaPageRankSnapshot);
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error al crear el snapshot: " << filename << std::endl;
+        return false;
+    }
+
+    // segunda pasada: escribir las secciones en orden, la cabecera va al final con los checksums
+    uint64_t checksumMetadatos = fnv1a(nullptr, 0);
+    uint64_t checksumDatos = fnv1a(nullptr, 0);
+    escribirBytes(out, &cabecera, sizeof(cabecera), nullptr);
+    escribirRelleno(out, sizeof(cabecera), nullptr);
+
+    escribirBytes(out, entradas.data(), entradas.size() * sizeof(EntradaTerminoSnapshot), &checksumMetadatos);
+    escribirRelleno(out, cabecera.offsetTerminos + entradas.size() * sizeof(EntradaTerminoSnapshot), &checksumMetadatos);
+
+    for (uint32_t id : ids) {
+        std::string_view termino = diccionario.getTermino(id);
+        escribirBytes(out, termino.data(), termino.size(), &checksumMetadatos);
+    }
+    escribirRelleno(out, cabecera.offsetTexto + largoTexto, &checksumMetadatos);
+
+    for (uint32_t id : ids) {
+        const ListaPosteo* lista = index.getEntrada(id)->listaPosteo;
+        escribirBytes(out, lista->getBloques(), lista->getNumBloques() * sizeof(BloquePosteo), &checksumMetadatos);
+    }
+    escribirRelleno(out, cabecera.offsetBloques + totalBloques * sizeof(BloquePosteo), &checksumMetadatos);
+
+    for (uint32_t id : ids) {
+        const ListaPosteo* lista = index.getEntrada(id)->listaPosteo;
+        escribirBytes(out, lista->getDatos(), lista->getBytesDatos(), &checksumDatos);
+    }
+    escribirRelleno(out, cabecera.offsetDatos + totalDatos, &checksumDatos);
+
+    for (int doc = 0; doc < index.getNumDocumentos(); ++doc) {
+        int32_t longitud = index.getLongitudDocumento(doc);
+        escribirBytes(out, &longitud, sizeof(longitud), &checksumMetadatos);
+    }
+    escribirRelleno(out, cabecera.offsetLongitudes + cabecera.numDocumentos * sizeof(int32_t), &checksumMetadatos);
+
+    for (const auto& pr_pair : scores) {
+        EntradaPageRankSnapshot entrada;
+        entrada.docId = pr_pair.first;
+        entrada.relleno = 0;
+        entrada.score = pr_pair.second;
+        escribirBytes(out, &entrada, sizeof(entrada), &checksumMetadatos);
+    }
+
+    cabecera.checksumMetadatos = checksumMetadatos;
+    cabecera.checksumDatos = checksumDatos;
+    out.seekp(0);
+    escribirBytes(out, &cabecera, sizeof(cabecera), nullptr);
+    out.close();
+    return !out.fail();
+}
+
+bool SnapshotIndice::abrir(const std::string& filename, bool verificarDatos) {
+    if (!archivo.abrir(filename, false)) {
+        return false;
+    }
+
+    const char* base = archivo.getDatos();
+    uint64_t tamanio = archivo.getTamanio();
+    if (tamanio < sizeof(CabeceraSnapshot)) {
+        std::cerr << "[SNAPSHOT] Archivo demasiado chico: " << filename << std::endl;
+        archivo.cerrar();
+        return false;
+    }
+
+    const CabeceraSnapshot* c = reinterpret_cast<const CabeceraSnapshot*>(base);
+    if (std::memcmp(c->magic, SNAPSHOT_MAGIC, sizeof(c->magic)) != 0 || c->version != SNAPSHOT_VERSION) {
+        std::cerr << "[SNAPSHOT] Formato o version no soportada en " << filename << std::endl;
+        archivo.cerrar();
+        return false;
+    }
+
+    // las secciones tienen que estar en orden, dentro del archivo y con el tamanio esperado
+    bool valido = c->tamanioTotal == tamanio
+        && c->offsetTerminos >= sizeof(CabeceraSnapshot)
+        && c->offsetTexto >= c->offsetTerminos + static_cast<uint64_t>(c->numTerminos) * sizeof(EntradaTerminoSnapshot)
+        && c->offsetBloques >= c->offsetTexto
+        && c->offsetDatos >= c->offsetBloques
+        && c->offsetLongitudes >= c->offsetDatos
+        && c->offsetPageRank >= c->offsetLongitudes + static_cast<uint64_t>(c->numDocumentos) * sizeof(int32_t)
+        && tamanio == c->offsetPageRank + static_cast<uint64_t>(c->numPageRank) * sizeof(EntradaPageRankSnapshot);
+    if (!valido) {
+        std::cerr << "[SNAPSHOT] Secciones invalidas en " << filename << std::endl;
+        archivo.cerrar();
+        return false;
+    }
+
+    uint64_t checksum = fnv1a(base + c->offsetTerminos, c->offsetDatos - c->offsetTerminos);
+    checksum = fnv1a(base + c->offsetLongitudes, tamanio - c->offsetLongitudes, checksum);
+    bool checksumValido = checksum == c->checksumMetadatos;
+    if (checksumValido && verificarDatos) {
+        checksumValido = fnv1a(base + c->offsetDatos, c->offsetLongitudes - c->offsetDatos) == c->checksumDatos;
+    }
+    if (!checksumValido) {
+        std::cerr << "[SNAPSHOT] Checksum invalido en " << filename << std::endl;
+        archivo.cerrar();
+        return false;
+    }
+
+    cabecera = c;
+    terminos = reinterpret_cast<const EntradaTerminoSnapshot*>(base + c->offsetTerminos);
+    texto = base + c->offsetTexto;
+    bloques = reinterpret_cast<const BloquePosteo*>(base + c->offsetBloques);
+    datos = reinterpret_cast<const uint8_t*>(base + c->offsetDatos);
+    longitudes = reinterpret_cast<const int32_t*>(base + c->offsetLongitudes);
+    pageRank = reinterpret_cast<const EntradaPageRankSnapshot*>(base + c->offsetPageRank);
+    return true;
+}
+
+std::string_view SnapshotIndice::getTermino(int indice) const {
+    const EntradaTerminoSnapshot& entrada = terminos[indice];
+    return std::string_view(texto + entrada.offsetTexto, entrada.largoTexto);
+}
+
+// los terminos estan en el orden de DiccionarioTerminos::ordenados(), byte a byte como
+// string_view::compare, que es la comparacion que usa la busqueda
+int SnapshotIndice::buscarTermino(std::string_view termino) const {
+    int izquierda = 0;
+    int derecha = getNumTerminos() - 1;
+    while (izquierda <= derecha) {
+        int medio = izquierda + (derecha - izquierda) / 2;
+        int comparacion = getTermino(medio).compare(termino);
+        if (comparacion == 0) {
+            return medio;
+        }
+        if (comparacion < 0) {
+            izquierda = medio + 1;
+        } else {
+            derecha = medio - 1;
+        }
+    }
+    return -1;
+}
+
+ListaPosteo* SnapshotIndice::crearVistaLista(int indice) const {
+    const EntradaTerminoSnapshot& entrada = terminos[indice];
+    return new ListaPosteo(bloques + entrada.primerBloque, entrada.numBloques,
+                           datos + entrada.offsetDatos, entrada.bytesDatos,
+                           entrada.numPosteos, entrada.ultimoDoc);
+}
+
+int SnapshotIndice::getLongitudDocumento(int doc_id) const {
+    if (doc_id < 0 || doc_id >= getNumDocumentos()) {
+        return 0;
+    }
+    return longitudes[doc_id];
+}
+
+std::map<int, double> SnapshotIndice::leerPageRank() const {
+    std::map<int, double> scores;
+    for (uint32_t i = 0; i < cabecera->numPageRank; ++i) {
+        scores.emplace_hint(scores.end(), pageRank[i].docId, pageRank[i].score);
+    }
+    return scores;
+}
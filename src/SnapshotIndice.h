@@ -0,0 +1,99 @@
+#ifndef SNAPSHOT_INDICE_H
+#define SNAPSHOT_INDICE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ArchivoMapeado.h"
+#include "ListaPosteo.h"
+
+class InvertedIndex;
+
+#define SNAPSHOT_MAGIC "P3SNAPv"
+#define SNAPSHOT_VERSION 2
+
+// formato binario del snapshot (todo en el orden de bytes de la maquina):
+//   CabeceraSnapshot
+//   EntradaTerminoSnapshot[numTerminos]  ordenadas por termino
+//   texto de los terminos concatenado
+//   BloquePosteo[] de todas las listas, una lista despues de otra
+//   datos comprimidos de todas las listas
+//   int32 longitud de cada documento
+//   EntradaPageRankSnapshot[numPageRank]
+// cada seccion empieza alineada a 8 bytes
+struct CabeceraSnapshot {
+    char magic[8];
+    uint32_t version;
+    uint32_t numTerminos;
+    uint32_t numDocumentos;
+    uint32_t numPageRank;
+    uint64_t offsetTerminos;
+    uint64_t offsetTexto;
+    uint64_t offsetBloques;
+    uint64_t offsetDatos;
+    uint64_t offsetLongitudes;
+    uint64_t offsetPageRank;
+    uint64_t tamanioTotal;
+    uint64_t checksumMetadatos; // todo menos los datos comprimidos, se verifica siempre
+    uint64_t checksumDatos;     // datos comprimidos, se verifica solo si se pide
+    uint64_t huellaOrigen;      // de lo que se uso para armarlo (ver SnapshotIndice::huellaOrigen)
+};
+
+struct EntradaTerminoSnapshot {
+    uint64_t offsetTexto;  // relativo a offsetTexto
+    uint64_t primerBloque; // indice dentro de la seccion de bloques
+    uint64_t offsetDatos;  // relativo a offsetDatos
+    uint64_t bytesDatos;
+    uint32_t largoTexto;
+    uint32_t numBloques;
+    int32_t numPosteos;
+    int32_t ultimoDoc;
+};
+
+struct EntradaPageRankSnapshot {
+    int32_t docId;
+    uint32_t relleno;
+    double score;
+};
+
+// snapshot abierto con mmap. nada se copia al abrir: los terminos se buscan con
+// busqueda binaria sobre la tabla mapeada y las listas son vistas sobre los bloques
+class SnapshotIndice {
+public:
+    SnapshotIndice();
+
+    // valida magic, version, tamanios y el checksum de metadatos (y el de datos si se pide)
+    bool abrir(const std::string& filename, bool verificarDatos = false);
+
+    // escribe el indice (con todas las listas selladas) y los scores de pagerank
+    static bool escribir(const std::string& filename, InvertedIndex& index, const std::map<int, double>& pageRank,
+                         uint64_t huellaOrigen);
+    // huella de los archivos de entrada (ruta, tamanio y fecha de modificacion) y de los
+    // parametros que cambian el indice o el pagerank. un snapshot con otra huella esta viejo
+    static uint64_t huellaOrigen(const std::vector<std::string>& archivos, const std::vector<long long>& parametros);
+
+    int getNumTerminos() const { return static_cast<int>(cabecera->numTerminos); }
+    int getNumDocumentos() const { return static_cast<int>(cabecera->numDocumentos); }
+    std::string_view getTermino(int indice) const;
+    int buscarTermino(std::string_view termino) const; // -1 si no esta
+    ListaPosteo* crearVistaLista(int indice) const;
+    int getLongitudDocumento(int doc_id) const;
+    std::map<int, double> leerPageRank() const;
+    size_t getTamanio() const { return archivo.getTamanio(); }
+    uint64_t getHuellaOrigen() const { return cabecera->huellaOrigen; }
+
+private:
+    ArchivoMapeado archivo;
+    const CabeceraSnapshot* cabecera;
+    const EntradaTerminoSnapshot* terminos;
+    const char* texto;
+    const BloquePosteo* bloques;
+    const uint8_t* datos;
+    const int32_t* longitudes;
+    const EntradaPageRankSnapshot* pageRank;
+};
+
+#endif
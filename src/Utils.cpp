@@ -1,5 +1,15 @@
 #include "Utils.h"
 
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UTILS_SIMD_ANCHO 32
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define UTILS_SIMD_ANCHO 16
+#else
+#define UTILS_SIMD_ANCHO 0
+#endif
+
 namespace Utils {
 
 
@@ -10,19 +20,202 @@ namespace Utils {
         return lowerStr;
     }
 
-    std::string cleanWord(std::string word) {
+    std::string cleanWord(std::string_view word) {
+        std::string cleaned_word;
+        normalizarPalabra(word, cleaned_word);
+        return cleaned_word;
+    }
+
+    // clasificacion escalar, solo ASCII. los bytes >= 0x80 (UTF-8 no ASCII) no son
+    // separadores ni alfanumericos, asi que se descartan dentro de la palabra
+    static inline bool esEspacio(unsigned char c) {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    static inline bool esAlfanumerico(unsigned char c) {
+        return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    static inline char aMinuscula(unsigned char c) {
+        return static_cast<char>((c >= 'A' && c <= 'Z') ? (c | 0x20) : c);
+    }
 
-        word = Utils::toLower(word);
+#if UTILS_SIMD_ANCHO == 32
+    typedef __m256i Vector;
+    static inline Vector cargar(const char* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+    static inline void guardar(char* p, Vector v) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v); }
+    static inline Vector repetir(char c) { return _mm256_set1_epi8(c); }
+    static inline Vector igual(Vector a, Vector b) { return _mm256_cmpeq_epi8(a, b); }
+    static inline Vector menor(Vector a, Vector b) { return _mm256_cmpgt_epi8(b, a); }
+    static inline Vector o(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+    static inline Vector y(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+    static inline Vector resta(Vector a, Vector b) { return _mm256_sub_epi8(a, b); }
+    static inline Vector xorV(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+    static inline uint32_t mascara(Vector v) { return static_cast<uint32_t>(_mm256_movemask_epi8(v)); }
+    static const uint32_t MASCARA_COMPLETA = 0xFFFFFFFFu;
+#elif UTILS_SIMD_ANCHO == 16
+    typedef __m128i Vector;
+    static inline Vector cargar(const char* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static inline void guardar(char* p, Vector v) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v); }
+    static inline Vector repetir(char c) { return _mm_set1_epi8(c); }
+    static inline Vector igual(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+    static inline Vector menor(Vector a, Vector b) { return _mm_cmplt_epi8(a, b); }
+    static inline Vector o(Vector a, Vector b) { return _mm_or_si128(a, b); }
+    static inline Vector y(Vector a, Vector b) { return _mm_and_si128(a, b); }
+    static inline Vector resta(Vector a, Vector b) { return _mm_sub_epi8(a, b); }
+    static inline Vector xorV(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+    static inline uint32_t mascara(Vector v) { return static_cast<uint32_t>(_mm_movemask_epi8(v)); }
+    static const uint32_t MASCARA_COMPLETA = 0xFFFFu;
+#endif
 
+#if UTILS_SIMD_ANCHO > 0
+    // bytes de v entre lo y hi (sin signo). se resta lo y se corre al rango con signo
+    // para poder usar la comparacion con signo de SSE2/AVX2
+    static inline Vector enRango(Vector v, char lo, char hi) {
+        Vector desplazado = xorV(resta(v, repetir(lo)), repetir(static_cast<char>(0x80)));
+        return menor(desplazado, repetir(static_cast<char>((hi - lo) - 127)));
+    }
 
-        std::string cleaned_word;
-        for (char c : word) {
-            if (std::isalnum(c)) {
-                cleaned_word += c;
+    static inline Vector espacios(Vector v) {
+        return o(igual(v, repetir(' ')), enRango(v, '\t', '\r'));
+    }
+
+    static inline Vector mayusculas(Vector v) {
+        return enRango(v, 'A', 'Z');
+    }
+
+    static inline Vector alfanumericos(Vector v) {
+        return o(o(enRango(v, '0', '9'), enRango(v, 'a', 'z')), mayusculas(v));
+    }
+
+    static inline int primerBit(uint32_t m) {
+        return __builtin_ctz(m);
+    }
+#endif
+
+    void normalizarPalabra(std::string_view palabra, std::string& salida) {
+        salida.clear();
+        size_t i = 0;
+        const size_t n = palabra.size();
+#if UTILS_SIMD_ANCHO > 0
+        alignas(32) char minusculas[UTILS_SIMD_ANCHO];
+        while (i + UTILS_SIMD_ANCHO <= n) {
+            Vector v = cargar(palabra.data() + i);
+            // las mayusculas pasan a minusculas prendiendo el bit 0x20
+            Vector bajo = o(v, y(mayusculas(v), repetir(0x20)));
+            uint32_t validos = mascara(alfanumericos(v));
+            guardar(minusculas, bajo);
+            if (validos == MASCARA_COMPLETA) {
+                salida.append(minusculas, UTILS_SIMD_ANCHO);
+            } else {
+                while (validos != 0) {
+                    salida += minusculas[primerBit(validos)];
+                    validos &= validos - 1;
+                }
+            }
+            i += UTILS_SIMD_ANCHO;
+        }
+#endif
+        for (; i < n; ++i) {
+            unsigned char c = static_cast<unsigned char>(palabra[i]);
+            if (esAlfanumerico(c)) {
+                salida += aMinuscula(c);
             }
         }
+    }
 
-        return cleaned_word;
+    static inline uint64_t mascaraDesde(size_t k) {
+        return k >= 64 ? 0 : (~0ull << k);
+    }
+
+    static inline uint64_t mascaraHasta(size_t k) {
+        return k >= 64 ? ~0ull : ((1ull << k) - 1);
+    }
+
+    Tokenizador::Tokenizador(std::string_view t) : texto(t), base(0), pos(0) {
+        cargarVentana(0);
+    }
+
+    // clasifica los siguientes 64 bytes: mascara de separadores, mascara de alfanumericos
+    // y copia en minusculas. lo que queda fuera del texto se marca como separador
+    void Tokenizador::cargarVentana(size_t nuevaBase) {
+        base = nuevaBase;
+        espacios = ~0ull;
+        alfanumericos = 0;
+        if (base >= texto.size()) {
+            return;
+        }
+        const char* p = texto.data() + base;
+        size_t disponibles = std::min<size_t>(TAMANIO_VENTANA, texto.size() - base);
+
+#if UTILS_SIMD_ANCHO > 0
+        if (disponibles == TAMANIO_VENTANA) {
+            uint64_t sep = 0;
+            uint64_t alnum = 0;
+            for (size_t k = 0; k < TAMANIO_VENTANA; k += UTILS_SIMD_ANCHO) {
+                Vector v = cargar(p + k);
+                sep |= static_cast<uint64_t>(mascara(Utils::espacios(v))) << k;
+                alnum |= static_cast<uint64_t>(mascara(Utils::alfanumericos(v))) << k;
+                guardar(minusculas + k, o(v, y(mayusculas(v), repetir(0x20))));
+            }
+            espacios = sep;
+            alfanumericos = alnum;
+            return;
+        }
+#endif
+        for (size_t k = 0; k < disponibles; ++k) {
+            unsigned char c = static_cast<unsigned char>(p[k]);
+            if (!esEspacio(c)) {
+                espacios &= ~(1ull << k);
+            }
+            if (esAlfanumerico(c)) {
+                alfanumericos |= 1ull << k;
+            }
+            minusculas[k] = aMinuscula(c);
+        }
+    }
+
+    bool Tokenizador::siguiente(std::string& palabra) {
+        // inicio de la palabra: primer byte que no es separador
+        while (true) {
+            if (base >= texto.size()) {
+                return false;
+            }
+            uint64_t candidatos = ~espacios & mascaraDesde(pos - base);
+            if (candidatos != 0) {
+                pos = base + __builtin_ctzll(candidatos);
+                break;
+            }
+            cargarVentana(base + TAMANIO_VENTANA);
+            pos = base;
+        }
+
+        // no libera la memoria de palabra, asi no se reserva de nuevo por cada palabra
+        palabra.clear();
+        while (true) {
+            size_t desde = pos - base;
+            uint64_t separadores = espacios & mascaraDesde(desde);
+            size_t fin = separadores != 0 ? __builtin_ctzll(separadores) : TAMANIO_VENTANA;
+            uint64_t rango = mascaraDesde(desde) & mascaraHasta(fin);
+            uint64_t validos = alfanumericos & rango;
+
+            if (validos == rango) {
+                palabra.append(minusculas + desde, fin - desde);
+            } else {
+                while (validos != 0) {
+                    palabra += minusculas[__builtin_ctzll(validos)];
+                    validos &= validos - 1;
+                }
+            }
+
+            if (separadores != 0 || base + TAMANIO_VENTANA >= texto.size()) {
+                pos = base + fin;
+                return true;
+            }
+            // la palabra sigue en la ventana siguiente
+            cargarVentana(base + TAMANIO_VENTANA);
+            pos = base;
+        }
     }
 
-} 
\ No newline at end of file
+} 
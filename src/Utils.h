@@ -2,12 +2,44 @@
 #define UTILS_H
 
 #include <string>
+#include <string_view>
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 
+// el tokenizador usa SSE2 (o AVX2 si se compila con -mavx2) y tiene una version escalar
+// para las colas y para otras arquitecturas. la clasificacion es solo ASCII: los bytes
+// de UTF-8 no ASCII no separan palabras y se descartan, igual que isalnum en locale "C"
 namespace Utils {
     std::string toLower(const std::string& str);
-    std::string cleanWord(std::string word);
+    std::string cleanWord(std::string_view word);
+
+    // deja en salida la palabra en minusculas y solo con alfanumericos
+    void normalizarPalabra(std::string_view palabra, std::string& salida);
+
+    // recorre un texto de a ventanas de 64 bytes: cada ventana se clasifica una sola vez
+    // (separadores, alfanumericos y minusculas) y los limites de las palabras salen de las
+    // mascaras de bits. las palabras se separan por espacios, como >> de un stream
+    class Tokenizador {
+    public:
+        Tokenizador(std::string_view texto);
+
+        // deja en palabra la siguiente palabra limpia (minusculas y solo alfanumericos),
+        // reutilizando su memoria. retorna false cuando no quedan palabras
+        bool siguiente(std::string& palabra);
+
+    private:
+        static constexpr size_t TAMANIO_VENTANA = 64;
+
+        std::string_view texto;
+        size_t base;            // inicio de la ventana actual
+        size_t pos;             // posicion de lectura
+        uint64_t espacios;      // bit i prendido si texto[base + i] es separador
+        uint64_t alfanumericos; // bit i prendido si texto[base + i] es alfanumerico
+        alignas(32) char minusculas[TAMANIO_VENTANA];
+
+        void cargarVentana(size_t nuevaBase);
+    };
 };
 
 
@@ -1,113 +1,311 @@
+#include <algorithm>
 #include <chrono>
+#include <csignal>
+#include <cstdlib>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "BuscadorConCache.h"
+#include "ClienteConsultas.h"
+#include "ConstructorGrafo.h"
 #include "Grafo.h"
+#include "IndiceParticionado.h"
 #include "InvertedIndex.h"
 #include "ProcesadorDocumentos.h"
 #include "LinkedList.h"
+#include "PoliticasCache.h"
+#include "ReproductorCache.h"
+#include "ServidorConsultas.h"
+#include "SnapshotIndice.h"
 
 #define STOPWORDS_FILE "data/stopwords_english.dat.txt"
 #define DOCUMENT_FILE "data/gov2_pages.dat"
 #define QUERY_LOGS "data/Log-Queries.dat"
 
-#define QUERY_LOG_LIMIT 5'000
+#define QUERY_LOG_LIMIT 5'000 // consultas del log para el grafo y la cache, 0 = todo el log (o --limite-log N)
 #define TOP_K_DOCUMENTOS 10
+#define TOP_K_BM25 10 // 0 = no mostrar el ranking BM25 en la consulta interactiva
 #define CACHE_SIZE 5
+#define CACHE_BYTES (64u << 20) // presupuesto de la cache de resultados en bytes, 0 = solo CACHE_SIZE entradas
+#define POLITICA_CACHE POLITICA_LRU // POLITICA_LRU, POLITICA_SLRU, POLITICA_ARC o POLITICA_TINYLFU
+#define CACHE_INTERSECCIONES 1024 // intersecciones por subconjunto de terminos, 0 = solo clave exacta
+#define PARES_FRECUENTES 256 // pares de terminos del log que quedan fijos en la cache de intersecciones
+#define METRICAS_CONSULTA true // latencia por etapa de cada consulta, se imprime al salir
+#define METRICAS_JSON "" // archivo donde se escriben tambien en JSON, "" = solo texto
+#define MODO_BULK true
+#define NUM_HILOS_CARGA 0 // 0 = un hilo por nucleo
+#define NUM_HILOS_GRAFO 0 // hilos que corren las consultas del log para el grafo, 0 = uno por nucleo
+#define LECTOR_MMAP true
+#define SNAPSHOT_FILE "data/indice.snap" // si existe y es de los mismos datos se carga en vez de procesar el corpus
+#define GRAFO_FILE "data/grafo.bin" // el grafo de co-relevancia que acompania al snapshot
+#define USAR_SNAPSHOT true
+#define NUM_SHARDS 1 // shards por rangos de docs, cada consulta corre en todos a la vez (o --shards N), 1 = un solo indice
+#define NUM_HILOS_SHARDS 0 // hilos del pool de los shards, 0 = uno menos que los shards (el que consulta tambien trabaja)
+#define INDEXACION_INCREMENTAL false // acepta docs nuevos mientras se consulta: "+id||url||texto" en la consola o en --servidor (o --incremental)
+#define MODO_POSICIONAL false // guarda posiciones para consultas de frase ("entre comillas"), sin snapshot
+#define SOCKET_SERVIDOR "/tmp/search_engine.sock" // socket Unix de --servidor y --cliente
+#define NUM_HILOS_SERVIDOR 0 // hilos que corren las consultas en modo servidor, 0 = uno por nucleo
+#define CONEXIONES_CLIENTE 1
+#define PROFUNDIDAD_CLIENTE 64 // consultas sin responder por conexion en --cliente
+
+// el servidor que hay que detener con Ctrl+C (SIGINT) o SIGTERM
+static ServidorConsultas* servidorActivo = nullptr;
+
+static void detenerServidor(int) {
+    if (servidorActivo != nullptr) {
+        servidorActivo->detener();
+    }
+}
+
+// metricas de cache y de latencia al salir, en texto y si se pidio tambien en JSON
+static void imprimirMetricas(const BuscadorConCache& bs) {
+    bs.printCacheMetrics();
+    if (METRICAS_CONSULTA) {
+        bs.getMetricas().imprimir(std::cout);
+        std::string archivoMetricas = METRICAS_JSON;
+        if (!archivoMetricas.empty()) {
+            std::ofstream json(archivoMetricas);
+            if (json.is_open()) {
+                bs.getMetricas().escribirJSON(json);
+            } else {
+                std::cerr << "[ERROR] No se pudo escribir " << archivoMetricas << std::endl;
+            }
+        }
+    }
+}
+
+static void imprimirSegmentos(const IndiceParticionado& particionado) {
+    std::cout << "[MAIN] Indice: " << particionado.getNumDocumentos() << " docs en " << particionado.getNumSegmentos()
+              << " segmentos (" << particionado.getSegmentosSellados() << " sellados, " << particionado.getMezclasHechas()
+              << " mezclas)" << std::endl;
+}
+
+// grafo de co-relevancia con el top de cada consulta del log, false si no se pudo leer el log
+static bool construirGrafo(const InvertedIndex& ii, ProcesadorDocumentos& pd, Grafo& g, int limiteLog) {
+    std::cout << "[MAIN] Construyendo Grafo de co-relevancia desde logs de consulta..." << std::endl;
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    ConstructorGrafo constructorGrafo(&ii, &pd, TOP_K_DOCUMENTOS, NUM_HILOS_GRAFO);
+    int queryCount = constructorGrafo.construirDesdeLog(QUERY_LOGS, g, limiteLog);
+    if (queryCount < 0) {
+        return false;
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+
+    std::cout << "[MAIN] " << queryCount << " consultas del log procesadas, " << constructorGrafo.getAristasEmitidas()
+              << " aristas anotadas y " << constructorGrafo.getAristasDistintas() << " distintas." << std::endl;
+    std::cout << "[MAIN] Grafo construido con " << g.getNumNodes() << " nodos y " << g.getNumAristas() << " aristas en " << duration.count() << " ms." << std::endl;
+    return true;
+}
+
+static void imprimirMemoriaGrafo(const Grafo& g) {
+    if (g.getNumAristasDistintas() > 0) {
+        std::cout << "[MAIN] Memoria del grafo: " << g.bytesUsados() << " bytes ("
+                  << static_cast<double>(g.bytesUsados()) / g.getNumAristasDistintas() << " bytes por arista distinta)" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    // --limite-log N: cuantas consultas del log se usan (0 = todas), pisa QUERY_LOG_LIMIT
+    // --shards N: reparte el indice en N shards, pisa NUM_SHARDS
+    // --incremental: activa INDEXACION_INCREMENTAL
+    int limiteLog = QUERY_LOG_LIMIT;
+    int numShards = NUM_SHARDS;
+    bool incremental = INDEXACION_INCREMENTAL;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--incremental") {
+            incremental = true;
+        } else if (i + 1 < argc && std::string(argv[i]) == "--limite-log") {
+            limiteLog = std::atoi(argv[i + 1]);
+        } else if (i + 1 < argc && std::string(argv[i]) == "--shards") {
+            numShards = std::max(1, std::atoi(argv[i + 1]));
+        }
+    }
+
+    // --replay-cache: solo reproduce el log de consultas contra cada politica de cache
+    if (argc > 1 && std::string(argv[1]) == "--replay-cache") {
+        ProcesadorDocumentos pd;
+        pd.cargarStopwords(STOPWORDS_FILE);
+        reproducirLogCache(QUERY_LOGS, pd, {CACHE_SIZE, 50, 500, 5000});
+        return 0;
+    }
+    // --cliente [socket] [conexiones] [profundidad]: manda las consultas de stdin a un
+    // servidor ya corriendo; con una sola conexion imprime las respuestas
+    if (argc > 1 && std::string(argv[1]) == "--cliente") {
+        std::string ruta = argc > 2 ? argv[2] : SOCKET_SERVIDOR;
+        int conexiones = argc > 3 ? std::atoi(argv[3]) : CONEXIONES_CLIENTE;
+        int profundidad = argc > 4 ? std::atoi(argv[4]) : PROFUNDIDAD_CLIENTE;
+        std::vector<std::string> consultas;
+        std::string linea;
+        while (std::getline(std::cin, linea)) {
+            consultas.push_back(linea);
+        }
+        return correrCliente(ruta, consultas, conexiones, profundidad, conexiones == 1);
+    }
+    // --replay-subconjuntos: carga el indice y compara la cache de clave exacta con la de subconjuntos
+    bool replaySubconjuntos = argc > 1 && std::string(argv[1]) == "--replay-subconjuntos";
+    // --servidor [socket]: carga el indice una vez y atiende consultas por un socket Unix
+    bool modoServidor = argc > 1 && std::string(argv[1]) == "--servidor";
+    std::string rutaServidor = modoServidor && argc > 2 && argv[2][0] != '-' ? argv[2] : SOCKET_SERVIDOR;
 
-int main() {
     std::cout << "[MAIN] Iniciando motor de busqueda con cache LRU..." << std::endl;
 
     // 1) INICIAR OBJETOS
     ProcesadorDocumentos pd;
     InvertedIndex ii;
-    BuscadorConCache bs(&ii, &pd, CACHE_SIZE);
+    BuscadorConCache bs(&ii, &pd, CACHE_SIZE, POLITICA_CACHE, CACHE_INTERSECCIONES, CACHE_BYTES);
     Grafo g;
 
     // 2) CARGAR STOPWORDS
     std::cout << "[MAIN] Cargando STOPWORDS..." << std::endl;
     pd.cargarStopwords(STOPWORDS_FILE);
+    ii.setModoPosicional(MODO_POSICIONAL);
 
-    // 3) CARGAR DOCUMENTOS
-    std::cout << "[MAIN] Cargando y procesando documentos (" << DOCUMENT_FILE << ")..." << std::endl;
+    // 2.5) SNAPSHOT: si hay uno valido y armado con los mismos archivos y parametros se salta la
+    // carga, el grafo (se lee de GRAFO_FILE) y el pagerank
+    uint64_t huella = SnapshotIndice::huellaOrigen({DOCUMENT_FILE, STOPWORDS_FILE, QUERY_LOGS},
+                                                  {limiteLog, MODO_POSICIONAL, TOP_K_DOCUMENTOS});
+    std::map<int, double> pageRankScores;
+    std::string lineaQuery;
     auto start_time = std::chrono::high_resolution_clock::now();
-    pd.cargaYProcesadoDocumentos(DOCUMENT_FILE, ii);
+    bool desdeSnapshot = USAR_SNAPSHOT && ii.cargarSnapshot(SNAPSHOT_FILE, pageRankScores, huella);
     auto end_time = std::chrono::high_resolution_clock::now();
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    std::cout << "[MAIN] Tiempo de carga y procesamiento: " << duration.count() << " ms" << std::endl;
-
-    // 3.5) CONSTRUCCIÓN GRAFO OFFLINE
-    std::cout << "[MAIN] Construyendo Grafo de co-relevancia desde logs de consulta..." << std::endl;
-    start_time = std::chrono::high_resolution_clock::now();
+    if (desdeSnapshot) {
+        std::cout << "[MAIN] Snapshot " << SNAPSHOT_FILE << " cargado en " << duration.count() << " ms ("
+                  << ii.getNumDocumentos() << " documentos, " << pageRankScores.size() << " scores de PageRank)" << std::endl;
+        ii.printEstadisticasMemoria();
 
-    std::ifstream QUERY_LOGS_PROCESADOR(QUERY_LOGS);
-    if (!QUERY_LOGS_PROCESADOR.is_open()) {
-        std::cerr << "[ERROR] No se pudo abrir el archivo de consultas: " << QUERY_LOGS << std::endl;
-        return 1;
-    }
+        // el pagerank ya viene en el snapshot; si falta el grafo se arma de nuevo (sale igual,
+        // el indice es el mismo) y se guarda
+        if (g.cargar(GRAFO_FILE, huella)) {
+            std::cout << "[MAIN] Grafo " << GRAFO_FILE << " cargado con " << g.getNumNodes() << " nodos y " << g.getNumAristas() << " aristas." << std::endl;
+        } else {
+            if (!construirGrafo(ii, pd, g, limiteLog)) {
+                return 1;
+            }
+            g.guardar(GRAFO_FILE, huella);
+        }
+        imprimirMemoriaGrafo(g);
+    } else {
+        // 3) CARGAR DOCUMENTOS
+        std::cout << "[MAIN] Cargando y procesando documentos (" << DOCUMENT_FILE << ")..." << std::endl;
+        start_time = std::chrono::high_resolution_clock::now();
+        pd.setModoBulk(MODO_BULK);
+        pd.setNumHilos(NUM_HILOS_CARGA > 0 ? NUM_HILOS_CARGA : static_cast<int>(std::thread::hardware_concurrency()));
+        if (LECTOR_MMAP) {
+            pd.cargaYProcesadoDocumentosMmap(DOCUMENT_FILE, ii);
+        } else {
+            pd.cargaYProcesadoDocumentos(DOCUMENT_FILE, ii);
+        }
+        end_time = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        std::cout << "[MAIN] Tiempo de carga y procesamiento: " << duration.count() << " ms" << std::endl;
+        ii.printEstadisticasMemoria();
 
-    std::string lineaQuery;
-    int queryCount = 0;
-    while (std::getline(QUERY_LOGS_PROCESADOR, lineaQuery) && queryCount < QUERY_LOG_LIMIT) {
-        if (lineaQuery.empty()) {
-            continue;
+        // 3.5) CONSTRUCCIÓN GRAFO OFFLINE
+        if (!construirGrafo(ii, pd, g, limiteLog)) {
+            return 1;
         }
+        imprimirMemoriaGrafo(g);
 
-        LinkedList<int>* resultadoQuery = bs.querySinPR(lineaQuery);
+        // 3.9) CALCULAR PAGERANK
+        std::cout << "[MAIN] Calculando PageRank..." << std::endl;
+        start_time = std::chrono::high_resolution_clock::now();
+        pageRankScores = g.calcularPageRank();
+        end_time = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        std::cout << "[MAIN] PageRank calculado en " << duration.count() << " ms." << std::endl;
 
-        if (resultadoQuery && resultadoQuery->getSize() > 0) {
-            std::vector<int> topKDocs; // vector para guardar los id de los docs, pero hasta K
-            Node<int>* actual = resultadoQuery->getHead();
-            int count = 0;
-            // mientras actual no sea nullo y top_k_documentos sea mayor al contador sigue aniadiendo a topKDocs
-            while (actual != nullptr && count < TOP_K_DOCUMENTOS) {
-                topKDocs.push_back(actual->data);
-                actual = actual->next;
-                count++;
+        if (USAR_SNAPSHOT) {
+            start_time = std::chrono::high_resolution_clock::now();
+            bool guardado = ii.guardarSnapshot(SNAPSHOT_FILE, pageRankScores, huella) && g.guardar(GRAFO_FILE, huella);
+            end_time = std::chrono::high_resolution_clock::now();
+            duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+            if (guardado) {
+                std::cout << "[MAIN] Snapshot guardado en " << SNAPSHOT_FILE << " y grafo en " << GRAFO_FILE << " (" << duration.count() << " ms)" << std::endl;
             }
+        }
+    }
 
-            // creacion del grafico de co-relevancia; por cada elemento em topKcods se aniade una arista al grafo
-            for (size_t i = 0; i < topKDocs.size(); ++i) {
-                for (size_t j = i + 1; j < topKDocs.size(); ++j) {
-                    g.addVertice(topKDocs[i], topKDocs[j]);
-                }
+    bs.setPageRankScores(&pageRankScores);
+
+    if (replaySubconjuntos) {
+        compararCacheSubconjuntos(QUERY_LOGS, &ii, &pd, &pageRankScores, CACHE_SIZE, CACHE_INTERSECCIONES, PARES_FRECUENTES, limiteLog);
+        return 0;
+    }
+
+    // 3.95) SEGMENTOS: el indice cargado, repartido en shards por rangos de docs si hay mas de
+    // uno, mas los segmentos de los docs que se agregan despues. los misses de la cache y el
+    // BM25 van ahi. con un solo shard y sin indexacion incremental se consulta el indice directo
+    IndiceParticionado particionado(numShards, NUM_HILOS_SHARDS);
+    bool conSegmentos = numShards > 1 || incremental;
+    if (conSegmentos) {
+        start_time = std::chrono::high_resolution_clock::now();
+        particionado.setPageRankScores(&pageRankScores);
+        particionado.construir(ii);
+        bs.setParticionado(&particionado);
+        end_time = std::chrono::high_resolution_clock::now();
+        duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        if (numShards > 1) {
+            std::cout << "[MAIN] Indice repartido en " << numShards << " shards en " << duration.count() << " ms, docs por shard: [";
+            std::shared_ptr<const VistaSegmentos> vista = particionado.getVista();
+            for (size_t shard = 0; shard < vista->segmentos.size(); ++shard) {
+                std::cout << (shard > 0 ? ", " : "") << vista->segmentos[shard]->numDocs;
             }
+            std::cout << "]" << std::endl;
+        }
+        if (incremental) {
+            particionado.iniciarMantenimiento();
         }
+    }
+    if (!conSegmentos && CACHE_INTERSECCIONES > 0 && PARES_FRECUENTES > 0) {
+        int fijados = bs.getIntersecciones().fijarParesFrecuentes(QUERY_LOGS, pd, PARES_FRECUENTES, limiteLog);
+        std::cout << "[MAIN] " << fijados << " pares de terminos frecuentes fijados en la cache de intersecciones" << std::endl;
+    }
 
-        if (resultadoQuery) {
-            delete resultadoQuery;
-            resultadoQuery = nullptr;
+    bs.getMetricas().setActivas(METRICAS_CONSULTA);
+    if (modoServidor) {
+        bs.setMensajes(false);
+        ServidorConsultas servidor(&bs, NUM_HILOS_SERVIDOR, TOP_K_DOCUMENTOS);
+        if (incremental) {
+            servidor.setIndexador(&particionado, &pd);
+        }
+        if (!servidor.escuchar(rutaServidor)) {
+            return 1;
         }
-        queryCount++;
-        if (queryCount % 1000 == 0) {
-            std::cout << "[MAIN] Procesadas " << queryCount << " consultas del log." << std::endl;
+        servidorActivo = &servidor;
+        std::signal(SIGINT, detenerServidor);
+        std::signal(SIGTERM, detenerServidor);
+        std::cout << "[MAIN] Servidor escuchando en " << rutaServidor << " (Ctrl+C para terminar)" << std::endl;
+        servidor.correr();
+        servidorActivo = nullptr;
+        std::cout << "\n[MAIN] Servidor detenido: " << servidor.getConsultasAtendidas() << " consultas en "
+                  << servidor.getConexionesAceptadas() << " conexiones" << std::endl;
+        if (incremental) {
+            imprimirSegmentos(particionado);
         }
+        imprimirMetricas(bs);
+        return 0;
     }
-    QUERY_LOGS_PROCESADOR.close();
-    end_time = std::chrono::high_resolution_clock::now();
-    duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-
-    std::cout << "[MAIN] Grafo construido con " << g.getNumNodes() << " nodos y " << g.getNumAristas() << " aristas en " << duration.count() << " ms." << std::endl;
-
-    // 3.9) CALCULAR PAGERANK
-    std::cout << "[MAIN] Calculando PageRank..." << std::endl;
-    start_time = std::chrono::high_resolution_clock::now();
-    std::map<int, double> pageRankScores = g.calcularPageRank();
-    end_time = std::chrono::high_resolution_clock::now();
-    duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    std::cout << "[MAIN] PageRank calculado en " << duration.count() << " ms." << std::endl;
-
-    bs.setPageRankScores(&pageRankScores);
 
     // 4) INTERFAZ DE CONSULTAS CON CACHE
     std::cout << "\n==== Motor de Busqueda con Cache LRU ====" << std::endl;
     std::cout << "Tamanio de cache: " << CACHE_SIZE << " elementos" << std::endl;
-    std::cout << "Politica de reemplazo: LRU (Least Recently Used)" << std::endl;
+    std::cout << "Politica de reemplazo: " << nombrePoliticaCache(POLITICA_CACHE) << std::endl;
+    if (numShards > 1) {
+        std::cout << "Shards: " << numShards << " (pool de " << particionado.getNumHilos() << " hilos + el que consulta)" << std::endl;
+    }
+    if (incremental) {
+        std::cout << "Documentos nuevos: '+id||url||texto' (se ven en las consultas al sellar el segmento)" << std::endl;
+    }
     std::cout << "Ingrese consulta (o 'exit' para terminar):" << std::endl;
 
     // pasar texto por consola
@@ -117,37 +315,66 @@ int main() {
             continue;
         }
 
+        if (incremental && lineaQuery[0] == '+') {
+            int docId = particionado.agregarDocumento(std::string_view(lineaQuery).substr(1), pd);
+            if (docId < 0) {
+                std::cout << "[ERROR] Documento mal formado, se espera +id||url||texto" << std::endl;
+            } else {
+                std::cout << "Documento agregado con id " << docId << std::endl;
+            }
+            continue;
+        }
+
         std::cout << "\nProcesando consulta: '" << lineaQuery << "'..." << std::endl;
 
         start_time = std::chrono::high_resolution_clock::now();
-        LinkedList<int>* resultado = bs.queryConCache(lineaQuery);
+        ResultadoCache resultado = bs.queryConCache(lineaQuery);
         end_time = std::chrono::high_resolution_clock::now();
-        duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
+        auto tiempoBusqueda = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
 
-        // si resultado existe checkea el size, sino el retorna nullptr y no puede buscarlo
-        if (resultado && resultado->getSize() > 0) {
-            std::cout << "Documentos encontrados: " << resultado->getSize() << std::endl;
+        // el resultado es de solo lectura y puede estar compartido con la cache
+        if (resultado && !resultado->empty()) {
+            std::cout << "Documentos encontrados: " << resultado->size() << std::endl;
             std::cout << "Top 10 documentos: [";
-            Node<int>* actual = resultado->getHead();
-            int count = 0;
-            while (actual != nullptr && count < 10) {
-                std::cout << actual->data;
-                if (actual->next != nullptr && count < 9) {
+            std::vector<int> top = resultado->descomprimir(10); // solo se decodifican los 10 primeros
+            for (size_t i = 0; i < top.size(); ++i) {
+                std::cout << top[i];
+                if (i + 1 < resultado->size() && i < 9) {
                     std::cout << ", ";
                 }
-                actual = actual->next;
-                count++;
             }
             std::cout << "]" << std::endl;
         } else {
             std::cout << "No se encontraron documentos para la consulta." << std::endl;
         }
 
-        std::cout << "Tiempo de busqueda: " << duration.count() << " ms" << std::endl;
+        std::cout << "Tiempo de busqueda: " << tiempoBusqueda.count() << " us" << std::endl;
+
+        if (TOP_K_BM25 > 0) {
+            start_time = std::chrono::high_resolution_clock::now();
+            std::vector<ResultadoRankeado> ranking = bs.queryTopK(lineaQuery, TOP_K_BM25);
+            end_time = std::chrono::high_resolution_clock::now();
+            auto microsegundos = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            std::cout << "Top " << TOP_K_BM25 << " BM25 + PageRank (OR): [";
+            for (size_t i = 0; i < ranking.size(); ++i) {
+                std::cout << ranking[i].docId << " (" << ranking[i].score << ")";
+                if (i + 1 < ranking.size()) {
+                    std::cout << ", ";
+                }
+            }
+            std::cout << "] en " << microsegundos.count() << " us" << std::endl;
+        }
 
-        if (resultado) {
-            delete resultado;
-            resultado = nullptr;
+        if (ii.esPosicional() && lineaQuery.size() > 2 && lineaQuery.front() == '"' && lineaQuery.back() == '"') {
+            start_time = std::chrono::high_resolution_clock::now();
+            std::vector<int> frase = bs.queryFrase(lineaQuery.substr(1, lineaQuery.size() - 2));
+            end_time = std::chrono::high_resolution_clock::now();
+            auto microsegundos = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            std::cout << "Frase exacta: " << frase.size() << " documentos [";
+            for (size_t i = 0; i < frase.size() && i < TOP_K_DOCUMENTOS; ++i) {
+                std::cout << frase[i] << (i + 1 < frase.size() && i + 1 < TOP_K_DOCUMENTOS ? ", " : "");
+            }
+            std::cout << "] en " << microsegundos.count() << " us" << std::endl;
         }
 
         bs.printCacheState();
@@ -155,7 +382,10 @@ int main() {
         std::cout << "\nIngrese una consulta (o 'exit' para terminar):" << std::endl;
     }
 
-    bs.printCacheMetrics();
+    if (incremental) {
+        imprimirSegmentos(particionado);
+    }
+    imprimirMetricas(bs);
 
     return 0;
 }
\ No newline at end of file